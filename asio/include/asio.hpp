@@ -19,6 +19,7 @@
 #include "asio/any_completion_handler.hpp"
 #include "asio/any_io_executor.hpp"
 #include "asio/append.hpp"
+#include "asio/arena.hpp"
 #include "asio/as_tuple.hpp"
 #include "asio/associated_allocator.hpp"
 #include "asio/associated_executor.hpp"
@@ -49,6 +50,7 @@
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/bind_executor.hpp"
 #include "asio/buffer.hpp"
+#include "asio/buffer_algorithms.hpp"
 #include "asio/buffer_registration.hpp"
 #include "asio/buffered_read_stream_fwd.hpp"
 #include "asio/buffered_read_stream.hpp"
@@ -67,6 +69,7 @@
 #include "asio/connect_pipe.hpp"
 #include "asio/consign.hpp"
 #include "asio/coroutine.hpp"
+#include "asio/datagram_slot.hpp"
 #include "asio/deadline_timer.hpp"
 #include "asio/defer.hpp"
 #include "asio/deferred.hpp"
@@ -174,10 +177,14 @@
 #include "asio/registered_buffer.hpp"
 #include "asio/require.hpp"
 #include "asio/require_concept.hpp"
+#include "asio/ring_buffer.hpp"
+#include "asio/segmented_buffer.hpp"
+#include "asio/sendfile.hpp"
 #include "asio/serial_port.hpp"
 #include "asio/serial_port_base.hpp"
 #include "asio/signal_set.hpp"
 #include "asio/socket_base.hpp"
+#include "asio/splice.hpp"
 #include "asio/static_thread_pool.hpp"
 #include "asio/steady_timer.hpp"
 #include "asio/strand.hpp"
@@ -191,6 +198,7 @@
 #include "asio/thread.hpp"
 #include "asio/thread_pool.hpp"
 #include "asio/time_traits.hpp"
+#include "asio/tsc_timer.hpp"
 #include "asio/use_awaitable.hpp"
 #include "asio/use_future.hpp"
 #include "asio/uses_executor.hpp"
@@ -208,5 +216,6 @@
 #include "asio/writable_pipe.hpp"
 #include "asio/write.hpp"
 #include "asio/write_at.hpp"
+#include "asio/write_queue.hpp"
 
 #endif // ASIO_HPP
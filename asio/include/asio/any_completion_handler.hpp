@@ -21,6 +21,7 @@
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include "asio/any_completion_executor.hpp"
 #include "asio/associated_allocator.hpp"
@@ -31,6 +32,10 @@
 
 #include "asio/detail/push_options.hpp"
 
+#if !defined(ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE)
+# define ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE (4 * sizeof(void*))
+#endif // !defined(ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE)
+
 namespace asio {
 namespace detail {
 
@@ -52,11 +57,58 @@ private:
   cancellation_state cancel_state_;
 };
 
+template <typename Handler>
+class any_completion_handler_impl;
+
+// Determines whether a handler's implementation is stored within the
+// any_completion_handler object itself. Only handlers that use the default
+// allocator are stored inline, so that the handler's allocator does not
+// depend on where the handler is stored.
+template <typename Handler>
+struct any_completion_handler_is_inline :
+  integral_constant<bool,
+    sizeof(any_completion_handler_impl<Handler>)
+      <= ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE
+    && alignment_of<any_completion_handler_impl<Handler> >::value
+      <= ASIO_DEFAULT_ALIGN
+    && std::is_nothrow_move_constructible<Handler>::value
+    && is_same<
+      associated_allocator_t<Handler, asio::recycling_allocator<void> >,
+      asio::recycling_allocator<void> >::value>
+{
+};
+
+// Storage for a handler's implementation within an any_completion_handler.
+template <std::size_t Size>
+class any_completion_handler_storage
+{
+public:
+  void* storage() ASIO_NOEXCEPT
+  {
+    return &storage_;
+  }
+
+private:
+  typename aligned_storage<Size, ASIO_DEFAULT_ALIGN>::type storage_;
+};
+
+template <>
+class any_completion_handler_storage<0>
+{
+public:
+  void* storage() ASIO_NOEXCEPT
+  {
+    return nullptr;
+  }
+};
+
 template <typename Handler>
 class any_completion_handler_impl :
   public any_completion_handler_impl_base
 {
 public:
+  typedef any_completion_handler_is_inline<Handler> is_inline;
+
   template <typename S, typename H>
   any_completion_handler_impl(S&& slot, H&& h)
     : any_completion_handler_impl_base(ASIO_MOVE_CAST(S)(slot)),
@@ -92,8 +144,14 @@ public:
   };
 
   template <typename S, typename H>
-  static any_completion_handler_impl* create(S&& slot, H&& h)
+  static any_completion_handler_impl* create(S&& slot, H&& h, void* storage)
   {
+    if (is_inline::value)
+    {
+      return new (storage) any_completion_handler_impl(
+          ASIO_MOVE_CAST(S)(slot), ASIO_MOVE_CAST(H)(h));
+    }
+
     uninit_deleter d{
         (get_associated_allocator)(h,
           asio::recycling_allocator<void>())};
@@ -111,6 +169,12 @@ public:
 
   void destroy()
   {
+    if (is_inline::value)
+    {
+      this->~any_completion_handler_impl();
+      return;
+    }
+
     deleter d{
         (get_associated_allocator)(handler_,
           asio::recycling_allocator<void>())};
@@ -118,6 +182,22 @@ public:
     d(this);
   }
 
+  // Move the implementation to the storage of another any_completion_handler,
+  // if it is stored inline.
+  any_completion_handler_impl* move(void* storage) ASIO_NOEXCEPT
+  {
+    if (is_inline::value)
+    {
+      any_completion_handler_impl* ptr = new (storage)
+        any_completion_handler_impl(ASIO_MOVE_CAST(
+            any_completion_handler_impl)(*this));
+      this->~any_completion_handler_impl();
+      return ptr;
+    }
+
+    return this;
+  }
+
   any_completion_executor executor(
       const any_completion_executor& candidate) const ASIO_NOEXCEPT
   {
@@ -125,14 +205,29 @@ public:
         (get_associated_executor)(handler_, candidate));
   }
 
-  void* allocate(std::size_t size, std::size_t align) const
+  static associated_allocator_t<Handler, asio::recycling_allocator<void>>
+  get_allocator(const any_completion_handler_impl* impl, false_type)
+  {
+    return (get_associated_allocator)(impl->handler_,
+        asio::recycling_allocator<void>());
+  }
+
+  // The allocator of a handler that is stored inline does not depend on the
+  // handler object, which may since have been moved.
+  static asio::recycling_allocator<void> get_allocator(
+      const any_completion_handler_impl*, true_type)
+  {
+    return asio::recycling_allocator<void>();
+  }
+
+  static void* allocate(const any_completion_handler_impl* impl,
+      std::size_t size, std::size_t align)
   {
     typename std::allocator_traits<
       associated_allocator_t<Handler,
         asio::recycling_allocator<void>>>::template
           rebind_alloc<unsigned char> alloc(
-            (get_associated_allocator)(handler_,
-              asio::recycling_allocator<void>()));
+            get_allocator(impl, is_inline()));
 
     std::size_t space = size + align - 1;
     unsigned char* base =
@@ -152,7 +247,8 @@ public:
     return nullptr;
   }
 
-  void deallocate(void* p, std::size_t size, std::size_t align) const
+  static void deallocate(const any_completion_handler_impl* impl,
+      void* p, std::size_t size, std::size_t align)
   {
     if (p)
     {
@@ -160,8 +256,7 @@ public:
         associated_allocator_t<Handler,
           asio::recycling_allocator<void>>>::template
             rebind_alloc<unsigned char> alloc(
-              (get_associated_allocator)(handler_,
-                asio::recycling_allocator<void>()));
+              get_allocator(impl, is_inline()));
 
       std::ptrdiff_t off;
       std::memcpy(&off, static_cast<unsigned char*>(p) + size, sizeof(off));
@@ -175,6 +270,16 @@ public:
   template <typename... Args>
   void call(Args&&... args)
   {
+    if (is_inline::value)
+    {
+      Handler handler(ASIO_MOVE_CAST(Handler)(handler_));
+      this->~any_completion_handler_impl();
+
+      ASIO_MOVE_CAST(Handler)(handler)(
+          ASIO_MOVE_CAST(Args)(args)...);
+      return;
+    }
+
     deleter d{
         (get_associated_allocator)(handler_,
           asio::recycling_allocator<void>())};
@@ -326,8 +431,8 @@ public:
   static void* impl(any_completion_handler_impl_base* impl,
       std::size_t size, std::size_t align)
   {
-    return static_cast<any_completion_handler_impl<Handler>*>(impl)->allocate(
-        size, align);
+    return any_completion_handler_impl<Handler>::allocate(
+        static_cast<any_completion_handler_impl<Handler>*>(impl), size, align);
   }
 
 private:
@@ -355,7 +460,8 @@ public:
   static void impl(any_completion_handler_impl_base* impl,
       void* p, std::size_t size, std::size_t align)
   {
-    static_cast<any_completion_handler_impl<Handler>*>(impl)->deallocate(
+    any_completion_handler_impl<Handler>::deallocate(
+        static_cast<any_completion_handler_impl<Handler>*>(impl),
         p, size, align);
   }
 
@@ -363,9 +469,39 @@ private:
   type deallocate_fn_;
 };
 
+class any_completion_handler_move_fn
+{
+public:
+  using type = any_completion_handler_impl_base*(*)(
+      any_completion_handler_impl_base*, void*);
+
+  constexpr any_completion_handler_move_fn(type fn)
+    : move_fn_(fn)
+  {
+  }
+
+  any_completion_handler_impl_base* move(
+      any_completion_handler_impl_base* impl, void* storage) const
+  {
+    return move_fn_(impl, storage);
+  }
+
+  template <typename Handler>
+  static any_completion_handler_impl_base* impl(
+      any_completion_handler_impl_base* impl, void* storage)
+  {
+    return static_cast<any_completion_handler_impl<Handler>*>(impl)->move(
+        storage);
+  }
+
+private:
+  type move_fn_;
+};
+
 template <typename... Signatures>
 class any_completion_handler_fn_table
   : private any_completion_handler_destroy_fn,
+    private any_completion_handler_move_fn,
     private any_completion_handler_executor_fn,
     private any_completion_handler_allocate_fn,
     private any_completion_handler_deallocate_fn,
@@ -375,11 +511,13 @@ public:
   template <typename... CallFns>
   constexpr any_completion_handler_fn_table(
       any_completion_handler_destroy_fn::type destroy_fn,
+      any_completion_handler_move_fn::type move_fn,
       any_completion_handler_executor_fn::type executor_fn,
       any_completion_handler_allocate_fn::type allocate_fn,
       any_completion_handler_deallocate_fn::type deallocate_fn,
       CallFns... call_fns)
     : any_completion_handler_destroy_fn(destroy_fn),
+      any_completion_handler_move_fn(move_fn),
       any_completion_handler_executor_fn(executor_fn),
       any_completion_handler_allocate_fn(allocate_fn),
       any_completion_handler_deallocate_fn(deallocate_fn),
@@ -388,6 +526,7 @@ public:
   }
 
   using any_completion_handler_destroy_fn::destroy;
+  using any_completion_handler_move_fn::move;
   using any_completion_handler_executor_fn::executor;
   using any_completion_handler_allocate_fn::allocate;
   using any_completion_handler_deallocate_fn::deallocate;
@@ -400,6 +539,7 @@ struct any_completion_handler_fn_table_instance
   static constexpr any_completion_handler_fn_table<Signatures...>
     value = any_completion_handler_fn_table<Signatures...>(
         &any_completion_handler_destroy_fn::impl<Handler>,
+        &any_completion_handler_move_fn::impl<Handler>,
         &any_completion_handler_executor_fn::impl<Handler>,
         &any_completion_handler_allocate_fn::impl<Handler>,
         &any_completion_handler_deallocate_fn::impl<Handler>,
@@ -531,6 +671,10 @@ public:
 
 template <typename... Signatures>
 class any_completion_handler
+#if !defined(GENERATING_DOCUMENTATION)
+  : private detail::any_completion_handler_storage<
+      ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE>
+#endif // !defined(GENERATING_DOCUMENTATION)
 {
 private:
   template <typename, typename...>
@@ -564,22 +708,23 @@ public:
         &detail::any_completion_handler_fn_table_instance<
           Handler, Signatures...>::value),
       impl_(detail::any_completion_handler_impl<Handler>::create(
-            (get_associated_cancellation_slot)(h), ASIO_MOVE_CAST(H)(h)))
+            (get_associated_cancellation_slot)(h),
+            ASIO_MOVE_CAST(H)(h), this->storage()))
   {
   }
 
   any_completion_handler(any_completion_handler&& other) ASIO_NOEXCEPT
-    : fn_table_(other.fn_table_),
-      impl_(other.impl_)
+    : fn_table_(nullptr),
+      impl_(nullptr)
   {
-    other.fn_table_ = nullptr;
-    other.impl_ = nullptr;
+    this->take(other);
   }
 
   any_completion_handler& operator=(
       any_completion_handler&& other) ASIO_NOEXCEPT
   {
-    any_completion_handler(other).swap(*this);
+    any_completion_handler(
+        ASIO_MOVE_CAST(any_completion_handler)(other)).swap(*this);
     return *this;
   }
 
@@ -607,8 +752,10 @@ public:
 
   void swap(any_completion_handler& other) ASIO_NOEXCEPT
   {
-    std::swap(fn_table_, other.fn_table_);
-    std::swap(impl_, other.impl_);
+    any_completion_handler tmp;
+    tmp.take(other);
+    other.take(*this);
+    this->take(tmp);
   }
 
   allocator_type get_allocator() const ASIO_NOEXCEPT
@@ -657,6 +804,19 @@ public:
   {
     return nullptr != b.impl_;
   }
+
+private:
+  // Take ownership of another object's handler. The handler's implementation
+  // is moved if it is stored inline.
+  void take(any_completion_handler& other) ASIO_NOEXCEPT
+  {
+    fn_table_ = other.fn_table_;
+    impl_ = other.impl_
+      ? other.fn_table_->move(other.impl_, this->storage())
+      : nullptr;
+    other.fn_table_ = nullptr;
+    other.impl_ = nullptr;
+  }
 };
 
 template <typename... Signatures, typename Candidate>
@@ -0,0 +1,119 @@
+//
+// arena.hpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ARENA_HPP
+#define ASIO_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/arena_impl.hpp"
+#include "asio/detail/concurrency_hint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A pool of memory for the asynchronous operations of an I/O object.
+/**
+ * An arena may be attached to an I/O object, such as a socket, using the
+ * object's @c set_arena member function. Operations subsequently started on
+ * the I/O object, including the intermediate operations of composed
+ * operations and any per-operation cancellation state, then obtain their
+ * memory from the arena. Blocks freed by completed operations are reused by
+ * later operations of the same size.
+ *
+ * The arena's memory is released once the arena object and all copies of it
+ * have been destroyed, the I/O objects to which it is attached have been
+ * destroyed, and all operations that use its memory have completed.
+ *
+ * A completion handler with an associated allocator, such as one created using
+ * asio::bind_allocator, continues to use that allocator.
+ *
+ * By default, the arena's free lists are protected by a mutex, as operations
+ * may complete and free their memory on any thread that runs the I/O object's
+ * execution context. When many threads run that context this mutex may be
+ * contended, and a separate arena per I/O object or per thread is preferable
+ * to one shared arena. If all operations that use the arena are started and
+ * completed by a single thread, the mutex may be disabled by constructing the
+ * arena with a concurrency hint of ASIO_CONCURRENCY_HINT_UNSAFE.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe, unless the arena was constructed with a
+ * concurrency hint that disables locking.
+ */
+class arena
+{
+public:
+  /// Construct an arena that obtains memory in chunks of the given size.
+  /**
+   * @param chunk_size The size of each chunk of memory obtained by the arena.
+   *
+   * @param concurrency_hint A suggestion to the implementation on how many
+   * threads use the arena. A hint that disables scheduler locking, such as
+   * ASIO_CONCURRENCY_HINT_UNSAFE, also disables the arena's mutex.
+   */
+  explicit arena(std::size_t chunk_size = 4096,
+      int concurrency_hint = ASIO_CONCURRENCY_HINT_DEFAULT)
+    : impl_(new detail::arena_impl(chunk_size,
+          ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER, concurrency_hint)))
+  {
+  }
+
+  /// Copy constructor. The copy refers to the same pool of memory.
+  arena(const arena& other) ASIO_NOEXCEPT
+    : impl_(other.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Assignment operator. The arena refers to the same pool of memory as
+  /// @c other.
+  arena& operator=(const arena& other) ASIO_NOEXCEPT
+  {
+    other.impl_->add_ref();
+    impl_->release();
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Destructor.
+  ~arena()
+  {
+    impl_->release();
+  }
+
+  /// Get the total amount of memory obtained by the arena, in bytes.
+  std::size_t capacity() const
+  {
+    return impl_->capacity();
+  }
+
+#if !defined(GENERATING_DOCUMENTATION)
+  // Get the underlying implementation. For use by I/O objects.
+  detail::arena_impl* impl() const ASIO_NOEXCEPT
+  {
+    return impl_;
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+private:
+  detail::arena_impl* impl_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_ARENA_HPP
@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include <cstddef>
 #include "asio/basic_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/datagram_slot.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
@@ -62,6 +64,9 @@ private:
   class initiate_async_send_to;
   class initiate_async_receive;
   class initiate_async_receive_from;
+  class initiate_async_receive_coalesced;
+  class initiate_async_send_batch;
+  class initiate_async_receive_batch;
 
 public:
   /// The type of the executor associated with the object.
@@ -89,6 +94,12 @@ public:
   /// The endpoint type.
   typedef typename Protocol::endpoint endpoint_type;
 
+  /// The type of a slot used to send a datagram in a batch.
+  typedef basic_datagram_slot<const_buffer, endpoint_type> send_slot;
+
+  /// The type of a slot used to receive a datagram in a batch.
+  typedef basic_datagram_slot<mutable_buffer, endpoint_type> receive_slot;
+
   /// Construct a basic_datagram_socket without opening it.
   /**
    * This constructor creates a datagram socket without opening it. The open()
@@ -790,6 +801,149 @@ public:
         buffers, destination, flags);
   }
 
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a batch of datagrams, each
+   * to the endpoint given in its slot. It is an initiating function for an
+   * @ref asynchronous_operation, and always returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been sent.
+   * The datagrams are sent in order, and the number of slots sent is passed to
+   * the completion handler. On completion, the size() of each sent slot is the
+   * number of bytes sent from it. Where the platform supports it, the
+   * datagrams are sent using a single system call, such as sendmmsg.
+   *
+   * @param slots An array of slots, each of which holds one datagram and its
+   * destination. Ownership of the slots, and of the memory blocks that they
+   * refer to, is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the operation completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t slots_transferred // Number of slots sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Example
+   * @code asio::ip::udp::socket::send_slot slots[2] = {
+   *     asio::ip::udp::socket::send_slot(asio::buffer(data1), endpoint1),
+   *     asio::ip::udp::socket::send_slot(asio::buffer(data2), endpoint2) };
+   * socket.async_send_batch(slots, 2, handler); @endcode
+   *
+   * @note On Windows, only the first slot is transferred by each operation.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+      void (asio::error_code, std::size_t))
+  async_send_batch(send_slot* slots, std::size_t count,
+      ASIO_MOVE_ARG(WriteToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_batch>(), token, slots,
+          count, socket_base::message_flags(0))))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_batch(this), token, slots,
+        count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a batch of datagrams, each
+   * to the endpoint given in its slot. It is an initiating function for an
+   * @ref asynchronous_operation, and always returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been sent.
+   * The datagrams are sent in order, and the number of slots sent is passed to
+   * the completion handler. On completion, the size() of each sent slot is the
+   * number of bytes sent from it. Where the platform supports it, the
+   * datagrams are sent using a single system call, such as sendmmsg.
+   *
+   * @param slots An array of slots, each of which holds one datagram and its
+   * destination. Ownership of the slots, and of the memory blocks that they
+   * refer to, is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the operation completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t slots_transferred // Number of slots sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note On Windows, only the first slot is transferred by each operation.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+      void (asio::error_code, std::size_t))
+  async_send_batch(send_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_batch>(), token, slots, count, flags)))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_batch(this), token, slots, count, flags);
+  }
+
   /// Receive some data on a connected socket.
   /**
    * This function is used to receive data on the datagram socket. The function
@@ -1246,6 +1400,451 @@ public:
         buffers, &sender_endpoint, flags);
   }
 
+  /// Receive datagrams coalesced by generic receive offload.
+  /**
+   * This function is used to receive a datagram, or a run of datagrams that
+   * have been coalesced by the kernel. The function call will block until
+   * data has been received successfully or an error occurs.
+   *
+   * Where generic receive offload is enabled using the
+   * ip::udp::generic_receive_offload socket option, the kernel may deliver a
+   * run of datagrams from the same sender as a single receive. The datagrams
+   * are placed contiguously in the buffers, and each is @c segment_size bytes
+   * long except for the last, which may be shorter. When the received data is
+   * a single datagram, @c segment_size is set to the number of bytes
+   * received.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Receives the size of each of the received datagrams.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Not supported on Windows.
+   *
+   * @par Example
+   * @code
+   * asio::ip::udp::endpoint sender_endpoint;
+   * std::size_t segment_size = 0;
+   * std::size_t n = socket.receive_coalesced(
+   *     asio::buffer(data, size), sender_endpoint, segment_size);
+   * for (std::size_t offset = 0; offset < n; offset += segment_size)
+   * {
+   *   std::size_t length = std::min(segment_size, n - offset);
+   *   process_datagram(data + offset, length);
+   * }
+   * @endcode
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_coalesced(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, 0, ec);
+    asio::detail::throw_error(ec, "receive_coalesced");
+    return s;
+  }
+
+  /// Receive datagrams coalesced by generic receive offload.
+  /**
+   * This function is used to receive a datagram, or a run of datagrams that
+   * have been coalesced by the kernel. The function call will block until
+   * data has been received successfully or an error occurs.
+   *
+   * Where generic receive offload is enabled using the
+   * ip::udp::generic_receive_offload socket option, the kernel may deliver a
+   * run of datagrams from the same sender as a single receive. The datagrams
+   * are placed contiguously in the buffers, and each is @c segment_size bytes
+   * long except for the last, which may be shorter. When the received data is
+   * a single datagram, @c segment_size is set to the number of bytes
+   * received.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Receives the size of each of the received datagrams.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Not supported on Windows.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_coalesced(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, flags, ec);
+    asio::detail::throw_error(ec, "receive_coalesced");
+    return s;
+  }
+
+  /// Receive datagrams coalesced by generic receive offload.
+  /**
+   * This function is used to receive a datagram, or a run of datagrams that
+   * have been coalesced by the kernel. The function call will block until
+   * data has been received successfully or an error occurs.
+   *
+   * Where generic receive offload is enabled using the
+   * ip::udp::generic_receive_offload socket option, the kernel may deliver a
+   * run of datagrams from the same sender as a single receive. The datagrams
+   * are placed contiguously in the buffers, and each is @c segment_size bytes
+   * long except for the last, which may be shorter. When the received data is
+   * a single datagram, @c segment_size is set to the number of bytes
+   * received.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Receives the size of each of the received datagrams.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received.
+   *
+   * @note Not supported on Windows.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_coalesced(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, flags, ec);
+  }
+
+  /// Start an asynchronous receive of datagrams coalesced by generic receive
+  /// offload.
+  /**
+   * This function is used to asynchronously receive a datagram, or a run of
+   * datagrams that have been coalesced by the kernel. It is an initiating
+   * function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * Where generic receive offload is enabled using the
+   * ip::udp::generic_receive_offload socket option, the kernel may deliver a
+   * run of datagrams from the same sender as a single receive. The datagrams
+   * are placed contiguously in the buffers, and each is @c segment_size bytes
+   * long except for the last, which may be shorter. When the received data is
+   * a single datagram, @c segment_size is set to the number of bytes
+   * received.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the completion handler is called.
+   *
+   * @param segment_size Receives the size of each of the received datagrams.
+   * Ownership of the segment_size object is retained by the caller, which must
+   * guarantee that it is valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Not supported on Windows.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(ReadToken,
+      void (asio::error_code, std::size_t))
+  async_receive_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      ASIO_MOVE_ARG(ReadToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_coalesced>(), token, buffers,
+          &sender_endpoint, &segment_size, socket_base::message_flags(0))))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_coalesced(this), token, buffers,
+        &sender_endpoint, &segment_size, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of datagrams coalesced by generic receive
+  /// offload.
+  /**
+   * This function is used to asynchronously receive a datagram, or a run of
+   * datagrams that have been coalesced by the kernel. It is an initiating
+   * function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * Where generic receive offload is enabled using the
+   * ip::udp::generic_receive_offload socket option, the kernel may deliver a
+   * run of datagrams from the same sender as a single receive. The datagrams
+   * are placed contiguously in the buffers, and each is @c segment_size bytes
+   * long except for the last, which may be shorter. When the received data is
+   * a single datagram, @c segment_size is set to the number of bytes
+   * received.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the completion handler is called.
+   *
+   * @param segment_size Receives the size of each of the received datagrams.
+   * Ownership of the segment_size object is retained by the caller, which must
+   * guarantee that it is valid until the completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Not supported on Windows.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(ReadToken,
+      void (asio::error_code, std::size_t))
+  async_receive_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_coalesced>(), token, buffers,
+          &sender_endpoint, &segment_size, flags)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_coalesced(this), token, buffers,
+        &sender_endpoint, &segment_size, flags);
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams. It
+   * is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been
+   * received. The datagrams are received into the slots in order, and the
+   * number of slots filled is passed to the completion handler. For each
+   * filled slot, the endpoint of the sender, the size of the datagram and the
+   * flags returned with it are stored in the slot. Where the platform supports
+   * it, the datagrams are received using a single system call, such as
+   * recvmmsg.
+   *
+   * @param slots An array of slots, each of which holds the buffer into which
+   * one datagram will be received. Ownership of the slots, and of the memory
+   * blocks that they refer to, is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the operation completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t slots_transferred // Number of slots filled.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Example
+   * @code asio::ip::udp::socket::receive_slot slots[16];
+   * for (std::size_t i = 0; i < 16; ++i)
+   *   slots[i].buffer(asio::buffer(data[i]));
+   * socket.async_receive_batch(slots, 16, handler); @endcode
+   *
+   * @note On Windows, only the first slot is transferred by each operation.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(ReadToken,
+      void (asio::error_code, std::size_t))
+  async_receive_batch(receive_slot* slots, std::size_t count,
+      ASIO_MOVE_ARG(ReadToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_batch>(), token, slots,
+          count, socket_base::message_flags(0))))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), token, slots,
+        count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams. It
+   * is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been
+   * received. The datagrams are received into the slots in order, and the
+   * number of slots filled is passed to the completion handler. For each
+   * filled slot, the endpoint of the sender, the size of the datagram and the
+   * flags returned with it are stored in the slot. Where the platform supports
+   * it, the datagrams are received using a single system call, such as
+   * recvmmsg.
+   *
+   * @param slots An array of slots, each of which holds the buffer into which
+   * one datagram will be received. Ownership of the slots, and of the memory
+   * blocks that they refer to, is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the operation completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t slots_transferred // Number of slots filled.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note On Windows, only the first slot is transferred by each operation.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(ReadToken,
+      void (asio::error_code, std::size_t))
+  async_receive_batch(receive_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_batch>(), token, slots, count, flags)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), token, slots, count, flags);
+  }
+
 private:
   // Disallow copying and assignment.
   basic_datagram_socket(const basic_datagram_socket&) ASIO_DELETED;
@@ -1277,6 +1876,7 @@ private:
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
       detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_send(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -1311,6 +1911,7 @@ private:
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
       detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_send_to(
           self_->impl_.get_implementation(), buffers, destination,
           flags, handler2.value, self_->impl_.get_executor());
@@ -1345,6 +1946,7 @@ private:
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_receive(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -1379,6 +1981,7 @@ private:
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_receive_from(
           self_->impl_.get_implementation(), buffers, *sender_endpoint,
           flags, handler2.value, self_->impl_.get_executor());
@@ -1387,6 +1990,111 @@ private:
   private:
     basic_datagram_socket* self_;
   };
+
+  class initiate_async_receive_coalesced
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_coalesced(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        std::size_t* segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
+      self_->impl_.get_service().async_receive_coalesced(
+          self_->impl_.get_implementation(), buffers, *sender_endpoint,
+          *segment_size, flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_send_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        send_slot* slots, std::size_t count,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
+      self_->impl_.get_service().async_send_batch(
+          self_->impl_.get_implementation(), slots, count,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        receive_slot* slots, std::size_t count,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
+      self_->impl_.get_service().async_receive_batch(
+          self_->impl_.get_implementation(), slots, count,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
 };
 
 } // namespace asio
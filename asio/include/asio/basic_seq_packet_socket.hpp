@@ -783,6 +783,7 @@ private:
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
       detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_send(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -818,6 +819,7 @@ private:
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_receive_with_flags(
           self_->impl_.get_implementation(), buffers, in_flags,
           *out_flags, handler2.value, self_->impl_.get_executor());
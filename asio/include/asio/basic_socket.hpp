@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/any_io_executor.hpp"
+#include "asio/arena.hpp"
 #include "asio/detail/config.hpp"
 #include "asio/async_result.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
@@ -378,6 +379,20 @@ public:
     return impl_.get_executor();
   }
 
+  /// Set the arena used for the memory of the socket's asynchronous operations.
+  /**
+   * Asynchronous operations subsequently started on the socket obtain their
+   * memory from the arena, unless the completion handler has an associated
+   * allocator. The socket keeps a reference to the arena until it is destroyed
+   * or another arena is set.
+   *
+   * @param a The arena to be used.
+   */
+  void set_arena(const asio::arena& a) ASIO_NOEXCEPT
+  {
+    impl_.set_arena(a.impl());
+  }
+
 #if !defined(ASIO_NO_EXTENSIONS)
   /// Get a reference to the lowest layer.
   /**
@@ -1897,6 +1912,7 @@ private:
       else
       {
         detail::non_const_lvalue<ConnectHandler> handler2(handler);
+        detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
         self_->impl_.get_service().async_connect(
             self_->impl_.get_implementation(), peer_endpoint,
             handler2.value, self_->impl_.get_executor());
@@ -1930,6 +1946,7 @@ private:
       ASIO_WAIT_HANDLER_CHECK(WaitHandler, handler) type_check;
 
       detail::non_const_lvalue<WaitHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_wait(
           self_->impl_.get_implementation(), w,
           handler2.value, self_->impl_.get_executor());
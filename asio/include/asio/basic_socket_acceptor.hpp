@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/any_io_executor.hpp"
+#include "asio/arena.hpp"
 #include "asio/basic_socket.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/io_object_impl.hpp"
@@ -39,6 +40,7 @@
 
 #if defined(ASIO_HAS_MOVE)
 # include <utility>
+# include <vector>
 #endif // defined(ASIO_HAS_MOVE)
 
 #include "asio/detail/push_options.hpp"
@@ -88,6 +90,7 @@ private:
   class initiate_async_wait;
   class initiate_async_accept;
   class initiate_async_move_accept;
+  class initiate_async_accept_batch;
 
 public:
   /// The type of the executor associated with the object.
@@ -459,6 +462,20 @@ public:
     return impl_.get_executor();
   }
 
+  /// Set the arena used for the memory of the acceptor's asynchronous operations.
+  /**
+   * Asynchronous operations subsequently started on the acceptor obtain their
+   * memory from the arena, unless the completion handler has an associated
+   * allocator. The acceptor keeps a reference to the arena until it is destroyed
+   * or another arena is set.
+   *
+   * @param a The arena to be used.
+   */
+  void set_arena(const asio::arena& a) ASIO_NOEXCEPT
+  {
+    impl_.set_arena(a.impl());
+  }
+
   /// Open the acceptor using the specified protocol.
   /**
    * This function opens the socket acceptor so that it will use the specified
@@ -2621,6 +2638,105 @@ public:
             static_cast<typename Protocol::socket::template rebind_executor<
               typename ExecutionContext::executor_type>::other*>(0));
   }
+
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept new connections. It waits
+   * until at least one connection is available, and then accepts as many of
+   * the waiting connections as it can without blocking, up to the specified
+   * maximum. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * Accepting the connections together, rather than with one operation per
+   * connection, reduces the number of trips through the reactor and the
+   * number of completion handlers run when many clients connect at once.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param max_connections The maximum number of connections to accept. At
+   * most 64 connections are accepted by one operation.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the accept completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // On success, the newly accepted sockets. On error, empty.
+   *   std::vector<typename Protocol::socket::template
+   *     rebind_executor<executor_type>::other> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code,
+   *    std::vector<typename Protocol::socket::template
+   *      rebind_executor<executor_type>::other>) @endcode
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const asio::error_code& error,
+   *     std::vector<asio::ip::tcp::socket> peers)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_batch(16, accept_handler);
+   * @endcode
+   *
+   * @note On Linux, the connections are accepted with @c accept4, and are
+   * ready for use by asynchronous operations without further system calls.
+   * On Windows, at most one connection is accepted by each operation.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          executor_type>::other>)) MoveAcceptBatchToken
+            ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(MoveAcceptBatchToken,
+      void (asio::error_code,
+        std::vector<typename Protocol::socket::template
+          rebind_executor<executor_type>::other>))
+  async_accept_batch(std::size_t max_connections,
+      ASIO_MOVE_ARG(MoveAcceptBatchToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<MoveAcceptBatchToken,
+        void (asio::error_code, std::vector<typename Protocol::socket::template
+          rebind_executor<executor_type>::other>)>(
+            declval<initiate_async_accept_batch>(), token,
+            declval<executor_type>(), max_connections)))
+  {
+    return async_initiate<MoveAcceptBatchToken,
+      void (asio::error_code, std::vector<typename Protocol::socket::template
+        rebind_executor<executor_type>::other>)>(
+          initiate_async_accept_batch(this), token,
+          impl_.get_executor(), max_connections);
+  }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
 private:
@@ -2652,6 +2768,7 @@ private:
       ASIO_WAIT_HANDLER_CHECK(WaitHandler, handler) type_check;
 
       detail::non_const_lvalue<WaitHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_wait(
           self_->impl_.get_implementation(), w,
           handler2.value, self_->impl_.get_executor());
@@ -2686,6 +2803,7 @@ private:
       ASIO_ACCEPT_HANDLER_CHECK(AcceptHandler, handler) type_check;
 
       detail::non_const_lvalue<AcceptHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_accept(
           self_->impl_.get_implementation(), *peer, peer_endpoint,
           handler2.value, self_->impl_.get_executor());
@@ -2720,6 +2838,7 @@ private:
           MoveAcceptHandler, handler, Socket) type_check;
 
       detail::non_const_lvalue<MoveAcceptHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
       self_->impl_.get_service().async_move_accept(
           self_->impl_.get_implementation(), peer_ex, peer_endpoint,
           handler2.value, self_->impl_.get_executor());
@@ -2729,6 +2848,36 @@ private:
     basic_socket_acceptor* self_;
   };
 
+  class initiate_async_accept_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept_batch(basic_socket_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename MoveAcceptBatchHandler, typename Executor1>
+    void operator()(ASIO_MOVE_ARG(MoveAcceptBatchHandler) handler,
+        const Executor1& peer_ex, std::size_t max_connections) const
+    {
+      detail::non_const_lvalue<MoveAcceptBatchHandler> handler2(handler);
+      detail::arena_impl::scope arena_scope(self_->impl_.get_arena());
+      self_->impl_.get_service().async_move_accept_batch(
+          self_->impl_.get_implementation(), peer_ex, max_connections,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket_acceptor* self_;
+  };
+
 #if defined(ASIO_WINDOWS_RUNTIME)
   detail::io_object_impl<
     detail::null_socket_service<Protocol>, Executor> impl_;
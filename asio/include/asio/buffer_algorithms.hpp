@@ -0,0 +1,263 @@
+//
+// buffer_algorithms.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFER_ALGORITHMS_HPP
+#define ASIO_BUFFER_ALGORITHMS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "asio/buffer.hpp"
+#include "asio/detail/buffer_search.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Iterator, typename Predicate>
+std::size_t buffer_find_if(Iterator iter, Iterator end,
+    std::size_t start, Predicate& pred)
+{
+  std::size_t offset = 0;
+  for (; iter != end; ++iter)
+  {
+    const_buffer buffer(*iter);
+    std::size_t skip = start > offset ? start - offset : 0;
+    if (skip < buffer.size())
+    {
+      const char* data = static_cast<const char*>(buffer.data());
+      const char* data_end = data + buffer.size();
+      const char* match = std::find_if(data + skip, data_end, pred);
+      if (match != data_end)
+        return offset + (match - data);
+    }
+    offset += buffer.size();
+  }
+  return offset;
+}
+
+template <typename Iterator1, typename Iterator2>
+std::size_t buffer_mismatch(Iterator1 iter1, Iterator1 end1,
+    Iterator2 iter2, Iterator2 end2)
+{
+  std::size_t total = 0;
+  std::size_t offset1 = 0;
+  std::size_t offset2 = 0;
+  while (iter1 != end1 && iter2 != end2)
+  {
+    const_buffer buffer1 = const_buffer(*iter1) + offset1;
+    const_buffer buffer2 = const_buffer(*iter2) + offset2;
+    std::size_t n = (std::min)(buffer1.size(), buffer2.size());
+    if (n > 0 && std::memcmp(buffer1.data(), buffer2.data(), n) != 0)
+    {
+      const char* data1 = static_cast<const char*>(buffer1.data());
+      const char* data2 = static_cast<const char*>(buffer2.data());
+      return total + (std::mismatch(data1, data1 + n, data2).first - data1);
+    }
+    total += n;
+
+    if (n == buffer1.size())
+    {
+      ++iter1;
+      offset1 = 0;
+    }
+    else
+      offset1 += n;
+
+    if (n == buffer2.size())
+    {
+      ++iter2;
+      offset2 = 0;
+    }
+    else
+      offset2 += n;
+  }
+  return total;
+}
+
+template <typename Iterator, typename T, typename BinaryOperation>
+T buffer_accumulate(Iterator iter, Iterator end, T init, BinaryOperation& op)
+{
+  for (; iter != end; ++iter)
+  {
+    const_buffer buffer(*iter);
+    if (buffer.size() > 0)
+      init = op(init, buffer);
+  }
+  return init;
+}
+
+} // namespace detail
+
+/** @defgroup buffer_algorithms Buffer sequence algorithms
+ *
+ * @brief Algorithms that operate on the bytes of a buffer sequence.
+ *
+ * These functions are equivalent to applying the corresponding standard
+ * library algorithm to a pair of @ref buffers_iterator objects, but they
+ * operate on one contiguous buffer at a time. This avoids the per-byte check
+ * for the end of a buffer made by @ref buffers_iterator, and allows the inner
+ * loops to be implemented in terms of @c memchr and @c memcmp.
+ *
+ * Positions within a buffer sequence are expressed as byte offsets from the
+ * start of the sequence. Where an algorithm does not find what it is looking
+ * for, it returns the total size of the sequence, in the same way that a
+ * standard library algorithm returns the end of its input range.
+ *
+ * The @ref buffer_copy function provides the equivalent of @c std::copy.
+ */
+/*@{*/
+
+/// Find the first occurrence of a byte in a buffer sequence.
+/**
+ * @param buffers The buffer sequence to be searched.
+ *
+ * @param c The byte to search for.
+ *
+ * @param start The offset at which to start the search.
+ *
+ * @returns The offset of the first matching byte at or after @c start, or
+ * <tt>buffer_size(buffers)</tt> if there is no such byte.
+ */
+template <typename ConstBufferSequence>
+inline std::size_t buffer_find(const ConstBufferSequence& buffers,
+    char c, std::size_t start = 0)
+{
+  return detail::buffer_find(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), start, c).first;
+}
+
+/// Find the first byte in a buffer sequence that satisfies a predicate.
+/**
+ * @param buffers The buffer sequence to be searched.
+ *
+ * @param pred A function object that is called as <tt>pred(c)</tt>, where
+ * @c c is a @c char, and returns a value convertible to @c bool.
+ *
+ * @param start The offset at which to start the search.
+ *
+ * @returns The offset of the first byte at or after @c start for which
+ * @c pred returns true, or <tt>buffer_size(buffers)</tt> if there is no such
+ * byte.
+ */
+template <typename ConstBufferSequence, typename Predicate>
+inline std::size_t buffer_find_if(const ConstBufferSequence& buffers,
+    Predicate pred, std::size_t start = 0)
+{
+  return detail::buffer_find_if(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), start, pred);
+}
+
+/// Find the first occurrence of a sequence of bytes in a buffer sequence.
+/**
+ * @param buffers The buffer sequence to be searched.
+ *
+ * @param pattern The bytes to search for. A match may span any number of the
+ * buffers in @c buffers.
+ *
+ * @param start The offset at which to start the search.
+ *
+ * @returns The offset of the first match that begins at or after @c start, or
+ * <tt>buffer_size(buffers)</tt> if there is no such match.
+ */
+template <typename ConstBufferSequence>
+inline std::size_t buffer_search(const ConstBufferSequence& buffers,
+    const const_buffer& pattern, std::size_t start = 0)
+{
+  std::pair<std::size_t, bool> result = detail::buffer_partial_search(
+      asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), start,
+      static_cast<const char*>(pattern.data()), pattern.size());
+  return result.second ? result.first : asio::buffer_size(buffers);
+}
+
+/// Find the first position at which two buffer sequences differ.
+/**
+ * @param buffers1 The first buffer sequence.
+ *
+ * @param buffers2 The second buffer sequence.
+ *
+ * @returns The offset of the first byte that differs between the two
+ * sequences. If one sequence is a prefix of the other, returns the size of
+ * the shorter sequence.
+ */
+template <typename ConstBufferSequence1, typename ConstBufferSequence2>
+inline std::size_t buffer_mismatch(const ConstBufferSequence1& buffers1,
+    const ConstBufferSequence2& buffers2)
+{
+  return detail::buffer_mismatch(
+      asio::buffer_sequence_begin(buffers1),
+      asio::buffer_sequence_end(buffers1),
+      asio::buffer_sequence_begin(buffers2),
+      asio::buffer_sequence_end(buffers2));
+}
+
+/// Determine whether two buffer sequences contain the same bytes.
+/**
+ * @param buffers1 The first buffer sequence.
+ *
+ * @param buffers2 The second buffer sequence.
+ *
+ * @returns @c true if the sequences are the same size and contain the same
+ * bytes, regardless of how those bytes are divided into buffers.
+ */
+template <typename ConstBufferSequence1, typename ConstBufferSequence2>
+inline bool buffer_equal(const ConstBufferSequence1& buffers1,
+    const ConstBufferSequence2& buffers2)
+{
+  std::size_t size = asio::buffer_size(buffers1);
+  return size == asio::buffer_size(buffers2)
+    && asio::buffer_mismatch(buffers1, buffers2) == size;
+}
+
+/// Combine the contiguous buffers of a buffer sequence into a single value.
+/**
+ * This function may be used to compute a checksum or CRC over a buffer
+ * sequence using a function that operates on contiguous memory.
+ *
+ * @param buffers The buffer sequence.
+ *
+ * @param init The initial value.
+ *
+ * @param op A function object that is called once for each non-empty buffer in
+ * the sequence, in order, as <tt>value = op(value, b)</tt>, where @c b is a
+ * @c const_buffer.
+ *
+ * @returns The final value.
+ *
+ * @par Example
+ * @code unsigned long crc = asio::buffer_accumulate(buffers, crc32(0, 0, 0),
+ *     [](unsigned long crc, asio::const_buffer b)
+ *     {
+ *       return crc32(crc, static_cast<const Bytef*>(b.data()), b.size());
+ *     }); @endcode
+ */
+template <typename ConstBufferSequence, typename T, typename BinaryOperation>
+inline T buffer_accumulate(const ConstBufferSequence& buffers,
+    T init, BinaryOperation op)
+{
+  return detail::buffer_accumulate(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), init, op);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BUFFER_ALGORITHMS_HPP
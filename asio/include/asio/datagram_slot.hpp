@@ -0,0 +1,140 @@
+//
+// datagram_slot.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DATAGRAM_SLOT_HPP
+#define ASIO_DATAGRAM_SLOT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/socket_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Describes one datagram in a batch operation.
+/**
+ * The basic_datagram_slot class template is used with the batch operations of
+ * basic_datagram_socket, such as async_receive_batch() and async_send_batch().
+ * Each slot holds the buffer for one datagram and the endpoint that the
+ * datagram is received from or sent to. When a batch operation transfers the
+ * datagram, it records the datagram's size in the slot. A receive operation
+ * also records the flags returned with the datagram.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+template <typename Buffer, typename Endpoint>
+class basic_datagram_slot
+{
+public:
+  /// The type of the buffer that holds the datagram.
+  typedef Buffer buffer_type;
+
+  /// The type of the endpoint that the datagram is received from or sent to.
+  typedef Endpoint endpoint_type;
+
+  /// Default constructor.
+  basic_datagram_slot()
+    : buffer_(),
+      endpoint_(),
+      size_(0),
+      flags_(0)
+  {
+  }
+
+  /// Construct a slot for a datagram to be received.
+  explicit basic_datagram_slot(const Buffer& b)
+    : buffer_(b),
+      endpoint_(),
+      size_(0),
+      flags_(0)
+  {
+  }
+
+  /// Construct a slot for a datagram to be sent to the specified endpoint.
+  basic_datagram_slot(const Buffer& b, const Endpoint& e)
+    : buffer_(b),
+      endpoint_(e),
+      size_(0),
+      flags_(0)
+  {
+  }
+
+  /// Get the buffer that holds the datagram.
+  const Buffer& buffer() const
+  {
+    return buffer_;
+  }
+
+  /// Set the buffer that holds the datagram.
+  void buffer(const Buffer& b)
+  {
+    buffer_ = b;
+  }
+
+  /// Get the endpoint that the datagram is received from or sent to.
+  Endpoint& endpoint()
+  {
+    return endpoint_;
+  }
+
+  /// Get the endpoint that the datagram is received from or sent to.
+  const Endpoint& endpoint() const
+  {
+    return endpoint_;
+  }
+
+  /// Get the number of bytes transferred by the last operation on the slot.
+  /**
+   * For a received datagram, a size equal to the size of the buffer may mean
+   * that the datagram was truncated. Where the platform reports truncation,
+   * flags() then includes the platform's truncation flag, such as MSG_TRUNC.
+   */
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  /// Set the number of bytes transferred.
+  void size(std::size_t n)
+  {
+    size_ = n;
+  }
+
+  /// Get the flags returned with a received datagram.
+  socket_base::message_flags flags() const
+  {
+    return flags_;
+  }
+
+  /// Set the flags returned with a received datagram.
+  void flags(socket_base::message_flags f)
+  {
+    flags_ = f;
+  }
+
+private:
+  Buffer buffer_;
+  Endpoint endpoint_;
+  std::size_t size_;
+  socket_base::message_flags flags_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DATAGRAM_SLOT_HPP
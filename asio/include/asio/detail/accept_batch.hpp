@@ -0,0 +1,152 @@
+//
+// detail/accept_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ACCEPT_BATCH_HPP
+#define ASIO_DETAIL_ACCEPT_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && defined(ASIO_HAS_MOVE)
+
+#include <cstddef>
+#include <vector>
+#include "asio/error.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Holds the connections accepted by one batch accept operation until they are
+// handed to the completion handler as socket objects.
+template <typename Protocol, typename PeerIoExecutor>
+class accept_batch
+  : private noncopyable
+{
+public:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  typedef std::vector<peer_socket_type> sockets_type;
+
+  // The maximum number of connections accepted per operation.
+  enum { max_size = 64 };
+
+  accept_batch(const PeerIoExecutor& peer_io_ex,
+      const Protocol& protocol, std::size_t max_sockets)
+    : peer_io_ex_(peer_io_ex),
+      protocol_(protocol),
+      max_sockets_(max_sockets < static_cast<std::size_t>(max_size)
+          ? max_sockets : static_cast<std::size_t>(max_size)),
+      sockets_accepted_(0)
+  {
+  }
+
+  ~accept_batch()
+  {
+    for (std::size_t i = 0; i < sockets_accepted_; ++i)
+    {
+      if (new_sockets_[i] != invalid_socket)
+      {
+        asio::error_code ignored_ec;
+        socket_ops::state_type state = 0;
+        socket_ops::close(new_sockets_[i], state, true, ignored_ec);
+      }
+    }
+  }
+
+  // Accept as many pending connections as are available, up to the maximum.
+  // Returns false if there were none and the operation must be retried.
+  bool perform(socket_type s, socket_ops::state_type state,
+      bool non_blocking, asio::error_code& ec)
+  {
+    return socket_ops::non_blocking_accept_batch(s, state,
+        non_blocking, new_sockets_, max_sockets_, ec, sockets_accepted_);
+  }
+
+  // Create the socket objects for the accepted connections. If an error
+  // occurs, no sockets are returned and the connections are closed.
+  sockets_type release(bool non_blocking, asio::error_code& ec)
+  {
+    sockets_type sockets;
+    if (ec)
+      return sockets;
+
+    sockets.reserve(sockets_accepted_);
+    for (std::size_t i = 0; i < sockets_accepted_; ++i)
+    {
+      accepted_socket peer(peer_io_ex_);
+      peer.assign(protocol_, new_sockets_[i], non_blocking, ec);
+      if (ec)
+      {
+        sockets.clear();
+        return sockets;
+      }
+      new_sockets_[i] = invalid_socket;
+      sockets.push_back(ASIO_MOVE_CAST(peer_socket_type)(peer));
+    }
+
+    return sockets;
+  }
+
+private:
+  // Gives access to the socket's implementation, so that a connection that
+  // was accepted in non-blocking mode need not be switched again by the
+  // socket's first asynchronous operation.
+  class accepted_socket : public peer_socket_type
+  {
+  public:
+    explicit accepted_socket(const PeerIoExecutor& ex)
+      : peer_socket_type(ex)
+    {
+    }
+
+    void assign(const Protocol& protocol, socket_type s,
+        bool non_blocking, asio::error_code& ec)
+    {
+      peer_socket_type::assign(protocol, s, ec);
+#if defined(ASIO_HAS_ACCEPT4)
+      if (!ec && non_blocking)
+      {
+        this->impl_.get_implementation().state_
+          |= socket_ops::internal_non_blocking;
+      }
+#else // defined(ASIO_HAS_ACCEPT4)
+      (void)non_blocking;
+#endif // defined(ASIO_HAS_ACCEPT4)
+    }
+  };
+
+  PeerIoExecutor peer_io_ex_;
+  Protocol protocol_;
+  std::size_t max_sockets_;
+  std::size_t sockets_accepted_;
+  socket_type new_sockets_[max_size];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_ACCEPT_BATCH_HPP
@@ -0,0 +1,174 @@
+//
+// detail/arena_impl.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ARENA_IMPL_HPP
+#define ASIO_DETAIL_ARENA_IMPL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/tss_ptr.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The arena for the innermost active scope on each thread.
+template <typename Arena>
+struct arena_scope_top
+{
+  static tss_ptr<Arena> value_;
+};
+
+template <typename Arena>
+tss_ptr<Arena> arena_scope_top<Arena>::value_;
+
+// A pool of memory used for the operations of a single I/O object. Blocks are
+// carved from large chunks and, once freed, are kept on per-size free lists
+// for reuse. The chunks are released when the arena is no longer referenced
+// by any I/O object and all blocks have been freed.
+class arena_impl
+  : private noncopyable
+{
+public:
+  // Makes the arena the source of memory for operations started by the
+  // current thread, for the lifetime of the scope object. A scope for a null
+  // arena does nothing.
+  class scope
+    : private noncopyable
+  {
+  public:
+    explicit scope(arena_impl* a)
+      : arena_(a),
+        next_(0)
+    {
+      if (arena_)
+      {
+        next_ = arena_scope_top<arena_impl>::value_;
+        arena_scope_top<arena_impl>::value_ = arena_;
+      }
+    }
+
+    ~scope()
+    {
+      if (arena_)
+        arena_scope_top<arena_impl>::value_ = next_;
+    }
+
+  private:
+    arena_impl* arena_;
+    arena_impl* next_;
+  };
+
+  // Construct an arena that allocates chunks of the specified size. The mutex
+  // is disabled when blocks are only allocated and freed by one thread.
+  ASIO_DECL arena_impl(std::size_t chunk_size, bool locking);
+
+  // Destroy the arena and release all chunks.
+  ASIO_DECL ~arena_impl();
+
+  // Get the arena for the innermost active scope on the current thread. The
+  // thread-specific pointer is only read once an arena has been created.
+  static arena_impl* current()
+  {
+    if (num_arenas() == 0)
+      return 0;
+    return arena_scope_top<arena_impl>::value_;
+  }
+
+  // Add a reference to the arena.
+  void add_ref()
+  {
+    ref_count_up(ref_count_);
+  }
+
+  // Release a reference to the arena, destroying it if it was the last.
+  void release()
+  {
+    if (ref_count_down(ref_count_))
+      delete this;
+  }
+
+  // Allocate a block that is aligned to ASIO_DEFAULT_ALIGN. The block holds a
+  // reference to the arena until it is deallocated.
+  ASIO_DECL void* allocate(std::size_t size);
+
+  // Return a block to the arena from which it was allocated.
+  ASIO_DECL static void deallocate(void* pointer);
+
+  // Get the total size of the chunks allocated by the arena.
+  ASIO_DECL std::size_t capacity() const;
+
+private:
+  // The number of arenas that exist in the program.
+  static atomic_count& num_arenas()
+  {
+    static atomic_count count(0);
+    return count;
+  }
+
+  // Each block is preceded by a header that identifies its arena and size.
+  struct header
+  {
+    arena_impl* arena_;
+    std::size_t size_class_;
+  };
+
+  // The header is padded to preserve the alignment of the block.
+  enum { header_size = (sizeof(header) + ASIO_DEFAULT_ALIGN - 1)
+    / ASIO_DEFAULT_ALIGN * ASIO_DEFAULT_ALIGN };
+
+  // Blocks, including their header, are rounded up to a multiple of the
+  // granularity. Blocks larger than the largest size class are allocated
+  // individually.
+  enum { granularity = ASIO_DEFAULT_ALIGN };
+  enum { num_size_classes = 1024 / granularity };
+
+  // Mutex to protect access to the free lists and chunks.
+  mutable conditionally_enabled_mutex mutex_;
+
+  // The number of I/O objects and blocks that refer to the arena. The arena
+  // is created with a single reference owned by its creator.
+  atomic_count ref_count_;
+
+  // The size of each chunk.
+  std::size_t chunk_size_;
+
+  // The total size of all chunks.
+  std::size_t capacity_;
+
+  // The list of chunks. Each chunk begins with a pointer to the next.
+  void* chunks_;
+
+  // The unused portion of the most recently allocated chunk.
+  unsigned char* chunk_begin_;
+  unsigned char* chunk_end_;
+
+  // The heads of the lists of freed blocks for each size class.
+  void* free_blocks_[num_size_classes];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/arena_impl.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_ARENA_IMPL_HPP
@@ -0,0 +1,137 @@
+//
+// detail/buffer_search.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_BUFFER_SEARCH_HPP
+#define ASIO_DETAIL_BUFFER_SEARCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "asio/buffer.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Searches for the first occurrence of a character in a buffer sequence,
+// starting from the byte at the given position. Each contiguous buffer is
+// scanned using memchr, which the C library typically vectorises. Returns
+// (position,true) if the character was found. Returns (size,false) otherwise,
+// where size is the total size of the buffer sequence.
+template <typename Iterator>
+std::pair<std::size_t, bool> buffer_find(
+    Iterator iter, Iterator end, std::size_t start, char c)
+{
+  std::size_t offset = 0;
+  for (; iter != end; ++iter)
+  {
+    const_buffer buffer(*iter);
+    std::size_t skip = start > offset ? start - offset : 0;
+    if (skip < buffer.size())
+    {
+      const char* data = static_cast<const char*>(buffer.data());
+      const void* match = std::memchr(data + skip, c, buffer.size() - skip);
+      if (match)
+        return std::make_pair(
+            offset + (static_cast<const char*>(match) - data), true);
+    }
+    offset += buffer.size();
+  }
+
+  return std::make_pair(offset, false);
+}
+
+template <typename ConstBufferSequence>
+inline std::pair<std::size_t, bool> buffer_find(
+    const ConstBufferSequence& buffers, std::size_t start, char c)
+{
+  return detail::buffer_find(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), start, c);
+}
+
+// Searches for the first occurrence of a string in a buffer sequence,
+// starting from the byte at the given position. Candidates are located by
+// scanning each contiguous buffer for the first character of the string, and
+// a match may span any number of buffers. Returns (position,true) if a full
+// match was found. Returns (position,false) if a partial match was found at
+// the end of the buffer sequence. Returns (size,false) if no full or partial
+// match was found, where size is the total size of the buffer sequence.
+template <typename Iterator>
+std::pair<std::size_t, bool> buffer_partial_search(Iterator iter,
+    Iterator end, std::size_t start, const char* s, std::size_t length)
+{
+  std::size_t offset = 0;
+  for (; iter != end; ++iter)
+  {
+    const_buffer buffer(*iter);
+    const char* data = static_cast<const char*>(buffer.data());
+    std::size_t size = buffer.size();
+    std::size_t pos = start > offset ? start - offset : 0;
+    while (pos < size)
+    {
+      if (length == 0)
+        return std::make_pair(offset + pos, true);
+
+      const void* match = std::memchr(data + pos, s[0], size - pos);
+      if (!match)
+        break;
+      pos = static_cast<const char*>(match) - data;
+
+      // Compare the rest of the string, continuing into the following
+      // buffers if the candidate runs off the end of this one.
+      std::size_t matched = (std::min)(length, size - pos);
+      if (std::memcmp(data + pos, s, matched) == 0)
+      {
+        Iterator next_iter = iter;
+        while (matched < length && ++next_iter != end)
+        {
+          const_buffer next(*next_iter);
+          std::size_t n = (std::min)(length - matched, next.size());
+          if (n > 0 && std::memcmp(next.data(), s + matched, n) != 0)
+            break;
+          matched += n;
+        }
+
+        if (matched == length)
+          return std::make_pair(offset + pos, true);
+        if (next_iter == end)
+          return std::make_pair(offset + pos, false);
+      }
+
+      ++pos;
+    }
+    offset += size;
+  }
+
+  return std::make_pair(offset, false);
+}
+
+template <typename ConstBufferSequence>
+inline std::pair<std::size_t, bool> buffer_partial_search(
+    const ConstBufferSequence& buffers, std::size_t start,
+    const char* s, std::size_t length)
+{
+  return detail::buffer_partial_search(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), start, s, length);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_BUFFER_SEARCH_HPP
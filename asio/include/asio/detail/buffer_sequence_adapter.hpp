@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include "asio/buffer.hpp"
 #include "asio/detail/array_fwd.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/recycling_allocator.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/registered_buffer.hpp"
 
@@ -33,6 +35,9 @@ public:
   // The maximum number of buffers to support in a single operation.
   enum { max_buffers = 1 };
 
+  // The number of buffers held within the adapter itself.
+  enum { inline_buffers = max_buffers };
+
 protected:
   typedef Windows::Storage::Streams::IBuffer^ native_buffer_type;
 
@@ -48,6 +53,9 @@ public:
   // The maximum number of buffers to support in a single operation.
   enum { max_buffers = 64 < max_iov_len ? 64 : max_iov_len };
 
+  // The number of buffers held within the adapter itself.
+  enum { inline_buffers = max_buffers };
+
 protected:
   typedef WSABUF native_buffer_type;
 
@@ -67,7 +75,11 @@ protected:
 #else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 public:
   // The maximum number of buffers to support in a single operation.
-  enum { max_buffers = 64 < max_iov_len ? 64 : max_iov_len };
+  enum { max_buffers = max_iov_len };
+
+  // The number of buffers held within the adapter itself. Longer sequences,
+  // up to max_buffers, are held in memory allocated by the adapter.
+  enum { inline_buffers = 64 < max_iov_len ? 64 : max_iov_len };
 
 protected:
   typedef iovec native_buffer_type;
@@ -102,20 +114,28 @@ protected:
 // Helper class to translate buffers into the native buffer representation.
 template <typename Buffer, typename Buffers>
 class buffer_sequence_adapter
-  : buffer_sequence_adapter_base
+  : buffer_sequence_adapter_base,
+    private noncopyable
 {
 public:
   enum { is_single_buffer = false };
   enum { is_registered_buffer = false };
 
   explicit buffer_sequence_adapter(const Buffers& buffer_sequence)
-    : count_(0), total_buffer_size_(0)
+    : buffers_(inline_buffers_), count_(0), total_buffer_size_(0)
   {
     buffer_sequence_adapter::init(
         asio::buffer_sequence_begin(buffer_sequence),
         asio::buffer_sequence_end(buffer_sequence));
   }
 
+  ~buffer_sequence_adapter()
+  {
+    // Allocated storage is always filled, so its size is the buffer count.
+    if (buffers_ != inline_buffers_)
+      recycling_allocator<native_buffer_type>().deallocate(buffers_, count_);
+  }
+
   native_buffer_type* buffers()
   {
     return buffers_;
@@ -179,6 +199,9 @@ private:
     Iterator iter = begin;
     for (; iter != end && count_ < max_buffers; ++iter, ++count_)
     {
+      if (count_ == static_cast<std::size_t>(inline_buffers))
+        allocate_buffers(iter, end);
+
       Buffer buffer(*iter);
       init_native_buffer(buffers_[count_], buffer);
       total_buffer_size_ += buffer.size();
@@ -244,7 +267,25 @@ private:
     return Buffer(storage.data(), storage.size() - unused_storage.size());
   }
 
-  native_buffer_type buffers_[max_buffers];
+  // Move the buffers out of the inline storage to make room for a long
+  // sequence, sized for the buffers that remain. Operations keep their adapter
+  // for their lifetime, so this happens once per operation.
+  template <typename Iterator>
+  void allocate_buffers(Iterator iter, Iterator end)
+  {
+    std::size_t capacity = count_;
+    for (; iter != end && capacity < max_buffers; ++iter)
+      ++capacity;
+
+    native_buffer_type* buffers =
+      recycling_allocator<native_buffer_type>().allocate(capacity);
+    for (std::size_t i = 0; i < count_; ++i)
+      buffers[i] = inline_buffers_[i];
+    buffers_ = buffers;
+  }
+
+  native_buffer_type inline_buffers_[inline_buffers];
+  native_buffer_type* buffers_;
   std::size_t count_;
   std::size_t total_buffer_size_;
 };
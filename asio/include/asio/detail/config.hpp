@@ -1667,7 +1667,8 @@
 # include <unistd.h>
 #endif // defined(ASIO_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd, memfd, recvmmsg/sendmmsg, UDP offload,
+// zero-copy sends, TCP Fast Open and accept4.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(ASIO_HAS_EPOLL)
@@ -1691,6 +1692,61 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_MEMFD)
+#  if !defined(ASIO_DISABLE_MEMFD)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#    define ASIO_HAS_MEMFD 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#  endif // !defined(ASIO_DISABLE_MEMFD)
+# endif // !defined(ASIO_HAS_MEMFD)
+# if !defined(ASIO_HAS_MMSG)
+#  if !defined(ASIO_DISABLE_MMSG)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#    if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#     define ASIO_HAS_MMSG 1
+#    endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#  endif // !defined(ASIO_DISABLE_MMSG)
+# endif // !defined(ASIO_HAS_MMSG)
+# if !defined(ASIO_HAS_UDP_GSO)
+#  if !defined(ASIO_DISABLE_UDP_GSO)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(4,18,0)
+#    define ASIO_HAS_UDP_GSO 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,18,0)
+#  endif // !defined(ASIO_DISABLE_UDP_GSO)
+# endif // !defined(ASIO_HAS_UDP_GSO)
+# if !defined(ASIO_HAS_UDP_GRO)
+#  if !defined(ASIO_DISABLE_UDP_GRO)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,0,0)
+#    define ASIO_HAS_UDP_GRO 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,0,0)
+#  endif // !defined(ASIO_DISABLE_UDP_GRO)
+# endif // !defined(ASIO_HAS_UDP_GRO)
+# if !defined(ASIO_HAS_MSG_ZEROCOPY)
+#  if !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#   if defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#     if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#      define ASIO_HAS_MSG_ZEROCOPY 1
+#     endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#    endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#   endif // defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#  endif // !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+# endif // !defined(ASIO_HAS_MSG_ZEROCOPY)
+# if !defined(ASIO_HAS_TCP_FASTOPEN)
+#  if !defined(ASIO_DISABLE_TCP_FASTOPEN)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(4,11,0)
+#    define ASIO_HAS_TCP_FASTOPEN 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,11,0)
+#  endif // !defined(ASIO_DISABLE_TCP_FASTOPEN)
+# endif // !defined(ASIO_HAS_TCP_FASTOPEN)
+# if !defined(ASIO_HAS_ACCEPT4)
+#  if !defined(ASIO_DISABLE_ACCEPT4)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#    define ASIO_HAS_ACCEPT4 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#  endif // !defined(ASIO_DISABLE_ACCEPT4)
+# endif // !defined(ASIO_HAS_ACCEPT4)
 #endif // defined(__linux__)
 
 // Linux: io_uring is used instead of epoll.
@@ -1829,6 +1885,24 @@
         //   && !defined(__CYGWIN__)
 #endif // !defined(ASIO_HAS_PIPE)
 
+// Linux: splice() and sendfile().
+#if defined(__linux__)
+# if !defined(ASIO_HAS_SPLICE)
+#  if !defined(ASIO_DISABLE_SPLICE)
+#   if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+#    define ASIO_HAS_SPLICE 1
+#   endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+#  endif // !defined(ASIO_DISABLE_SPLICE)
+# endif // !defined(ASIO_HAS_SPLICE)
+# if !defined(ASIO_HAS_SENDFILE)
+#  if !defined(ASIO_DISABLE_SENDFILE)
+#   if defined(ASIO_HAS_SPLICE)
+#    define ASIO_HAS_SENDFILE 1
+#   endif // defined(ASIO_HAS_SPLICE)
+#  endif // !defined(ASIO_DISABLE_SENDFILE)
+# endif // !defined(ASIO_HAS_SENDFILE)
+#endif // defined(__linux__)
+
 // Can use sigaction() instead of signal().
 #if !defined(ASIO_HAS_SIGACTION)
 # if !defined(ASIO_DISABLE_SIGACTION)
@@ -2066,6 +2140,26 @@
         //   || (defined(__MACH__) && defined(__APPLE__))
 #endif // !defined(ASIO_DISABLE_SSIZE_T)
 
+// Support for a clock based on the processor's time stamp counter.
+#if !defined(ASIO_HAS_TSC_CLOCK)
+# if !defined(ASIO_DISABLE_TSC_CLOCK)
+#  if defined(__GNUC__) && defined(__x86_64__)
+#   define ASIO_HAS_TSC_CLOCK 1
+#  elif defined(ASIO_MSVC) && defined(_M_X64)
+#   define ASIO_HAS_TSC_CLOCK 1
+#  endif // defined(ASIO_MSVC) && defined(_M_X64)
+# endif // !defined(ASIO_DISABLE_TSC_CLOCK)
+#endif // !defined(ASIO_HAS_TSC_CLOCK)
+
+// Support for returning recycled memory to the thread that allocated it.
+#if !defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+# if !defined(ASIO_DISABLE_RECYCLING_REMOTE_FREE)
+#  if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+#   define ASIO_HAS_RECYCLING_REMOTE_FREE 1
+#  endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# endif // !defined(ASIO_DISABLE_RECYCLING_REMOTE_FREE)
+#endif // !defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
 // Helper macros to manage transition away from error_code return values.
 #if defined(ASIO_NO_DEPRECATED)
 # define ASIO_SYNC_OP_VOID void
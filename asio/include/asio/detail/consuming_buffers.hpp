@@ -17,7 +17,9 @@
 
 #include "asio/detail/config.hpp"
 #include <cstddef>
+#include <new>
 #include "asio/buffer.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/registered_buffer.hpp"
@@ -50,24 +52,425 @@ struct prepared_buffers_max<std::array<Elem, N> >
 
 #endif // defined(ASIO_HAS_STD_ARRAY)
 
-// A buffer sequence used to represent a subsequence of the buffers.
+// A block of buffers shared between a consuming_buffers object and the
+// prepared_buffers sequences taken from it. Each buffer is stored alongside
+// its native representation, so that the sequence can be passed to the
+// operating system without being translated again. The buffers follow the
+// block in the same allocation, which is sized for the number of buffers
+// needed rather than for the maximum.
 template <typename Buffer, std::size_t MaxBuffers>
-struct prepared_buffers
+class prepared_buffers_block
+  : buffer_sequence_adapter_base
 {
+public:
+  // Allocate a block with room for the specified number of buffers. Returns 0
+  // if no memory is available.
+  static prepared_buffers_block* create(std::size_t capacity)
+  {
+    void* p = ::operator new(sizeof(prepared_buffers_block)
+        + capacity * element_size, std::nothrow);
+    if (!p)
+      return 0;
+    prepared_buffers_block* b = new (p) prepared_buffers_block(capacity);
+    for (std::size_t i = 0; i < capacity; ++i)
+      new (b->elems() + i) Buffer();
+    return b;
+  }
+
+  // Release a reference to the block, destroying it if it was the last.
+  static void release(prepared_buffers_block* b)
+  {
+    if (b && ref_count_down(b->ref_count_))
+    {
+      b->~prepared_buffers_block();
+      ::operator delete(b);
+    }
+  }
+
+  // Get the number of buffers that the block can hold.
+  std::size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  // Store a buffer at the specified position.
+  void set(std::size_t i, const Buffer& buffer)
+  {
+    elems()[i] = buffer;
+#if !defined(ASIO_WINDOWS_RUNTIME)
+    init_native_buffer(natives()[i], buffer);
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+  }
+
+  // Move the buffers in the range [begin, end) to the start of the block.
+  void compact(std::size_t begin, std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      elems()[i - begin] = elems()[i];
+#if !defined(ASIO_WINDOWS_RUNTIME)
+      natives()[i - begin] = natives()[i];
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+    }
+  }
+
+private:
+  template <typename, std::size_t> friend class prepared_buffers;
+  template <typename, typename, typename> friend class consuming_buffers;
+  template <typename, typename> friend class buffer_sequence_adapter;
+
+  explicit prepared_buffers_block(std::size_t capacity)
+    : ref_count_(1),
+      capacity_(capacity)
+  {
+  }
+
+  Buffer* elems()
+  {
+    return reinterpret_cast<Buffer*>(this + 1);
+  }
+
+  const Buffer* elems() const
+  {
+    return reinterpret_cast<const Buffer*>(this + 1);
+  }
+
+#if !defined(ASIO_WINDOWS_RUNTIME)
+  native_buffer_type* natives()
+  {
+    return reinterpret_cast<native_buffer_type*>(elems() + capacity_);
+  }
+
+  enum { element_size = sizeof(Buffer) + sizeof(native_buffer_type) };
+#else // !defined(ASIO_WINDOWS_RUNTIME)
+  enum { element_size = sizeof(Buffer) };
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
+  atomic_count ref_count_;
+  std::size_t capacity_;
+};
+
+// A buffer sequence used to represent a subsequence of the buffers. Short
+// subsequences are held inline. Longer ones are held in a block allocated on
+// demand, which is shared by all copies of the sequence.
+template <typename Buffer, std::size_t MaxBuffers>
+class prepared_buffers
+{
+public:
   typedef Buffer value_type;
   typedef const Buffer* const_iterator;
+  typedef prepared_buffers_block<Buffer, MaxBuffers> block_type;
+
+  enum { inline_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
+  enum { max_buffers = MaxBuffers };
+
+  prepared_buffers()
+    : block_(0),
+      begin_(0),
+      count_(0),
+      total_size_(0)
+  {
+  }
+
+  // Construct to refer to a range of the buffers in a block.
+  prepared_buffers(block_type* block, std::size_t begin,
+      std::size_t count, std::size_t total_size)
+    : block_(block),
+      begin_(begin),
+      count_(count),
+      total_size_(total_size)
+  {
+    ref_count_up(block_->ref_count_);
+  }
+
+  prepared_buffers(const prepared_buffers& other)
+    : block_(other.block_),
+      begin_(other.begin_),
+      count_(other.count_),
+      total_size_(other.total_size_)
+  {
+    if (block_)
+      ref_count_up(block_->ref_count_);
+    else
+      for (std::size_t i = 0; i < count_; ++i)
+        elems_[i] = other.elems_[i];
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  prepared_buffers(prepared_buffers&& other)
+    : block_(other.block_),
+      begin_(other.begin_),
+      count_(other.count_),
+      total_size_(other.total_size_)
+  {
+    if (!block_)
+      for (std::size_t i = 0; i < count_; ++i)
+        elems_[i] = other.elems_[i];
+    other.block_ = 0;
+    other.begin_ = 0;
+    other.count_ = 0;
+    other.total_size_ = 0;
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  ~prepared_buffers()
+  {
+    release();
+  }
+
+  prepared_buffers& operator=(const prepared_buffers& other)
+  {
+    if (this != &other)
+    {
+      if (other.block_)
+        ref_count_up(other.block_->ref_count_);
+      release();
+      block_ = other.block_;
+      begin_ = other.begin_;
+      count_ = other.count_;
+      total_size_ = other.total_size_;
+      if (!block_)
+        for (std::size_t i = 0; i < count_; ++i)
+          elems_[i] = other.elems_[i];
+    }
+    return *this;
+  }
+
+  const_iterator begin() const
+  {
+    return block_ ? block_->elems() + begin_ : elems_;
+  }
+
+  const_iterator end() const
+  {
+    return begin() + count_;
+  }
+
+  // Get the total number of bytes in the sequence.
+  std::size_t total_size() const
+  {
+    return total_size_;
+  }
+
+  // Determine whether another buffer may be added.
+  bool full() const
+  {
+    return begin_ + count_ >= (block_ ? block_->capacity()
+        : static_cast<std::size_t>(max_buffers));
+  }
+
+  // Make room for the specified total number of buffers, up to the maximum.
+  // Sequences that fit inline are unaffected.
+  void reserve(std::size_t n)
+  {
+    if (!block_ && n > static_cast<std::size_t>(inline_buffers))
+      allocate_block(n < static_cast<std::size_t>(max_buffers)
+          ? n : static_cast<std::size_t>(max_buffers));
+  }
+
+  // Add a buffer to the end of the sequence. Returns false if there is no
+  // room for it.
+  bool push_back(const Buffer& buffer)
+  {
+    if (!block_)
+    {
+      if (count_ < static_cast<std::size_t>(inline_buffers))
+      {
+        elems_[count_++] = buffer;
+        total_size_ += buffer.size();
+        return true;
+      }
+
+      if (full() || !allocate_block(max_buffers))
+        return false;
+    }
+
+    if (full())
+      return false;
+
+    block_->set(begin_ + count_++, buffer);
+    total_size_ += buffer.size();
+    return true;
+  }
+
+private:
+  template <typename, typename, typename> friend class consuming_buffers;
+  template <typename, typename> friend class buffer_sequence_adapter;
+
+  // Move the inline buffers to a new block with the specified capacity.
+  bool allocate_block(std::size_t capacity)
+  {
+    block_ = block_type::create(capacity);
+    if (!block_)
+      return false;
+    for (std::size_t i = 0; i < count_; ++i)
+      block_->set(i, elems_[i]);
+    return true;
+  }
+
+  void release()
+  {
+    block_type::release(block_);
+  }
+
+  Buffer elems_[inline_buffers];
+  block_type* block_;
+  std::size_t begin_;
+  std::size_t count_;
+  std::size_t total_size_;
+};
+
+#if !defined(ASIO_WINDOWS_RUNTIME)
+
+// Specialisation of the buffer sequence adapter for prepared buffers. When the
+// buffers are held in a block, the adapter refers to the native buffers stored
+// there rather than translating the sequence again.
+template <typename Buffer, typename Elem, std::size_t MaxBuffers>
+class buffer_sequence_adapter<Buffer, prepared_buffers<Elem, MaxBuffers> >
+  : buffer_sequence_adapter_base,
+    private noncopyable
+{
+public:
+  enum { is_single_buffer = false };
+  enum { is_registered_buffer = false };
+
+  typedef prepared_buffers<Elem, MaxBuffers> prepared_buffers_type;
+  typedef typename prepared_buffers_type::const_iterator const_iterator;
+
+  explicit buffer_sequence_adapter(
+      const prepared_buffers_type& buffer_sequence)
+    : count_(0), total_buffer_size_(0)
+  {
+    if (buffer_sequence.block_)
+    {
+      buffers_ = buffer_sequence.block_->natives() + buffer_sequence.begin_;
+      if (buffer_sequence.count_ <= static_cast<std::size_t>(max_buffers))
+      {
+        count_ = buffer_sequence.count_;
+        total_buffer_size_ = buffer_sequence.total_size_;
+      }
+      else
+      {
+        count_ = max_buffers;
+        const_iterator iter = buffer_sequence.begin();
+        for (std::size_t i = 0; i < count_; ++i, ++iter)
+          total_buffer_size_ += iter->size();
+      }
+    }
+    else
+    {
+      buffers_ = inline_buffers_;
+      const_iterator iter = buffer_sequence.begin();
+      const_iterator end = buffer_sequence.end();
+      for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+      {
+        Buffer buffer(*iter);
+        init_native_buffer(buffers_[count_], buffer);
+        total_buffer_size_ += buffer.size();
+      }
+    }
+  }
+
+  native_buffer_type* buffers()
+  {
+    return buffers_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+  std::size_t total_size() const
+  {
+    return total_buffer_size_;
+  }
+
+  registered_buffer_id registered_id() const
+  {
+    return registered_buffer_id();
+  }
+
+  bool all_empty() const
+  {
+    return total_buffer_size_ == 0;
+  }
+
+  static bool all_empty(const prepared_buffers_type& buffer_sequence)
+  {
+    return buffer_sequence.total_size() == 0;
+  }
+
+  static void validate(const prepared_buffers_type& buffer_sequence)
+  {
+    const_iterator iter = buffer_sequence.begin();
+    for (; iter != buffer_sequence.end(); ++iter)
+    {
+      Buffer buffer(*iter);
+      buffer.data();
+    }
+  }
+
+  static Buffer first(const prepared_buffers_type& buffer_sequence)
+  {
+    const_iterator iter = buffer_sequence.begin();
+    for (; iter != buffer_sequence.end(); ++iter)
+    {
+      Buffer buffer(*iter);
+      if (buffer.size() != 0)
+        return buffer;
+    }
+    return Buffer();
+  }
 
-  enum { max_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
+  enum { linearisation_storage_size = 8192 };
+
+  static Buffer linearise(const prepared_buffers_type& buffer_sequence,
+      const asio::mutable_buffer& storage)
+  {
+    asio::mutable_buffer unused_storage = storage;
+    const_iterator iter = buffer_sequence.begin();
+    const_iterator end = buffer_sequence.end();
+    while (iter != end && unused_storage.size() != 0)
+    {
+      Buffer buffer(*iter);
+      ++iter;
+      if (buffer.size() == 0)
+        continue;
+      if (unused_storage.size() == storage.size())
+      {
+        if (iter == end)
+          return buffer;
+        if (buffer.size() >= unused_storage.size())
+          return buffer;
+      }
+      unused_storage += asio::buffer_copy(unused_storage, buffer);
+    }
+    return Buffer(storage.data(), storage.size() - unused_storage.size());
+  }
 
-  prepared_buffers() : count(0) {}
-  const_iterator begin() const { return elems; }
-  const_iterator end() const { return elems + count; }
+private:
+  enum { inline_buffers = prepared_buffers_type::inline_buffers };
 
-  Buffer elems[max_buffers];
-  std::size_t count;
+  native_buffer_type inline_buffers_[inline_buffers];
+  native_buffer_type* buffers_;
+  std::size_t count_;
+  std::size_t total_buffer_size_;
 };
 
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
 // A proxy for a sub-range in a list of buffers.
+//
+// When a prepared sequence is too long to be held inline, the block holding it
+// is kept as a window onto the buffers. Each transfer consumes buffers from
+// the front of the window, and the next prepare() tops it up from the end, so
+// resuming after a partial transfer costs time proportional to the number of
+// buffers that changed rather than to the length of the window.
+//
+// The cursors into the buffer sequence are recalculated lazily after the
+// object is copied or moved, as composed operations move their state each
+// time they start an operation.
 template <typename Buffer, typename Buffers, typename Buffer_Iterator>
 class consuming_buffers
 {
@@ -80,12 +483,82 @@ public:
     : buffers_(buffers),
       total_consumed_(0),
       next_elem_(0),
-      next_elem_offset_(0)
+      next_elem_offset_(0),
+      next_(asio::buffer_sequence_begin(buffers_)),
+      window_(0),
+      window_begin_(0),
+      window_end_(0),
+      window_size_(0),
+      fill_elem_(0),
+      fill_elem_offset_(0),
+      fill_(next_),
+      cursors_valid_(true)
   {
     using asio::buffer_size;
     total_size_ = buffer_size(buffers);
   }
 
+  // A copy does not share the window, and builds its own when it is first
+  // prepared.
+  consuming_buffers(const consuming_buffers& other)
+    : buffers_(other.buffers_),
+      total_size_(other.total_size_),
+      total_consumed_(other.total_consumed_),
+      next_elem_(other.next_elem_),
+      next_elem_offset_(other.next_elem_offset_),
+      next_(asio::buffer_sequence_begin(buffers_)),
+      window_(0),
+      window_begin_(0),
+      window_end_(0),
+      window_size_(0),
+      fill_elem_(0),
+      fill_elem_offset_(0),
+      fill_(next_),
+      cursors_valid_(false)
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  consuming_buffers(consuming_buffers&& other)
+    : buffers_(ASIO_MOVE_CAST(Buffers)(other.buffers_)),
+      total_size_(other.total_size_),
+      total_consumed_(other.total_consumed_),
+      next_elem_(other.next_elem_),
+      next_elem_offset_(other.next_elem_offset_),
+      next_(asio::buffer_sequence_begin(buffers_)),
+      window_(other.window_),
+      window_begin_(other.window_begin_),
+      window_end_(other.window_end_),
+      window_size_(other.window_size_),
+      fill_elem_(other.fill_elem_),
+      fill_elem_offset_(other.fill_elem_offset_),
+      fill_(next_),
+      cursors_valid_(false)
+  {
+    other.window_ = 0;
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  ~consuming_buffers()
+  {
+    release_window();
+  }
+
+  consuming_buffers& operator=(const consuming_buffers& other)
+  {
+    if (this != &other)
+    {
+      release_window();
+      buffers_ = other.buffers_;
+      total_size_ = other.total_size_;
+      total_consumed_ = other.total_consumed_;
+      next_elem_ = other.next_elem_;
+      next_elem_offset_ = other.next_elem_offset_;
+      cursors_valid_ = false;
+    }
+    return *this;
+  }
+
   // Determine if we are at the end of the buffers.
   bool empty() const
   {
@@ -95,22 +568,34 @@ public:
   // Get the buffer for a single transfer, with a size.
   prepared_buffers_type prepare(std::size_t max_size)
   {
-    prepared_buffers_type result;
+    restore_cursors();
 
-    Buffer_Iterator next = asio::buffer_sequence_begin(buffers_);
-    Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
+    if (window_)
+    {
+      if (window_size_ <= max_size)
+        return prepare_window(max_size);
+
+      // The window holds more than may be transferred, so discard it and
+      // build a shorter sequence from the consumed position.
+      release_window();
+    }
+
+    prepared_buffers_type result;
+    Buffer_Iterator next = next_;
+    std::size_t next_elem = next_elem_;
+    std::size_t next_elem_offset = next_elem_offset_;
+    fill(result, next, next_elem, next_elem_offset, max_size);
 
-    std::advance(next, next_elem_);
-    std::size_t elem_offset = next_elem_offset_;
-    while (next != end && max_size > 0 && (result.count) < result.max_buffers)
+    if (result.block_)
     {
-      Buffer next_buf = Buffer(*next) + elem_offset;
-      result.elems[result.count] = asio::buffer(next_buf, max_size);
-      max_size -= result.elems[result.count].size();
-      elem_offset = 0;
-      if (result.elems[result.count].size() > 0)
-        ++result.count;
-      ++next;
+      ref_count_up(result.block_->ref_count_);
+      window_ = result.block_;
+      window_begin_ = 0;
+      window_end_ = result.count_;
+      window_size_ = result.total_size_;
+      fill_ = next;
+      fill_elem_ = next_elem;
+      fill_elem_offset_ = next_elem_offset;
     }
 
     return result;
@@ -120,14 +605,16 @@ public:
   void consume(std::size_t size)
   {
     total_consumed_ += size;
+    restore_cursors();
+
+    if (window_)
+      consume_window(size);
 
-    Buffer_Iterator next = asio::buffer_sequence_begin(buffers_);
     Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
 
-    std::advance(next, next_elem_);
-    while (next != end && size > 0)
+    while (next_ != end && size > 0)
     {
-      Buffer next_buf = Buffer(*next) + next_elem_offset_;
+      Buffer next_buf = Buffer(*next_) + next_elem_offset_;
       if (size < next_buf.size())
       {
         next_elem_offset_ += size;
@@ -138,7 +625,7 @@ public:
         size -= next_buf.size();
         next_elem_offset_ = 0;
         ++next_elem_;
-        ++next;
+        ++next_;
       }
     }
   }
@@ -150,11 +637,140 @@ public:
   }
 
 private:
+  typedef typename prepared_buffers_type::block_type block_type;
+
+  // Recalculate the cursors after the buffer sequence has been copied or
+  // moved. The fill cursor is found from the consume cursor, as the window is
+  // usually much shorter than the consumed part of the sequence.
+  void restore_cursors()
+  {
+    if (!cursors_valid_)
+    {
+      next_ = asio::buffer_sequence_begin(buffers_);
+      std::advance(next_, next_elem_);
+      if (window_)
+      {
+        fill_ = next_;
+        std::advance(fill_, fill_elem_ - next_elem_);
+      }
+      cursors_valid_ = true;
+    }
+  }
+
+  // Append buffers to a prepared sequence, starting from the given position.
+  void fill(prepared_buffers_type& result, Buffer_Iterator& next,
+      std::size_t& next_elem, std::size_t& next_elem_offset,
+      std::size_t max_size)
+  {
+    Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
+
+    while (next != end && max_size > 0 && !result.full())
+    {
+      // Before the sequence outgrows its inline storage, size its block for
+      // the buffers that remain.
+      if (!result.block_ && result.count_
+          == static_cast<std::size_t>(prepared_buffers_type::inline_buffers))
+        result.reserve(result.count_ + count_remaining(next, end));
+
+      Buffer next_buf = Buffer(*next) + next_elem_offset;
+      Buffer buf = asio::buffer(next_buf, max_size);
+      if (buf.size() > 0 && !result.push_back(buf))
+        break;
+      max_size -= buf.size();
+      if (buf.size() == next_buf.size())
+      {
+        next_elem_offset = 0;
+        ++next_elem;
+        ++next;
+      }
+      else
+        next_elem_offset += buf.size();
+    }
+  }
+
+  // Count the buffers from the given position, up to the maximum number that
+  // may be prepared.
+  static std::size_t count_remaining(Buffer_Iterator next, Buffer_Iterator end)
+  {
+    std::size_t count = 0;
+    std::size_t max_buffers = prepared_buffers_type::max_buffers;
+    for (; next != end && count < max_buffers; ++next)
+      ++count;
+    return count;
+  }
+
+  // Get the buffers in the window, topped up from the fill position.
+  prepared_buffers_type prepare_window(std::size_t max_size)
+  {
+    // Buffers are only moved to the start of the block once at least half of
+    // it has been consumed, so the cost of moving them is amortised.
+    std::size_t capacity = window_->capacity();
+    if (window_end_ == capacity && window_begin_ >= capacity / 2)
+    {
+      window_->compact(window_begin_, window_end_);
+      window_end_ -= window_begin_;
+      window_begin_ = 0;
+    }
+
+    prepared_buffers_type result(window_, window_begin_,
+        window_end_ - window_begin_, window_size_);
+    fill(result, fill_, fill_elem_, fill_elem_offset_,
+        max_size - window_size_);
+    window_end_ = window_begin_ + result.count_;
+    window_size_ = result.total_size_;
+
+    return result;
+  }
+
+  // Remove the consumed bytes from the front of the window.
+  void consume_window(std::size_t size)
+  {
+    while (window_begin_ != window_end_ && size > 0)
+    {
+      Buffer& buf = window_->elems()[window_begin_];
+      if (size < buf.size())
+      {
+        window_->set(window_begin_, buf + size);
+        window_size_ -= size;
+        size = 0;
+      }
+      else
+      {
+        size -= buf.size();
+        window_size_ -= buf.size();
+        ++window_begin_;
+      }
+    }
+
+    if (window_begin_ == window_end_)
+      window_begin_ = window_end_ = 0;
+
+    // More was consumed than was prepared, so the window no longer matches the
+    // consumed position.
+    if (size > 0)
+      release_window();
+  }
+
+  void release_window()
+  {
+    block_type::release(window_);
+    window_ = 0;
+  }
+
   Buffers buffers_;
   std::size_t total_size_;
   std::size_t total_consumed_;
   std::size_t next_elem_;
   std::size_t next_elem_offset_;
+  Buffer_Iterator next_;
+  block_type* window_;
+  std::size_t window_begin_;
+  std::size_t window_end_;
+  std::size_t window_size_;
+  std::size_t fill_elem_;
+  std::size_t fill_elem_offset_;
+  Buffer_Iterator fill_;
+  bool cursors_valid_;
 };
 
 // Base class of all consuming_buffers specialisations for single buffers.
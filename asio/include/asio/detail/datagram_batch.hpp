@@ -0,0 +1,169 @@
+//
+// detail/datagram_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DATAGRAM_BATCH_HPP
+#define ASIO_DETAIL_DATAGRAM_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_HAS_IOCP)
+
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/datagram_slot.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Transfers an array of datagram slots using as few system calls as possible.
+// The slots are passed to the system in blocks, each of which is built on the
+// stack.
+class datagram_batch
+{
+public:
+  // The maximum number of datagrams passed to a single system call.
+  enum { max_messages = 64 };
+
+  // Receive datagrams into the slots, stopping at the first slot that cannot
+  // be filled without blocking. Returns false if the operation would block
+  // before any datagram is received. An error is reported only if no datagram
+  // is received.
+  template <typename Endpoint>
+  static bool non_blocking_receive(socket_type s,
+      basic_datagram_slot<mutable_buffer, Endpoint>* slots,
+      std::size_t count, int flags, asio::error_code& ec,
+      std::size_t& slots_transferred)
+  {
+    slots_transferred = 0;
+    bool result = true;
+    while (slots_transferred < count)
+    {
+      basic_datagram_slot<mutable_buffer, Endpoint>* block
+        = slots + slots_transferred;
+      std::size_t n = count - slots_transferred;
+      if (n > max_messages)
+        n = max_messages;
+
+      socket_ops::buf bufs[max_messages];
+      mmsghdr_type msgs[max_messages];
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        socket_ops::init_buf(bufs[i],
+            block[i].buffer().data(), block[i].buffer().size());
+        msgs[i] = mmsghdr_type();
+        msgs[i].msg_hdr.msg_name = block[i].endpoint().data();
+        msgs[i].msg_hdr.msg_namelen =
+          static_cast<int>(block[i].endpoint().capacity());
+        msgs[i].msg_hdr.msg_iov = &bufs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      std::size_t messages = 0;
+      result = socket_ops::non_blocking_recvmmsg(
+          s, msgs, n, flags, ec, messages);
+      if (!result || ec)
+        break;
+
+      for (std::size_t i = 0; i < messages; ++i)
+      {
+        block[i].endpoint().resize(msgs[i].msg_hdr.msg_namelen);
+        block[i].size(msgs[i].msg_len);
+        block[i].flags(msgs[i].msg_hdr.msg_flags);
+      }
+
+      slots_transferred += messages;
+      if (messages < n)
+        break;
+    }
+
+    if (slots_transferred > 0)
+    {
+      asio::error::clear(ec);
+      return true;
+    }
+
+    return result;
+  }
+
+  // Send the datagrams in the slots, stopping at the first slot that cannot
+  // be sent without blocking. Returns false if the operation would block
+  // before any datagram is sent. An error is reported only if no datagram is
+  // sent.
+  template <typename Endpoint>
+  static bool non_blocking_send(socket_type s,
+      basic_datagram_slot<const_buffer, Endpoint>* slots,
+      std::size_t count, int flags, asio::error_code& ec,
+      std::size_t& slots_transferred)
+  {
+    slots_transferred = 0;
+    bool result = true;
+    while (slots_transferred < count)
+    {
+      basic_datagram_slot<const_buffer, Endpoint>* block
+        = slots + slots_transferred;
+      std::size_t n = count - slots_transferred;
+      if (n > max_messages)
+        n = max_messages;
+
+      socket_ops::buf bufs[max_messages];
+      mmsghdr_type msgs[max_messages];
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        socket_ops::init_buf(bufs[i],
+            block[i].buffer().data(), block[i].buffer().size());
+        msgs[i] = mmsghdr_type();
+        msgs[i].msg_hdr.msg_name = block[i].endpoint().data();
+        msgs[i].msg_hdr.msg_namelen =
+          static_cast<int>(block[i].endpoint().size());
+        msgs[i].msg_hdr.msg_iov = &bufs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      std::size_t messages = 0;
+      result = socket_ops::non_blocking_sendmmsg(
+          s, msgs, n, flags, ec, messages);
+      if (!result || ec)
+        break;
+
+      for (std::size_t i = 0; i < messages; ++i)
+        block[i].size(msgs[i].msg_len);
+
+      slots_transferred += messages;
+      if (messages < n)
+        break;
+    }
+
+    if (slots_transferred > 0)
+    {
+      asio::error::clear(ec);
+      return true;
+    }
+
+    return result;
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // !defined(ASIO_HAS_IOCP)
+
+#endif // ASIO_DETAIL_DATAGRAM_BATCH_HPP
@@ -109,6 +109,16 @@ ASIO_DECL bool non_blocking_write1(int d,
     const void* data, std::size_t size,
     asio::error_code& ec, std::size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_SPLICE)
+
+// Moves data from one descriptor to another without copying it to user space.
+// At least one of the descriptors must be a pipe. Any pipe involved is used in
+// non-blocking mode.
+ASIO_DECL bool non_blocking_splice(int from, int to, std::size_t size,
+    asio::error_code& ec, std::size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_SPLICE)
+
 #if defined(ASIO_HAS_FILE)
 
 ASIO_DECL std::size_t sync_read_at(int d, state_type state,
@@ -42,7 +42,8 @@ public:
     : reactor_op(success_ec,
         &descriptor_read_op_base::do_perform, complete_func),
       descriptor_(descriptor),
-      buffers_(buffers)
+      buffers_(buffers),
+      bufs_(buffers)
   {
   }
 
@@ -63,10 +64,9 @@ public:
     }
     else
     {
-      bufs_type bufs(o->buffers_);
       result = descriptor_ops::non_blocking_read(o->descriptor_,
-          bufs.buffers(), bufs.count(), o->ec_, o->bytes_transferred_)
-        ? done : not_done;
+          o->bufs_.buffers(), o->bufs_.count(),
+          o->ec_, o->bytes_transferred_) ? done : not_done;
     }
 
     ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_read",
@@ -78,6 +78,7 @@ public:
 private:
   int descriptor_;
   MutableBufferSequence buffers_;
+  buffer_sequence_adapter<asio::mutable_buffer, MutableBufferSequence> bufs_;
 };
 
 template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
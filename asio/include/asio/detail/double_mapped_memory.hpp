@@ -0,0 +1,54 @@
+//
+// detail/double_mapped_memory.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DOUBLE_MAPPED_MEMORY_HPP
+#define ASIO_DETAIL_DOUBLE_MAPPED_MEMORY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Memory that is mapped twice at adjacent virtual addresses, so that a write
+// to byte i is also visible at byte i + size. A range that wraps around the
+// end of a circular buffer held in such memory is therefore contiguous.
+class double_mapped_memory
+{
+public:
+  // Get the granularity of the mappings. Sizes passed to map() must be a
+  // multiple of this value.
+  ASIO_DECL static std::size_t granularity();
+
+  // Map a region of the given size twice. Returns the address of the first
+  // mapping, or null if the region could not be mapped.
+  ASIO_DECL static void* map(std::size_t size, asio::error_code& ec);
+
+  // Unmap a region previously returned by map().
+  ASIO_DECL static void unmap(void* p, std::size_t size);
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/double_mapped_memory.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_DOUBLE_MAPPED_MEMORY_HPP
@@ -70,6 +70,9 @@ public:
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
     bool shutdown_;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    uint32_t zero_copy_counter_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
@@ -124,6 +127,16 @@ public:
       per_descriptor_data& descriptor_data, reactor_op* op,
       bool is_continuation, bool allow_speculative);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Get the counter that numbers the zero-copy sends made on the descriptor,
+  // in the same way as the kernel does. The counter may only be used by an
+  // operation while it is being performed.
+  static uint32_t* zero_copy_counter(per_descriptor_data& descriptor_data)
+  {
+    return &descriptor_data->zero_copy_counter_;
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Cancel all operations associated with the given descriptor. The
   // handlers associated with the descriptor will be invoked with the
   // operation_aborted error.
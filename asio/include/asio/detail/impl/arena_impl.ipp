@@ -0,0 +1,135 @@
+//
+// detail/impl/arena_impl.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_ARENA_IMPL_IPP
+#define ASIO_DETAIL_IMPL_ARENA_IMPL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/arena_impl.hpp"
+#include "asio/detail/memory.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+arena_impl::arena_impl(std::size_t chunk_size, bool locking)
+  : mutex_(locking),
+    ref_count_(1),
+    chunk_size_(chunk_size),
+    capacity_(0),
+    chunks_(0),
+    chunk_begin_(0),
+    chunk_end_(0)
+{
+  for (int i = 0; i < num_size_classes; ++i)
+    free_blocks_[i] = 0;
+
+  ref_count_up(num_arenas());
+}
+
+arena_impl::~arena_impl()
+{
+  while (void* chunk = chunks_)
+  {
+    chunks_ = *static_cast<void**>(chunk);
+    aligned_delete(chunk);
+  }
+
+  ref_count_down(num_arenas());
+}
+
+void* arena_impl::allocate(std::size_t size)
+{
+  std::size_t block_size = (header_size + size + granularity - 1)
+    / granularity * granularity;
+  std::size_t size_class = block_size / granularity - 1;
+
+  unsigned char* block = 0;
+  if (size_class < static_cast<std::size_t>(num_size_classes))
+  {
+    conditionally_enabled_mutex::scoped_lock lock(mutex_);
+
+    if (void* free_block = free_blocks_[size_class])
+    {
+      free_blocks_[size_class] = *static_cast<void**>(free_block);
+      block = static_cast<unsigned char*>(free_block);
+    }
+    else
+    {
+      if (static_cast<std::size_t>(chunk_end_ - chunk_begin_) < block_size)
+      {
+        // Start a new chunk. Any space left in the previous chunk is unused
+        // until the arena is destroyed.
+        std::size_t chunk_size = header_size + block_size;
+        if (chunk_size < chunk_size_)
+          chunk_size = chunk_size_;
+        void* chunk = aligned_new(ASIO_DEFAULT_ALIGN, chunk_size);
+        *static_cast<void**>(chunk) = chunks_;
+        chunks_ = chunk;
+        capacity_ += chunk_size;
+        chunk_begin_ = static_cast<unsigned char*>(chunk) + header_size;
+        chunk_end_ = static_cast<unsigned char*>(chunk) + chunk_size;
+      }
+
+      block = chunk_begin_;
+      chunk_begin_ += block_size;
+    }
+  }
+  else
+  {
+    block = static_cast<unsigned char*>(
+        aligned_new(ASIO_DEFAULT_ALIGN, block_size));
+  }
+
+  header* h = reinterpret_cast<header*>(block);
+  h->arena_ = this;
+  h->size_class_ = size_class;
+  add_ref();
+  return block + header_size;
+}
+
+void arena_impl::deallocate(void* pointer)
+{
+  unsigned char* block = static_cast<unsigned char*>(pointer) - header_size;
+  header* h = reinterpret_cast<header*>(block);
+  arena_impl* a = h->arena_;
+  std::size_t size_class = h->size_class_;
+
+  if (size_class < static_cast<std::size_t>(num_size_classes))
+  {
+    conditionally_enabled_mutex::scoped_lock lock(a->mutex_);
+    *reinterpret_cast<void**>(block) = a->free_blocks_[size_class];
+    a->free_blocks_[size_class] = block;
+  }
+  else
+  {
+    aligned_delete(block);
+  }
+
+  a->release();
+}
+
+std::size_t arena_impl::capacity() const
+{
+  conditionally_enabled_mutex::scoped_lock lock(mutex_);
+  return capacity_;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_ARENA_IMPL_IPP
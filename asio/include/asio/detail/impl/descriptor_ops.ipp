@@ -512,6 +512,42 @@ bool non_blocking_write1(int d, const void* data, std::size_t size,
   }
 }
 
+#if defined(ASIO_HAS_SPLICE)
+
+bool non_blocking_splice(int from, int to, std::size_t size,
+    asio::error_code& ec, std::size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Move some data.
+    signed_size_type bytes = ::splice(from, 0, to, 0,
+        size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SPLICE)
+
 #if defined(ASIO_HAS_FILE)
 
 std::size_t sync_read_at(int d, state_type state, uint64_t offset,
@@ -0,0 +1,119 @@
+//
+// detail/impl/double_mapped_memory.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_DOUBLE_MAPPED_MEMORY_IPP
+#define ASIO_DETAIL_IMPL_DOUBLE_MAPPED_MEMORY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MEMFD)
+# include <cerrno>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_MEMFD)
+
+#include "asio/detail/double_mapped_memory.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+std::size_t double_mapped_memory::granularity()
+{
+#if defined(ASIO_HAS_MEMFD)
+  static const long page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size > 0 ? static_cast<std::size_t>(page_size) : 4096;
+#else // defined(ASIO_HAS_MEMFD)
+  return 1;
+#endif // defined(ASIO_HAS_MEMFD)
+}
+
+void* double_mapped_memory::map(std::size_t size, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MEMFD)
+  if (size == 0 || size % granularity() != 0
+      || size > static_cast<std::size_t>(-1) / 2)
+  {
+    ec = asio::error::invalid_argument;
+    return 0;
+  }
+
+  int fd = ::memfd_create("asio.ring_buffer", MFD_CLOEXEC);
+  if (fd == -1)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return 0;
+  }
+
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    ::close(fd);
+    return 0;
+  }
+
+  // Reserve enough address space for both mappings, then replace each half
+  // with a shared mapping of the same file.
+  void* reserved = ::mmap(0, size * 2, PROT_NONE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reserved == MAP_FAILED)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    ::close(fd);
+    return 0;
+  }
+
+  char* p = static_cast<char*>(reserved);
+  if (::mmap(p, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+      || ::mmap(p + size, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    ::munmap(reserved, size * 2);
+    ::close(fd);
+    return 0;
+  }
+
+  // The mappings keep the file alive.
+  ::close(fd);
+
+  ec = asio::error_code();
+  return p;
+#else // defined(ASIO_HAS_MEMFD)
+  (void)size;
+  ec = asio::error::operation_not_supported;
+  return 0;
+#endif // defined(ASIO_HAS_MEMFD)
+}
+
+void double_mapped_memory::unmap(void* p, std::size_t size)
+{
+#if defined(ASIO_HAS_MEMFD)
+  if (p)
+    ::munmap(p, size * 2);
+#else // defined(ASIO_HAS_MEMFD)
+  (void)p;
+  (void)size;
+#endif // defined(ASIO_HAS_MEMFD)
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_DOUBLE_MAPPED_MEMORY_IPP
@@ -165,6 +165,9 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->shutdown_ = false;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    descriptor_data->zero_copy_counter_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -269,6 +269,69 @@ bool non_blocking_accept(socket_type s,
   }
 }
 
+bool non_blocking_accept_batch(socket_type s,
+    state_type state, bool non_blocking, socket_type* new_sockets,
+    std::size_t max_sockets, asio::error_code& ec,
+    std::size_t& sockets_accepted)
+{
+  sockets_accepted = 0;
+  while (sockets_accepted < max_sockets)
+  {
+    // Accept the next waiting connection.
+#if defined(ASIO_HAS_ACCEPT4)
+    socket_type new_socket = ::accept4(s, 0, 0,
+        SOCK_CLOEXEC | (non_blocking ? SOCK_NONBLOCK : 0));
+    get_last_error(ec, new_socket == invalid_socket);
+#else // defined(ASIO_HAS_ACCEPT4)
+    (void)non_blocking;
+    socket_type new_socket = socket_ops::accept(s, 0, 0, ec);
+#endif // defined(ASIO_HAS_ACCEPT4)
+
+    // Check if operation succeeded.
+    if (new_socket != invalid_socket)
+    {
+      new_sockets[sockets_accepted++] = new_socket;
+      continue;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // An aborted connection is skipped, unless it would be the only result
+    // and the caller has asked to see it.
+    if (ec == asio::error::connection_aborted
+#if defined(EPROTO)
+        || ec.value() == EPROTO
+#endif // defined(EPROTO)
+        )
+    {
+      if (sockets_accepted == 0 && (state & enable_connection_aborted))
+        return true;
+      continue;
+    }
+
+    // No more connections are waiting.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      break;
+
+    // Any other error is reported if no connections have been accepted.
+    // Otherwise the error is discarded so that the accepted connections are
+    // delivered, and it will be reported by the next accept if it persists.
+    if (sockets_accepted == 0)
+      return true;
+    break;
+  }
+
+  // Check if we need to run the operation again.
+  if (sockets_accepted == 0)
+    return false;
+
+  asio::error::clear(ec);
+  return true;
+}
+
 #endif // defined(ASIO_HAS_IOCP)
 
 template <typename SockLenType>
@@ -1365,6 +1428,211 @@ bool non_blocking_recvmsg(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+signed_size_type recvmsg(socket_type s, buf* bufs, size_t count,
+    int in_flags, int& out_flags, void* addr, std::size_t* addrlen,
+    void* control, std::size_t* controllen, asio::error_code& ec)
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  (void)control;
+  out_flags = 0;
+  *controllen = 0;
+  return socket_ops::recvfrom(s, bufs, count, in_flags, addr, addrlen, ec);
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = static_cast<int>(*addrlen);
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = control;
+  msg.msg_controllen = *controllen;
+  signed_size_type result = ::recvmsg(s, &msg, in_flags);
+  get_last_error(ec, result < 0);
+  *addrlen = msg.msg_namelen;
+  if (result >= 0)
+  {
+    out_flags = msg.msg_flags;
+    *controllen = msg.msg_controllen;
+  }
+  else
+  {
+    out_flags = 0;
+    *controllen = 0;
+  }
+  return result;
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+}
+
+size_t sync_recvmsg(socket_type s, state_type state,
+    buf* bufs, size_t count, int in_flags, int& out_flags, void* addr,
+    std::size_t* addrlen, void* control, std::size_t* controllen,
+    asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some data.
+  std::size_t max_controllen = *controllen;
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    *controllen = max_controllen;
+    signed_size_type bytes = socket_ops::recvmsg(s, bufs, count,
+        in_flags, out_flags, addr, addrlen, control, controllen, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+#if !defined(ASIO_HAS_IOCP)
+
+bool non_blocking_recvmsg(socket_type s,
+    buf* bufs, size_t count, int in_flags, int& out_flags, void* addr,
+    std::size_t* addrlen, void* control, std::size_t* controllen,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  std::size_t max_controllen = *controllen;
+  for (;;)
+  {
+    // Read some data.
+    *controllen = max_controllen;
+    signed_size_type bytes = socket_ops::recvmsg(s, bufs, count,
+        in_flags, out_flags, addr, addrlen, control, controllen, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // !defined(ASIO_HAS_IOCP)
+
+size_t gro_segment_size(const void* control, std::size_t controllen)
+{
+#if defined(ASIO_HAS_UDP_GRO)
+  msghdr msg = msghdr();
+  msg.msg_control = const_cast<void*>(control);
+  msg.msg_controllen = controllen;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+  {
+    if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_UDP)
+        && cmsg->cmsg_type == ASIO_OS_DEF(UDP_GRO))
+    {
+      int size = 0;
+      std::memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+      return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+  }
+  return 0;
+#else // defined(ASIO_HAS_UDP_GRO)
+  (void)control;
+  (void)controllen;
+  return 0;
+#endif // defined(ASIO_HAS_UDP_GRO)
+}
+
+signed_size_type recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MMSG)
+  signed_size_type result = ::recvmmsg(s, msgs,
+      static_cast<unsigned int>(count), flags, 0);
+  get_last_error(ec, result < 0);
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Receive one message per call, stopping at the first failure. As with
+  // recvmmsg, the failure is reported only if no message was received.
+  size_t n = 0;
+  for (; n < count; ++n)
+  {
+    msghdr_type& msg = msgs[n].msg_hdr;
+# if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    std::size_t addrlen = msg.msg_namelen;
+    signed_size_type bytes = socket_ops::recvfrom(s, msg.msg_iov,
+        msg.msg_iovlen, flags, msg.msg_name, &addrlen, ec);
+    msg.msg_namelen = static_cast<int>(addrlen);
+    msg.msg_flags = 0;
+# else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    signed_size_type bytes = ::recvmsg(s, &msg, flags);
+    get_last_error(ec, bytes < 0);
+# endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    if (bytes < 0)
+      break;
+    msgs[n].msg_len = static_cast<unsigned int>(bytes);
+  }
+  if (n == 0 && count > 0)
+    return socket_error_retval;
+  asio::error::clear(ec);
+  return static_cast<signed_size_type>(n);
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+#if !defined(ASIO_HAS_IOCP)
+
+bool non_blocking_recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages)
+{
+  for (;;)
+  {
+    // Read some messages.
+    signed_size_type result = socket_ops::recvmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      messages = result;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    messages = 0;
+    return true;
+  }
+}
+
+#endif // !defined(ASIO_HAS_IOCP)
+
 signed_size_type send(socket_type s, const buf* bufs, size_t count,
     int flags, asio::error_code& ec)
 {
@@ -1455,10 +1723,12 @@ size_t sync_send(socket_type s, state_type state, const buf* bufs,
     if (bytes >= 0)
       return bytes;
 
-    // Operation failed.
+    // Operation failed. A TCP Fast Open connection reports in_progress when
+    // the data could not be sent in the SYN.
     if ((state & user_set_non_blocking)
         || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+          && ec != asio::error::try_again
+          && ec != asio::error::in_progress))
       return 0;
 
     // Wait for socket to become ready.
@@ -1493,10 +1763,12 @@ size_t sync_send1(socket_type s, state_type state, const void* data,
     if (bytes >= 0)
       return bytes;
 
-    // Operation failed.
+    // Operation failed. A TCP Fast Open connection reports in_progress when
+    // the data could not be sent in the SYN.
     if ((state & user_set_non_blocking)
         || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+          && ec != asio::error::try_again
+          && ec != asio::error::in_progress))
       return 0;
 
     // Wait for socket to become ready.
@@ -1547,9 +1819,11 @@ bool non_blocking_send(socket_type s,
     if (ec == asio::error::interrupted)
       continue;
 
-    // Check if we need to run the operation again.
+    // Check if we need to run the operation again. A TCP Fast Open
+    // connection reports in_progress until its handshake completes.
     if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+        || ec == asio::error::try_again
+        || ec == asio::error::in_progress)
       return false;
 
     // Operation failed.
@@ -1574,6 +1848,115 @@ bool non_blocking_send1(socket_type s,
       return true;
     }
 
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again. A TCP Fast Open
+    // connection reports in_progress until its handshake completes.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again
+        || ec == asio::error::in_progress)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_IOCP)
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+bool non_blocking_zero_copy_complete(socket_type s,
+    uint32_t id, asio::error_code& ec)
+{
+  // An error reported by an earlier call is kept until the send completes.
+  asio::error_code reported_ec = ec;
+  bool complete = false;
+  for (;;)
+  {
+    // Read a notification from the error queue.
+    control_storage control;
+    msghdr msg = msghdr();
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control);
+    signed_size_type result = ::recvmsg(s, &msg, MSG_ERRQUEUE);
+    get_last_error(ec, result < 0);
+
+    if (result < 0)
+    {
+      // Retry operation if interrupted by signal.
+      if (ec == asio::error::interrupted)
+        continue;
+
+      // The error queue is empty.
+      if (ec == asio::error::would_block
+          || ec == asio::error::try_again)
+      {
+        ec = reported_ec;
+        return complete;
+      }
+
+      // Operation failed.
+      return true;
+    }
+
+    // Each notification reports the range of ids of the completed sends. Any
+    // other entry on the error queue reports a real error, such as one
+    // received in an ICMP message. The error is reported once the send has
+    // completed, as the kernel may still be using the buffers until then.
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        sock_extended_err err;
+        std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if (err.ee_origin == SO_EE_ORIGIN_ZEROCOPY && err.ee_errno == 0)
+        {
+          if (static_cast<int32_t>(err.ee_data - id) >= 0)
+            complete = true;
+        }
+        else if (err.ee_errno != 0)
+        {
+          reported_ec = asio::error_code(err.ee_errno,
+              asio::error::get_system_category());
+        }
+      }
+    }
+  }
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+bool non_blocking_sendfile(socket_type s, int d, uint64_t* offset,
+    size_t size, asio::error_code& ec, size_t& bytes_transferred)
+{
+  // The kernel transfers at most this many bytes in a single call.
+  if (size > 0x7ffff000)
+    size = 0x7ffff000;
+
+  for (;;)
+  {
+    // Send some data.
+    off_t off = offset ? static_cast<off_t>(*offset) : 0;
+    signed_size_type bytes = ::sendfile(s, d, offset ? &off : 0, size);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      if (offset)
+        *offset = static_cast<uint64_t>(off);
+      bytes_transferred = bytes;
+      return true;
+    }
+
     // Retry operation if interrupted by signal.
     if (ec == asio::error::interrupted)
       continue;
@@ -1589,7 +1972,7 @@ bool non_blocking_send1(socket_type s,
   }
 }
 
-#endif // defined(ASIO_HAS_IOCP)
+#endif // defined(ASIO_HAS_SENDFILE)
 
 signed_size_type sendto(socket_type s, const buf* bufs,
     size_t count, int flags, const void* addr,
@@ -1805,6 +2188,79 @@ bool non_blocking_sendto1(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+signed_size_type sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# if defined(ASIO_HAS_MSG_NOSIGNAL)
+  flags |= MSG_NOSIGNAL;
+# endif // defined(ASIO_HAS_MSG_NOSIGNAL)
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#if defined(ASIO_HAS_MMSG)
+  signed_size_type result = ::sendmmsg(s, msgs,
+      static_cast<unsigned int>(count), flags);
+  get_last_error(ec, result < 0);
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Send one message per call, stopping at the first failure. As with
+  // sendmmsg, the failure is reported only if no message was sent.
+  size_t n = 0;
+  for (; n < count; ++n)
+  {
+    msghdr_type& msg = msgs[n].msg_hdr;
+# if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    signed_size_type bytes = socket_ops::sendto(s, msg.msg_iov,
+        msg.msg_iovlen, flags, msg.msg_name, msg.msg_namelen, ec);
+# else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    signed_size_type bytes = ::sendmsg(s, &msg, flags);
+    get_last_error(ec, bytes < 0);
+# endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    if (bytes < 0)
+      break;
+    msgs[n].msg_len = static_cast<unsigned int>(bytes);
+  }
+  if (n == 0 && count > 0)
+    return socket_error_retval;
+  asio::error::clear(ec);
+  return static_cast<signed_size_type>(n);
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+#if !defined(ASIO_HAS_IOCP)
+
+bool non_blocking_sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages)
+{
+  for (;;)
+  {
+    // Write some messages.
+    signed_size_type result = socket_ops::sendmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      messages = result;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    messages = 0;
+    return true;
+  }
+}
+
+#endif // !defined(ASIO_HAS_IOCP)
+
 socket_type socket(int af, int type, int protocol,
     asio::error_code& ec)
 {
@@ -1929,6 +2385,18 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
           SOL_SOCKET, SO_REUSEPORT, optval, optlen);
     }
 #endif
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // Zero-copy sends must also be requested on each send operation.
+    if (level == SOL_SOCKET && optname == SO_ZEROCOPY
+        && optlen == sizeof(int))
+    {
+      if (*static_cast<const int*>(optval))
+        state |= zero_copy;
+      else
+        state &= ~zero_copy;
+    }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   }
 
   return result;
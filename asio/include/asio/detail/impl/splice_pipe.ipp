@@ -0,0 +1,66 @@
+//
+// detail/impl/splice_pipe.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_SPLICE_PIPE_IPP
+#define ASIO_DETAIL_IMPL_SPLICE_PIPE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/splice_pipe.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+splice_pipe::splice_pipe()
+  : read_descriptor_(-1),
+    write_descriptor_(-1)
+{
+}
+
+splice_pipe::~splice_pipe()
+{
+  if (read_descriptor_ != -1)
+    ::close(read_descriptor_);
+  if (write_descriptor_ != -1)
+    ::close(write_descriptor_);
+}
+
+asio::error_code splice_pipe::open(asio::error_code& ec)
+{
+  int pipe_fds[2];
+  int result = ::pipe2(pipe_fds, O_NONBLOCK | O_CLOEXEC);
+  descriptor_ops::get_last_error(ec, result != 0);
+  if (result == 0)
+  {
+    read_descriptor_ = pipe_fds[0];
+    write_descriptor_ = pipe_fds[1];
+  }
+  return ec;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#endif // ASIO_DETAIL_IMPL_SPLICE_PIPE_IPP
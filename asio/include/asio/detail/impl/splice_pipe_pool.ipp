@@ -0,0 +1,83 @@
+//
+// detail/impl/splice_pipe_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_SPLICE_PIPE_POOL_IPP
+#define ASIO_DETAIL_IMPL_SPLICE_PIPE_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include "asio/detail/splice_pipe_pool.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+splice_pipe_pool::splice_pipe_pool(execution_context& context)
+  : execution_context_service_base<splice_pipe_pool>(context)
+{
+  // Reserve the space up front so that returning a pipe cannot throw.
+  unused_pipes_.reserve(max_unused_pipes);
+}
+
+void splice_pipe_pool::shutdown()
+{
+  mutex::scoped_lock lock(mutex_);
+  unused_pipes_.clear();
+}
+
+shared_ptr<splice_pipe> splice_pipe_pool::acquire(asio::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (!unused_pipes_.empty())
+  {
+    shared_ptr<splice_pipe> pipe = unused_pipes_.back();
+    unused_pipes_.pop_back();
+    asio::error::clear(ec);
+    return pipe;
+  }
+  lock.unlock();
+
+  shared_ptr<splice_pipe> pipe = asio::detail::make_shared<splice_pipe>();
+  if (pipe->open(ec))
+    pipe.reset();
+  return pipe;
+}
+
+void splice_pipe_pool::release(shared_ptr<splice_pipe>& pipe)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (unused_pipes_.size() < max_unused_pipes)
+    unused_pipes_.push_back(pipe);
+  lock.unlock();
+
+  pipe.reset();
+}
+
+std::size_t splice_pipe_pool::unused_pipes()
+{
+  mutex::scoped_lock lock(mutex_);
+  return unused_pipes_.size();
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#endif // ASIO_DETAIL_IMPL_SPLICE_PIPE_POOL_IPP
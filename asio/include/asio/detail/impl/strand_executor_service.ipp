@@ -26,7 +26,9 @@ namespace detail {
 strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
+#if !defined(ASIO_HAS_STD_ATOMIC)
     salt_(0),
+#endif // !defined(ASIO_HAS_STD_ATOMIC)
     impl_list_(0)
 {
 }
@@ -40,11 +42,30 @@ void strand_executor_service::shutdown()
   strand_impl* impl = impl_list_;
   while (impl)
   {
+#if defined(ASIO_HAS_STD_ATOMIC)
+    std::size_t state = impl->state_.load(std::memory_order_relaxed);
+    while (!impl->state_.compare_exchange_weak(state,
+          (state & locked_flag) | shutdown_flag, std::memory_order_acquire,
+          std::memory_order_relaxed))
+    {
+    }
+    scheduler_operation* o =
+      reinterpret_cast<scheduler_operation*>(state & ~state_flags);
+    while (o)
+    {
+      scheduler_operation* next = op_queue_access::next(o);
+      ops.push(o);
+      o = next;
+    }
+    ops.push(impl->backlog_queue_);
+    ops.push(impl->ready_queue_);
+#else // defined(ASIO_HAS_STD_ATOMIC)
     impl->mutex_->lock();
     impl->shutdown_ = true;
     ops.push(impl->waiting_queue_);
     ops.push(impl->ready_queue_);
     impl->mutex_->unlock();
+#endif // defined(ASIO_HAS_STD_ATOMIC)
     impl = impl->next_;
   }
 }
@@ -53,11 +74,22 @@ strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
   implementation_type new_impl(new strand_impl);
+#if defined(ASIO_HAS_STD_ATOMIC)
+  new_impl->state_.store(0, std::memory_order_relaxed);
+  new_impl->handler_budget_.store(
+      ASIO_STRAND_HANDLER_BUDGET, std::memory_order_relaxed);
+  new_impl->time_budget_usec_.store(
+      ASIO_STRAND_TIME_BUDGET_USEC, std::memory_order_relaxed);
+#else // defined(ASIO_HAS_STD_ATOMIC)
   new_impl->locked_ = false;
   new_impl->shutdown_ = false;
+  new_impl->handler_budget_ = ASIO_STRAND_HANDLER_BUDGET;
+  new_impl->time_budget_usec_ = ASIO_STRAND_TIME_BUDGET_USEC;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
+#if !defined(ASIO_HAS_STD_ATOMIC)
   // Select a mutex from the pool of shared mutexes.
   std::size_t salt = salt_++;
   std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
@@ -67,6 +99,7 @@ strand_executor_service::create_implementation()
   if (!mutexes_[mutex_index].get())
     mutexes_[mutex_index].reset(new mutex);
   new_impl->mutex_ = mutexes_[mutex_index].get();
+#endif // !defined(ASIO_HAS_STD_ATOMIC)
 
   // Insert implementation into linked list of all implementations.
   new_impl->next_ = impl_list_;
@@ -95,6 +128,37 @@ strand_executor_service::strand_impl::~strand_impl()
 bool strand_executor_service::enqueue(const implementation_type& impl,
     scheduler_operation* op)
 {
+#if defined(ASIO_HAS_STD_ATOMIC)
+  std::size_t state = impl->state_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    if (state & shutdown_flag)
+    {
+      op->destroy();
+      return false;
+    }
+    else if (state & locked_flag)
+    {
+      // Some other function already holds the strand lock. Enqueue for later.
+      scheduler_operation* next =
+        reinterpret_cast<scheduler_operation*>(state & ~state_flags);
+      op_queue_access::next(op, next);
+      if (impl->state_.compare_exchange_weak(state,
+            reinterpret_cast<std::size_t>(op) | locked_flag,
+            std::memory_order_release, std::memory_order_relaxed))
+        return false;
+    }
+    else if (impl->state_.compare_exchange_weak(state,
+          static_cast<std::size_t>(locked_flag),
+          std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      // The function is acquiring the strand lock and so is responsible for
+      // scheduling the strand.
+      impl->ready_queue_.push(op);
+      return true;
+    }
+  }
+#else // defined(ASIO_HAS_STD_ATOMIC)
   impl->mutex_->lock();
   if (impl->shutdown_)
   {
@@ -118,6 +182,7 @@ bool strand_executor_service::enqueue(const implementation_type& impl,
     impl->ready_queue_.push(op);
     return true;
   }
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 }
 
 bool strand_executor_service::running_in_this_thread(
@@ -126,13 +191,99 @@ bool strand_executor_service::running_in_this_thread(
   return !!call_stack<strand_impl>::contains(impl.get());
 }
 
+void strand_executor_service::set_budget(const implementation_type& impl,
+    std::size_t max_handlers, long max_usec)
+{
+#if defined(ASIO_HAS_STD_ATOMIC)
+  impl->handler_budget_.store(max_handlers, std::memory_order_relaxed);
+  impl->time_budget_usec_.store(max_usec, std::memory_order_relaxed);
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  impl->mutex_->lock();
+  impl->handler_budget_ = max_handlers;
+  impl->time_budget_usec_ = max_usec;
+  impl->mutex_->unlock();
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+}
+
 bool strand_executor_service::push_waiting_to_ready(implementation_type& impl)
 {
+#if defined(ASIO_HAS_STD_ATOMIC)
+  // Take all waiting handlers, releasing the strand lock only if there are
+  // no handlers left to run.
+  std::size_t state = impl->state_.load(std::memory_order_relaxed);
+  scheduler_operation* waiting = 0;
+  bool more_handlers = false;
+  do
+  {
+    waiting = reinterpret_cast<scheduler_operation*>(state & ~state_flags);
+    more_handlers = waiting || !impl->ready_queue_.empty()
+      || !impl->backlog_queue_.empty();
+  } while (!impl->state_.compare_exchange_weak(state,
+        (state & shutdown_flag) | (more_handlers ? locked_flag : 0),
+        std::memory_order_acq_rel, std::memory_order_relaxed));
+
+  // The waiting handlers are stored most recent first, so reverse them to
+  // preserve the order in which they were added.
+  scheduler_operation* reversed = 0;
+  while (waiting)
+  {
+    scheduler_operation* next = op_queue_access::next(waiting);
+    op_queue_access::next(waiting, reversed);
+    reversed = waiting;
+    waiting = next;
+  }
+  while (reversed)
+  {
+    scheduler_operation* next = op_queue_access::next(reversed);
+    impl->backlog_queue_.push(reversed);
+    reversed = next;
+  }
+
+  // Hand over as many handlers as fit in the budget. Handlers left in the
+  // ready queue by an exhausted time budget are run first.
+  if (impl->ready_queue_.empty())
+  {
+    std::size_t budget =
+      impl->handler_budget_.load(std::memory_order_relaxed);
+    if (budget == 0)
+      impl->ready_queue_.push(impl->backlog_queue_);
+    else
+    {
+      while (budget-- > 0 && !impl->backlog_queue_.empty())
+      {
+        scheduler_operation* o = impl->backlog_queue_.front();
+        impl->backlog_queue_.pop();
+        impl->ready_queue_.push(o);
+      }
+    }
+  }
+
+  return more_handlers;
+#else // defined(ASIO_HAS_STD_ATOMIC)
   impl->mutex_->lock();
-  impl->ready_queue_.push(impl->waiting_queue_);
+
+  // Hand over as many handlers as fit in the budget. Handlers left in the
+  // ready queue by an exhausted time budget are run first.
+  if (impl->ready_queue_.empty())
+  {
+    std::size_t budget = impl->handler_budget_;
+    if (budget == 0)
+      impl->ready_queue_.push(impl->waiting_queue_);
+    else
+    {
+      while (budget-- > 0 && !impl->waiting_queue_.empty())
+      {
+        scheduler_operation* o = impl->waiting_queue_.front();
+        impl->waiting_queue_.pop();
+        impl->ready_queue_.push(o);
+      }
+    }
+  }
+
   bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
   impl->mutex_->unlock();
   return more_handlers;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 }
 
 void strand_executor_service::run_ready_handlers(implementation_type& impl)
@@ -140,13 +291,35 @@ void strand_executor_service::run_ready_handlers(implementation_type& impl)
   // Indicate that this strand is executing on the current thread.
   call_stack<strand_impl>::context ctx(impl.get());
 
-  // Run all ready handlers. No lock is required since the ready queue is
-  // accessed only within the strand.
+#if defined(ASIO_HAS_CHRONO)
+# if defined(ASIO_HAS_STD_ATOMIC)
+  long time_budget = impl->time_budget_usec_.load(std::memory_order_relaxed);
+# else // defined(ASIO_HAS_STD_ATOMIC)
+  impl->mutex_->lock();
+  long time_budget = impl->time_budget_usec_;
+  impl->mutex_->unlock();
+# endif // defined(ASIO_HAS_STD_ATOMIC)
+  chrono::steady_clock::time_point deadline;
+  if (time_budget > 0)
+    deadline = chrono::steady_clock::now()
+      + chrono::microseconds(time_budget);
+#endif // defined(ASIO_HAS_CHRONO)
+
+  // Run the ready handlers. No lock is required since the ready queue is
+  // accessed only within the strand. The handler budget has already limited
+  // the number of handlers in the queue.
   asio::error_code ec;
   while (scheduler_operation* o = impl->ready_queue_.front())
   {
     impl->ready_queue_.pop();
     o->complete(impl.get(), ec, 0);
+
+    // Leave the remaining handlers in the ready queue once the time budget is
+    // used up. The strand is still locked, so it will be rescheduled.
+#if defined(ASIO_HAS_CHRONO)
+    if (time_budget > 0 && chrono::steady_clock::now() >= deadline)
+      break;
+#endif // defined(ASIO_HAS_CHRONO)
   }
 }
 
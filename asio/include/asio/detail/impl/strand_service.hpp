@@ -29,6 +29,12 @@ namespace detail {
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
     locked_(false)
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+    , ref_count_(0),
+    service_(0),
+    next_impl_(0),
+    prev_impl_(0)
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 {
 }
 
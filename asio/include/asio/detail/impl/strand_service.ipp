@@ -31,12 +31,7 @@ struct strand_service::on_do_complete_exit
 
   ~on_do_complete_exit()
   {
-    impl_->mutex_.lock();
-    impl_->ready_queue_.push(impl_->waiting_queue_);
-    bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
+    if (push_waiting_to_ready(impl_))
       owner_->post_immediate_completion(impl_, true);
   }
 };
@@ -46,9 +41,38 @@ strand_service::strand_service(asio::io_context& io_context)
     io_context_(io_context),
     io_context_impl_(asio::use_service<io_context_impl>(io_context)),
     mutex_(),
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+    live_implementations_(0),
+    free_implementations_(0),
+    num_free_implementations_(0),
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
     salt_(0)
 {
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  owner_mutex().init();
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+}
+
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+strand_service::~strand_service()
+{
+  // Any implementations still in use are deleted when released. Holding both
+  // locks ensures that no release is using the service when it is detached.
+  {
+    asio::detail::static_mutex::scoped_lock owner_lock(owner_mutex());
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    for (strand_impl* impl = live_implementations_;
+        impl; impl = impl->next_impl_)
+      impl->service_ = 0;
+  }
+
+  while (strand_impl* impl = free_implementations_)
+  {
+    free_implementations_ = impl->next_impl_;
+    delete impl;
+  }
 }
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 
 void strand_service::shutdown()
 {
@@ -56,6 +80,13 @@ void strand_service::shutdown()
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  for (strand_impl* impl = live_implementations_; impl; impl = impl->next_impl_)
+  {
+    ops.push(impl->waiting_queue_);
+    ops.push(impl->ready_queue_);
+  }
+#else // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
   for (std::size_t i = 0; i < num_implementations; ++i)
   {
     if (strand_impl* impl = implementations_[i].get())
@@ -64,12 +95,41 @@ void strand_service::shutdown()
       ops.push(impl->ready_queue_);
     }
   }
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 }
 
 void strand_service::construct(strand_service::implementation_type& impl)
 {
   asio::detail::mutex::scoped_lock lock(mutex_);
 
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  // Reuse an unused implementation if one is available.
+  strand_impl* new_impl = free_implementations_;
+  if (new_impl)
+  {
+    free_implementations_ = new_impl->next_impl_;
+    --num_free_implementations_;
+  }
+  else
+    new_impl = new strand_impl;
+
+  // Insert implementation into linked list of live implementations.
+  new_impl->service_ = this;
+  new_impl->next_impl_ = live_implementations_;
+  new_impl->prev_impl_ = 0;
+  if (live_implementations_)
+    live_implementations_->prev_impl_ = new_impl;
+  live_implementations_ = new_impl;
+
+  ref_count_up(new_impl->ref_count_);
+  strand_impl* old_impl = impl.impl_;
+  impl.impl_ = new_impl;
+
+  lock.unlock();
+  if (old_impl)
+    release(old_impl);
+#else // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+
   std::size_t salt = salt_++;
 #if defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
   std::size_t index = salt;
@@ -83,7 +143,59 @@ void strand_service::construct(strand_service::implementation_type& impl)
   if (!implementations_[index].get())
     implementations_[index].reset(new strand_impl);
   impl = implementations_[index].get();
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+}
+
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+void strand_service::release(strand_impl* impl)
+{
+  if (!ref_count_down(impl->ref_count_))
+    return;
+
+  // The service cannot be destroyed while the owner mutex is held, and once
+  // the service's own mutex is acquired it cannot be destroyed until that
+  // mutex is released.
+  asio::detail::static_mutex::scoped_lock owner_lock(owner_mutex());
+  strand_service* service = impl->service_;
+  if (!service)
+  {
+    owner_lock.unlock();
+    delete impl;
+    return;
+  }
+
+  asio::detail::mutex::scoped_lock lock(service->mutex_);
+  owner_lock.unlock();
+
+  // Remove implementation from linked list of live implementations.
+  if (service->live_implementations_ == impl)
+    service->live_implementations_ = impl->next_impl_;
+  if (impl->prev_impl_)
+    impl->prev_impl_->next_impl_ = impl->next_impl_;
+  if (impl->next_impl_)
+    impl->next_impl_->prev_impl_ = impl->prev_impl_;
+  impl->prev_impl_ = 0;
+
+  if (service->num_free_implementations_ < num_implementations)
+  {
+    // Keep the implementation for reuse by a new strand.
+    impl->next_impl_ = service->free_implementations_;
+    service->free_implementations_ = impl;
+    ++service->num_free_implementations_;
+  }
+  else
+  {
+    lock.unlock();
+    delete impl;
+  }
+}
+
+asio::detail::static_mutex& strand_service::owner_mutex()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  return mutex;
 }
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 
 bool strand_service::running_in_this_thread(
     const implementation_type& impl) const
@@ -98,12 +210,7 @@ struct strand_service::on_dispatch_exit
 
   ~on_dispatch_exit()
   {
-    impl_->mutex_.lock();
-    impl_->ready_queue_.push(impl_->waiting_queue_);
-    bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
+    if (push_waiting_to_ready(impl_))
       io_context_impl_->post_immediate_completion(impl_, false);
   }
 };
@@ -119,6 +226,9 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
     // Immediate invocation is allowed.
     impl->locked_ = true;
     impl->mutex_.unlock();
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+    add_ref(impl);
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 
     // Indicate that this strand is executing on the current thread.
     call_stack<strand_impl>::context ctx(impl);
@@ -143,6 +253,9 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
     // scheduling the strand.
     impl->locked_ = true;
     impl->mutex_.unlock();
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+    add_ref(impl);
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
     impl->ready_queue_.push(op);
     io_context_impl_.post_immediate_completion(impl, false);
   }
@@ -164,6 +277,9 @@ void strand_service::do_post(implementation_type& impl,
     // scheduling the strand.
     impl->locked_ = true;
     impl->mutex_.unlock();
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+    add_ref(impl);
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
     impl->ready_queue_.push(op);
     io_context_impl_.post_immediate_completion(impl, is_continuation);
   }
@@ -192,6 +308,31 @@ void strand_service::do_complete(void* owner, operation* base,
       o->complete(owner, ec, 0);
     }
   }
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  else
+  {
+    // The scheduled strand is being destroyed, so give up the strand lock.
+    strand_impl* impl = static_cast<strand_impl*>(base);
+    impl->locked_ = false;
+    release(impl);
+  }
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+}
+
+bool strand_service::push_waiting_to_ready(strand_impl* impl)
+{
+  impl->mutex_.lock();
+  impl->ready_queue_.push(impl->waiting_queue_);
+  bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
+  impl->mutex_.unlock();
+
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  // The strand lock holds a reference to the implementation.
+  if (!more_handlers)
+    release(impl);
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+
+  return more_handlers;
 }
 
 } // namespace detail
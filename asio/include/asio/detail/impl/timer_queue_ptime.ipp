@@ -28,6 +28,7 @@ namespace detail {
 
 timer_queue<time_traits<boost::posix_time::ptime> >::timer_queue()
 {
+  forward_changes(impl_, *this);
 }
 
 timer_queue<time_traits<boost::posix_time::ptime> >::~timer_queue()
@@ -18,13 +18,21 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/timer_queue_set.hpp"
 
+#if defined(ASIO_HAS_CHRONO)
+# include "asio/detail/chrono.hpp"
+#endif // defined(ASIO_HAS_CHRONO)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 namespace detail {
 
 timer_queue_set::timer_queue_set()
-  : first_(0)
+  : first_(0),
+    unsteady_count_(0),
+    first_changed_(0),
+    rescan_(true),
+    earliest_(0)
 {
 }
 
@@ -32,10 +40,30 @@ void timer_queue_set::insert(timer_queue_base* q)
 {
   q->next_ = first_;
   first_ = q;
+
+  if (!q->steady_)
+    ++unsteady_count_;
+
+  q->changed_list_ = &first_changed_;
+  q->earliest_changed();
 }
 
 void timer_queue_set::erase(timer_queue_base* q)
 {
+  if (q->changed_)
+  {
+    timer_queue_base** p = &first_changed_;
+    while (*p != q)
+      p = &(*p)->next_changed_;
+    *p = q->next_changed_;
+    q->next_changed_ = 0;
+    q->changed_ = false;
+  }
+  if (q->changed_list_ && !q->steady_)
+    --unsteady_count_;
+  q->changed_list_ = 0;
+  rescan_ = true;
+
   if (first_)
   {
     if (q == first_)
@@ -65,6 +93,118 @@ bool timer_queue_set::all_empty() const
   return true;
 }
 
+#if defined(ASIO_HAS_CHRONO)
+
+long timer_queue_set::wait_duration_msec(long max_duration) const
+{
+  update_earliest();
+  if (earliest_ == no_deadline())
+    return max_duration;
+
+  int64_t usec = earliest_ - now_usec();
+  if (usec <= 0)
+    return 0;
+  int64_t msec = usec / 1000;
+  if (msec == 0)
+    return 1;
+  if (msec > max_duration)
+    return max_duration;
+  return static_cast<long>(msec);
+}
+
+long timer_queue_set::wait_duration_usec(long max_duration) const
+{
+  update_earliest();
+  if (earliest_ == no_deadline())
+    return max_duration;
+
+  int64_t usec = earliest_ - now_usec();
+  if (usec <= 0)
+    return 0;
+  if (usec > max_duration)
+    return max_duration;
+  return static_cast<long>(usec);
+}
+
+void timer_queue_set::get_ready_timers(op_queue<operation>& ops)
+{
+  update_earliest();
+  if (earliest_ == no_deadline())
+    return;
+
+  int64_t now = now_usec();
+  if (now < earliest_)
+    return;
+
+  for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    if (p->deadline_ <= now)
+    {
+      p->get_ready_timers(ops);
+
+      // The cached deadline may have been capped, or the queue's clock may
+      // differ in rate from the steady clock, so recalculate it regardless.
+      p->earliest_changed();
+    }
+  }
+}
+
+void timer_queue_set::get_all_timers(op_queue<operation>& ops)
+{
+  for (timer_queue_base* p = first_; p; p = p->next_)
+    p->get_all_timers(ops);
+}
+
+void timer_queue_set::update_earliest() const
+{
+  // A clock that is not steady may be adjusted at any time, so the deadlines
+  // of such queues are recalculated on every call. An empty queue notifies a
+  // change when a timer is added, so it need not be recalculated.
+  if (unsteady_count_)
+    for (timer_queue_base* p = first_; p; p = p->next_)
+      if (!p->steady_ && !p->empty())
+        p->earliest_changed();
+
+  if (first_changed_)
+  {
+    int64_t now = now_usec();
+    while (timer_queue_base* q = first_changed_)
+    {
+      first_changed_ = q->next_changed_;
+      q->next_changed_ = 0;
+      q->changed_ = false;
+
+      int64_t old_deadline = q->deadline_;
+      q->deadline_ = q->empty() ? no_deadline()
+        : now + q->wait_duration_usec(max_cached_usec);
+
+      // All queues need to be consulted again only if the queue that held
+      // the earliest deadline now has a later one.
+      if (q->deadline_ < earliest_)
+        earliest_ = q->deadline_;
+      else if (q->deadline_ != old_deadline && old_deadline == earliest_)
+        rescan_ = true;
+    }
+  }
+
+  if (rescan_)
+  {
+    rescan_ = false;
+    earliest_ = no_deadline();
+    for (timer_queue_base* p = first_; p; p = p->next_)
+      if (p->deadline_ < earliest_)
+        earliest_ = p->deadline_;
+  }
+}
+
+int64_t timer_queue_set::now_usec()
+{
+  return chrono::duration_cast<chrono::microseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#else // defined(ASIO_HAS_CHRONO)
+
 long timer_queue_set::wait_duration_msec(long max_duration) const
 {
   long min_duration = max_duration;
@@ -93,6 +233,8 @@ void timer_queue_set::get_all_timers(op_queue<operation>& ops)
     p->get_all_timers(ops);
 }
 
+#endif // defined(ASIO_HAS_CHRONO)
+
 } // namespace detail
 } // namespace asio
 
@@ -0,0 +1,83 @@
+//
+// detail/impl/tsc_clock.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_TSC_CLOCK_IPP
+#define ASIO_DETAIL_IMPL_TSC_CLOCK_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_TSC_CLOCK)
+
+#include "asio/detail/tsc_clock.hpp"
+
+#if !defined(ASIO_MSVC)
+# include <cpuid.h>
+#endif // !defined(ASIO_MSVC)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+tsc_clock::calibration tsc_clock::calibrate() ASIO_NOEXCEPT
+{
+  calibration c = { false, 0, 0, 0 };
+
+  // The invariant TSC flag is bit 8 of EDX in extended leaf 0x80000007.
+  unsigned int regs[4] = { 0, 0, 0, 0 };
+#if defined(ASIO_MSVC)
+  int info[4] = { 0, 0, 0, 0 };
+  __cpuid(info, 0x80000000);
+  if (static_cast<unsigned int>(info[0]) >= 0x80000007)
+  {
+    __cpuid(info, 0x80000007);
+    regs[3] = static_cast<unsigned int>(info[3]);
+  }
+#else // defined(ASIO_MSVC)
+  if (__get_cpuid_max(0x80000000, 0) >= 0x80000007)
+    __get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif // defined(ASIO_MSVC)
+  if ((regs[3] & (1u << 8)) == 0)
+    return c;
+
+  // Measure the counter against steady_clock from the start of the program.
+  // Wait only if less than the minimum calibration interval has elapsed.
+  const sample& start = start_sample();
+  sample stop = take_sample();
+  while (stop.time - start.time
+      < chrono::microseconds(ASIO_TSC_CLOCK_CALIBRATION_USEC))
+    stop = take_sample();
+
+  rep elapsed_ns = chrono::duration_cast<duration>(
+      stop.time - start.time).count();
+  if (stop.ticks <= start.ticks || elapsed_ns <= 0)
+    return c;
+
+  c.invariant = true;
+  c.base_ticks = stop.ticks;
+  c.base_ns = chrono::duration_cast<duration>(
+      stop.time.time_since_epoch()).count();
+  c.scale = static_cast<uint64_t>(static_cast<double>(elapsed_ns)
+      * 4294967296.0 / static_cast<double>(stop.ticks - start.ticks));
+  return c;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_TSC_CLOCK)
+
+#endif // ASIO_DETAIL_IMPL_TSC_CLOCK_IPP
@@ -197,6 +197,7 @@ size_t win_iocp_io_context::run(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.attach_cache_control(recycling_cache_);
   thread_call_stack::context ctx(this, this_thread);
 
   size_t n = 0;
@@ -216,6 +217,7 @@ size_t win_iocp_io_context::run_one(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.attach_cache_control(recycling_cache_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(INFINITE, this_thread, ec);
@@ -231,6 +233,7 @@ size_t win_iocp_io_context::wait_one(long usec, asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.attach_cache_control(recycling_cache_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(usec < 0 ? INFINITE : ((usec - 1) / 1000 + 1), this_thread, ec);
@@ -246,6 +249,7 @@ size_t win_iocp_io_context::poll(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.attach_cache_control(recycling_cache_);
   thread_call_stack::context ctx(this, this_thread);
 
   size_t n = 0;
@@ -265,6 +269,7 @@ size_t win_iocp_io_context::poll_one(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.attach_cache_control(recycling_cache_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(0, this_thread, ec);
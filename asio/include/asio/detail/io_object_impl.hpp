@@ -17,6 +17,7 @@
 
 #include <new>
 #include "asio/detail/config.hpp"
+#include "asio/detail/arena_impl.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/execution/executor.hpp"
 #include "asio/execution/context.hpp"
@@ -46,7 +47,8 @@ public:
   explicit io_object_impl(int, const executor_type& ex)
     : service_(&asio::use_service<IoObjectService>(
           io_object_impl::get_context(ex))),
-      executor_(ex)
+      executor_(ex),
+      arena_(0)
   {
     service_->construct(implementation_);
   }
@@ -55,7 +57,8 @@ public:
   template <typename ExecutionContext>
   explicit io_object_impl(int, int, ExecutionContext& context)
     : service_(&asio::use_service<IoObjectService>(context)),
-      executor_(context.get_executor())
+      executor_(context.get_executor()),
+      arena_(0)
   {
     service_->construct(implementation_);
   }
@@ -64,7 +67,8 @@ public:
   // Move-construct an I/O object.
   io_object_impl(io_object_impl&& other)
     : service_(&other.get_service()),
-      executor_(other.get_executor())
+      executor_(other.get_executor()),
+      arena_(other.release_arena())
   {
     service_->move_construct(implementation_, other.implementation_);
   }
@@ -73,7 +77,8 @@ public:
   template <typename Executor1>
   io_object_impl(io_object_impl<IoObjectService, Executor1>&& other)
     : service_(&other.get_service()),
-      executor_(other.get_executor())
+      executor_(other.get_executor()),
+      arena_(other.release_arena())
   {
     service_->move_construct(implementation_, other.get_implementation());
   }
@@ -83,7 +88,8 @@ public:
   io_object_impl(io_object_impl<IoObjectService1, Executor1>&& other)
     : service_(&asio::use_service<IoObjectService>(
             io_object_impl::get_context(other.get_executor()))),
-      executor_(other.get_executor())
+      executor_(other.get_executor()),
+      arena_(other.release_arena())
   {
     service_->converting_move_construct(implementation_,
         other.get_service(), other.get_implementation());
@@ -94,6 +100,8 @@ public:
   ~io_object_impl()
   {
     service_->destroy(implementation_);
+    if (arena_)
+      arena_->release();
   }
 
 #if defined(ASIO_HAS_MOVE)
@@ -107,6 +115,8 @@ public:
       executor_.~executor_type();
       new (&executor_) executor_type(other.executor_);
       service_ = other.service_;
+      set_arena(0);
+      arena_ = other.release_arena();
     }
     return *this;
   }
@@ -142,6 +152,30 @@ public:
     return implementation_;
   }
 
+  // Get the arena used for the I/O object's operations, if any.
+  arena_impl* get_arena() const ASIO_NOEXCEPT
+  {
+    return arena_;
+  }
+
+  // Set the arena used for the I/O object's operations.
+  void set_arena(arena_impl* a) ASIO_NOEXCEPT
+  {
+    if (a)
+      a->add_ref();
+    if (arena_)
+      arena_->release();
+    arena_ = a;
+  }
+
+  // Give up ownership of the arena.
+  arena_impl* release_arena() ASIO_NOEXCEPT
+  {
+    arena_impl* a = arena_;
+    arena_ = 0;
+    return a;
+  }
+
 private:
   // Helper function to get an executor's context.
   template <typename T>
@@ -171,6 +205,9 @@ private:
 
   // The associated executor.
   executor_type executor_;
+
+  // The arena used for the I/O object's operations, if any.
+  arena_impl* arena_;
 };
 
 } // namespace detail
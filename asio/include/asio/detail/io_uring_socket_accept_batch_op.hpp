@@ -0,0 +1,163 @@
+//
+// detail/io_uring_socket_accept_batch_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_BATCH_OP_HPP
+#define ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_BATCH_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+
+#include "asio/detail/accept_batch.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_operation.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// io_uring has no operation that accepts more than one connection, so the op
+// polls for readiness and then drains the listening socket's queue. The
+// listening socket must be in non-blocking mode.
+template <typename Protocol, typename PeerIoExecutor>
+class io_uring_socket_accept_batch_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_accept_batch_op_base(const asio::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, func_type complete_func)
+    : io_uring_operation(success_ec,
+        &io_uring_socket_accept_batch_op_base::do_prepare,
+        &io_uring_socket_accept_batch_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      batch_(peer_io_ex, protocol, max_sockets)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    io_uring_socket_accept_batch_op_base* o(
+        static_cast<io_uring_socket_accept_batch_op_base*>(base));
+
+    ::io_uring_prep_poll_add(sqe, o->socket_, POLLIN);
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    io_uring_socket_accept_batch_op_base* o(
+        static_cast<io_uring_socket_accept_batch_op_base*>(base));
+
+    // The poll failed or was cancelled.
+    if (after_completion && o->ec_)
+      return true;
+
+    // The connections are left in blocking mode, so that operations on the
+    // new sockets are performed by io_uring directly.
+    return o->batch_.perform(o->socket_, o->state_, false, o->ec_);
+  }
+
+protected:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  accept_batch<Protocol, PeerIoExecutor> batch_;
+};
+
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class io_uring_socket_accept_batch_op :
+  public io_uring_socket_accept_batch_op_base<Protocol, PeerIoExecutor>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_socket_accept_batch_op);
+
+  io_uring_socket_accept_batch_op(const asio::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, Handler& handler, const IoExecutor& io_ex)
+    : io_uring_socket_accept_batch_op_base<Protocol, PeerIoExecutor>(
+        success_ec, peer_io_ex, socket, state, protocol, max_sockets,
+        &io_uring_socket_accept_batch_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    io_uring_socket_accept_batch_op* o(
+        static_cast<io_uring_socket_accept_batch_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    // On success, create socket objects for the new connections.
+    sockets_type sockets;
+    if (owner)
+      sockets = o->batch_.release(false, o->ec_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::move_binder2<Handler, asio::error_code, sockets_type>
+      handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+        ASIO_MOVE_CAST(sockets_type)(sockets));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  typedef typename accept_batch<Protocol,
+    PeerIoExecutor>::sockets_type sockets_type;
+
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_BATCH_OP_HPP
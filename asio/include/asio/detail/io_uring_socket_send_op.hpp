@@ -98,7 +98,10 @@ public:
       }
     }
 
-    if (o->ec_ && o->ec_ == asio::error::would_block)
+    // A TCP Fast Open connection reports in_progress until its handshake
+    // completes, so wait for readiness as for would_block.
+    if (o->ec_ && (o->ec_ == asio::error::would_block
+          || o->ec_ == asio::error::in_progress))
     {
       o->state_ |= socket_ops::internal_non_blocking;
       return false;
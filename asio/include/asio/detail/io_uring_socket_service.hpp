@@ -28,9 +28,13 @@
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/io_uring_null_buffers_op.hpp"
 #include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/io_uring_socket_accept_batch_op.hpp"
 #include "asio/detail/io_uring_socket_accept_op.hpp"
 #include "asio/detail/io_uring_socket_connect_op.hpp"
+#include "asio/detail/io_uring_socket_recvcoalesced_op.hpp"
 #include "asio/detail/io_uring_socket_recvfrom_op.hpp"
+#include "asio/detail/io_uring_socket_recvmmsg_op.hpp"
+#include "asio/detail/io_uring_socket_sendmmsg_op.hpp"
 #include "asio/detail/io_uring_socket_sendto_op.hpp"
 #include "asio/detail/io_uring_socket_service_base.hpp"
 #include "asio/detail/socket_holder.hpp"
@@ -334,6 +338,43 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous send of a batch of datagrams. The slots and the data
+  // being sent must be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_send_batch(implementation_type& impl,
+      basic_datagram_slot<const_buffer, endpoint_type>* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_sendmmsg_op<
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        slots, count, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send_batch"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -473,6 +514,120 @@ public:
     p.v = p.p = 0;
   }
 
+  // Receive a datagram, or a run of datagrams coalesced by generic receive
+  // offload, with the endpoint of the sender. Returns the number of bytes
+  // received.
+  template <typename MutableBufferSequence>
+  size_t receive_coalesced(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    bufs_type bufs(buffers);
+    std::size_t addr_len = sender_endpoint.capacity();
+    socket_ops::control_storage control;
+    std::size_t control_len = sizeof(control);
+    int out_flags = 0;
+    std::size_t n = socket_ops::sync_recvmsg(impl.socket_, impl.state_,
+        bufs.buffers(), bufs.count(), flags, out_flags,
+        sender_endpoint.data(), &addr_len, control.data, &control_len, ec);
+
+    if (!ec)
+    {
+      sender_endpoint.resize(addr_len);
+      segment_size = socket_ops::gro_segment_size(control.data, control_len);
+      if (segment_size == 0)
+        segment_size = n;
+    }
+
+    ASIO_ERROR_LOCATION(ec);
+    return n;
+  }
+
+  // Start an asynchronous receive of a datagram, or a run of datagrams
+  // coalesced by generic receive offload. The buffer for the data being
+  // received, the sender_endpoint object and the segment_size object must all
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_coalesced(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    int op_type = (flags & socket_base::message_out_of_band)
+      ? io_uring_service::except_op : io_uring_service::read_op;
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recvcoalesced_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_, buffers,
+        sender_endpoint, segment_size, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(
+            &io_uring_service_, &impl.io_object_data_, op_type);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_coalesced"));
+
+    start_op(impl, op_type, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. The slots and the
+  // buffers they refer to must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_batch(implementation_type& impl,
+      basic_datagram_slot<mutable_buffer, endpoint_type>* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recvmmsg_op<
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        slots, count, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_batch"));
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type& impl,
@@ -575,6 +730,50 @@ public:
     start_accept_op(impl, p.p, is_continuation, false);
     p.v = p.p = 0;
   }
+
+  // Start an asynchronous accept of a batch of connections.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_move_accept_batch(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, std::size_t max_connections,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_accept_batch_op<Protocol,
+        PeerIoExecutor, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, peer_io_ex, impl.socket_,
+        impl.state_, impl.protocol_, max_connections, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_accept_batch"));
+
+    // The queue of waiting connections can only be drained without blocking
+    // if the listening socket is in non-blocking mode.
+    bool noop = (max_connections == 0);
+    if (!noop && (impl.state_ & socket_ops::non_blocking) == 0)
+    {
+      noop = !socket_ops::set_internal_non_blocking(
+          impl.socket_, impl.state_, true, p.p->ec_);
+    }
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation, noop);
+    p.v = p.p = 0;
+  }
 #endif // defined(ASIO_HAS_MOVE)
 
   // Connect the socket to the specified endpoint.
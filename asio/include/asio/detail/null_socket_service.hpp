@@ -20,6 +20,7 @@
 #if defined(ASIO_WINDOWS_RUNTIME)
 
 #include "asio/buffer.hpp"
+#include "asio/datagram_slot.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/post.hpp"
@@ -425,6 +426,18 @@ public:
           handler, ec, bytes_transferred));
   }
 
+  // Start an asynchronous send of a batch of datagrams.
+  template <typename Handler, typename IoExecutor>
+  void async_send_batch(implementation_type&,
+      basic_datagram_slot<const_buffer, endpoint_type>*, std::size_t,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t slots_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, slots_transferred));
+  }
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -472,6 +485,42 @@ public:
           handler, ec, bytes_transferred));
   }
 
+  // Receive a datagram, or a run of datagrams coalesced by generic receive
+  // offload.
+  template <typename MutableBufferSequence>
+  std::size_t receive_coalesced(implementation_type&,
+      const MutableBufferSequence&, endpoint_type&, std::size_t&,
+      socket_base::message_flags, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous receive of a datagram, or a run of datagrams
+  // coalesced by generic receive offload.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_coalesced(implementation_type&,
+      const MutableBufferSequence&, endpoint_type&, std::size_t&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(handler, ec, bytes_transferred));
+  }
+
+  // Start an asynchronous receive of a batch of datagrams.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_batch(implementation_type&,
+      basic_datagram_slot<mutable_buffer, endpoint_type>*, std::size_t,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t slots_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, slots_transferred));
+  }
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type&,
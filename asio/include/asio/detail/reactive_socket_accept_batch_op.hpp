@@ -0,0 +1,154 @@
+//
+// detail/reactive_socket_accept_batch_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_ACCEPT_BATCH_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_ACCEPT_BATCH_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MOVE)
+
+#include "asio/detail/accept_batch.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Protocol, typename PeerIoExecutor>
+class reactive_socket_accept_batch_op_base : public reactor_op
+{
+public:
+  reactive_socket_accept_batch_op_base(const asio::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_accept_batch_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      batch_(peer_io_ex, protocol, max_sockets)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_accept_batch_op_base* o(
+        static_cast<reactive_socket_accept_batch_op_base*>(base));
+
+    // The connections are accepted in non-blocking mode, ready for the
+    // reactor, so that the new sockets need no further system calls.
+    status result = o->batch_.perform(o->socket_,
+        o->state_, true, o->ec_) ? done : not_done;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept_batch", o->ec_));
+
+    return result;
+  }
+
+protected:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  accept_batch<Protocol, PeerIoExecutor> batch_;
+};
+
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class reactive_socket_accept_batch_op :
+  public reactive_socket_accept_batch_op_base<Protocol, PeerIoExecutor>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_accept_batch_op);
+
+  reactive_socket_accept_batch_op(const asio::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_accept_batch_op_base<Protocol, PeerIoExecutor>(
+        success_ec, peer_io_ex, socket, state, protocol, max_sockets,
+        &reactive_socket_accept_batch_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_accept_batch_op* o(
+        static_cast<reactive_socket_accept_batch_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    // On success, create socket objects for the new connections.
+    sockets_type sockets;
+    if (owner)
+      sockets = o->batch_.release(true, o->ec_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::move_binder2<Handler, asio::error_code, sockets_type>
+      handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+        ASIO_MOVE_CAST(sockets_type)(sockets));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  typedef typename accept_batch<Protocol,
+    PeerIoExecutor>::sockets_type sockets_type;
+
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_ACCEPT_BATCH_OP_HPP
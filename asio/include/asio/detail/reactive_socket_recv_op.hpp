@@ -44,6 +44,7 @@ public:
       socket_(socket),
       state_(state),
       buffers_(buffers),
+      bufs_(buffers),
       flags_(flags)
   {
   }
@@ -67,9 +68,8 @@ public:
     }
     else
     {
-      bufs_type bufs(o->buffers_);
       result = socket_ops::non_blocking_recv(o->socket_,
-          bufs.buffers(), bufs.count(), o->flags_,
+          o->bufs_.buffers(), o->bufs_.count(), o->flags_,
           (o->state_ & socket_ops::stream_oriented) != 0,
           o->ec_, o->bytes_transferred_) ? done : not_done;
     }
@@ -89,6 +89,7 @@ private:
   socket_type socket_;
   socket_ops::state_type state_;
   MutableBufferSequence buffers_;
+  buffer_sequence_adapter<asio::mutable_buffer, MutableBufferSequence> bufs_;
   socket_base::message_flags flags_;
 };
 
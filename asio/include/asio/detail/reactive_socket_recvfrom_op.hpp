@@ -44,6 +44,7 @@ public:
       socket_(socket),
       protocol_type_(protocol_type),
       buffers_(buffers),
+      bufs_(buffers),
       sender_endpoint_(endpoint),
       flags_(flags)
   {
@@ -69,9 +70,8 @@ public:
     }
     else
     {
-      bufs_type bufs(o->buffers_);
       result = socket_ops::non_blocking_recvfrom(o->socket_,
-          bufs.buffers(), bufs.count(), o->flags_,
+          o->bufs_.buffers(), o->bufs_.count(), o->flags_,
           o->sender_endpoint_.data(), &addr_len,
           o->ec_, o->bytes_transferred_) ? done : not_done;
     }
@@ -89,6 +89,7 @@ private:
   socket_type socket_;
   int protocol_type_;
   MutableBufferSequence buffers_;
+  buffer_sequence_adapter<asio::mutable_buffer, MutableBufferSequence> bufs_;
   Endpoint& sender_endpoint_;
   socket_base::message_flags flags_;
 };
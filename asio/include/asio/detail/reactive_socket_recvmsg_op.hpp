@@ -44,6 +44,7 @@ public:
         &reactive_socket_recvmsg_op_base::do_perform, complete_func),
       socket_(socket),
       buffers_(buffers),
+      bufs_(buffers),
       in_flags_(in_flags),
       out_flags_(out_flags)
   {
@@ -54,11 +55,8 @@ public:
     reactive_socket_recvmsg_op_base* o(
         static_cast<reactive_socket_recvmsg_op_base*>(base));
 
-    buffer_sequence_adapter<asio::mutable_buffer,
-        MutableBufferSequence> bufs(o->buffers_);
-
     status result = socket_ops::non_blocking_recvmsg(o->socket_,
-        bufs.buffers(), bufs.count(),
+        o->bufs_.buffers(), o->bufs_.count(),
         o->in_flags_, o->out_flags_,
         o->ec_, o->bytes_transferred_) ? done : not_done;
 
@@ -71,6 +69,7 @@ public:
 private:
   socket_type socket_;
   MutableBufferSequence buffers_;
+  buffer_sequence_adapter<asio::mutable_buffer, MutableBufferSequence> bufs_;
   socket_base::message_flags in_flags_;
   socket_base::message_flags& out_flags_;
 };
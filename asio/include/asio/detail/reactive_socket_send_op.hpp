@@ -44,6 +44,7 @@ public:
       socket_(socket),
       state_(state),
       buffers_(buffers),
+      bufs_(buffers),
       flags_(flags)
   {
   }
@@ -71,14 +72,13 @@ public:
     }
     else
     {
-      bufs_type bufs(o->buffers_);
       result = socket_ops::non_blocking_send(o->socket_,
-            bufs.buffers(), bufs.count(), o->flags_,
+            o->bufs_.buffers(), o->bufs_.count(), o->flags_,
             o->ec_, o->bytes_transferred_) ? done : not_done;
 
       if (result == done)
         if ((o->state_ & socket_ops::stream_oriented) != 0)
-          if (o->bytes_transferred_ < bufs.total_size())
+          if (o->bytes_transferred_ < o->bufs_.total_size())
             result = done_and_exhausted;
     }
 
@@ -92,6 +92,7 @@ private:
   socket_type socket_;
   socket_ops::state_type state_;
   ConstBufferSequence buffers_;
+  buffer_sequence_adapter<asio::const_buffer, ConstBufferSequence> bufs_;
   socket_base::message_flags flags_;
 };
 
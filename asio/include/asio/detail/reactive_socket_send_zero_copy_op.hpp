@@ -0,0 +1,189 @@
+//
+// detail/reactive_socket_send_zero_copy_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Sends data with MSG_ZEROCOPY, so that the kernel transmits directly from the
+// caller's buffers. The operation then waits for the kernel to report, on the
+// socket's error queue, that it has released the buffers. Zero-copy sends on a
+// socket are numbered by the kernel, and the counter passed to the operation
+// tracks that numbering.
+template <typename ConstBufferSequence>
+class reactive_socket_send_zero_copy_op_base : public reactor_op
+{
+public:
+  reactive_socket_send_zero_copy_op_base(const asio::error_code& success_ec,
+      socket_type socket, uint32_t* counter,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_send_zero_copy_op_base::do_perform, complete_func),
+      socket_(socket),
+      counter_(counter),
+      buffers_(buffers),
+      bufs_(buffers),
+      flags_(flags),
+      id_(0),
+      sent_(false),
+      exhausted_(false)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_send_zero_copy_op_base* o(
+        static_cast<reactive_socket_send_zero_copy_op_base*>(base));
+
+    if (!o->sent_)
+    {
+      if (!socket_ops::non_blocking_send(o->socket_,
+            o->bufs_.buffers(), o->bufs_.count(), o->flags_ | MSG_ZEROCOPY,
+            o->ec_, o->bytes_transferred_))
+        return not_done;
+
+      // The kernel cannot pin the pages once the socket's allowance for
+      // zero-copy sends is used up. Copy the data instead.
+      if (o->ec_ == asio::error::no_buffer_space)
+      {
+        if (!socket_ops::non_blocking_send(o->socket_,
+              o->bufs_.buffers(), o->bufs_.count(), o->flags_,
+              o->ec_, o->bytes_transferred_))
+          return not_done;
+        return o->ec_ || o->bytes_transferred_ == o->bufs_.total_size()
+          ? done : done_and_exhausted;
+      }
+
+      ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_send",
+            o->ec_, o->bytes_transferred_));
+
+      if (o->ec_ || o->bytes_transferred_ == 0)
+        return done;
+
+      o->id_ = (*o->counter_)++;
+      o->sent_ = true;
+      o->exhausted_ = o->bytes_transferred_ < o->bufs_.total_size();
+    }
+
+    // The buffers must not be released to the caller until the kernel has
+    // finished with them.
+    if (!socket_ops::non_blocking_zero_copy_complete(
+          o->socket_, o->id_, o->ec_))
+      return not_done;
+
+    return o->exhausted_ ? done_and_exhausted : done;
+  }
+
+private:
+  socket_type socket_;
+  uint32_t* counter_;
+  ConstBufferSequence buffers_;
+  buffer_sequence_adapter<asio::const_buffer, ConstBufferSequence> bufs_;
+  socket_base::message_flags flags_;
+  uint32_t id_;
+  bool sent_;
+  bool exhausted_;
+};
+
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class reactive_socket_send_zero_copy_op :
+  public reactive_socket_send_zero_copy_op_base<ConstBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_zero_copy_op);
+
+  reactive_socket_send_zero_copy_op(const asio::error_code& success_ec,
+      socket_type socket, uint32_t* counter,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_send_zero_copy_op_base<ConstBufferSequence>(
+        success_ec, socket, counter, buffers, flags,
+        &reactive_socket_send_zero_copy_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_send_zero_copy_op* o(
+        static_cast<reactive_socket_send_zero_copy_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
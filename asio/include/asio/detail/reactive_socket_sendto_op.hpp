@@ -43,6 +43,7 @@ public:
         &reactive_socket_sendto_op_base::do_perform, complete_func),
       socket_(socket),
       buffers_(buffers),
+      bufs_(buffers),
       destination_(endpoint),
       flags_(flags)
   {
@@ -67,9 +68,8 @@ public:
     }
     else
     {
-      bufs_type bufs(o->buffers_);
       result = socket_ops::non_blocking_sendto(o->socket_,
-          bufs.buffers(), bufs.count(), o->flags_,
+          o->bufs_.buffers(), o->bufs_.count(), o->flags_,
           o->destination_.data(), o->destination_.size(),
           o->ec_, o->bytes_transferred_) ? done : not_done;
     }
@@ -83,6 +83,7 @@ public:
 private:
   socket_type socket_;
   ConstBufferSequence buffers_;
+  buffer_sequence_adapter<asio::const_buffer, ConstBufferSequence> bufs_;
   Endpoint destination_;
   socket_base::message_flags flags_;
 };
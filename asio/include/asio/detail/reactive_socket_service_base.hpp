@@ -33,6 +33,7 @@
 #include "asio/detail/reactive_socket_recv_op.hpp"
 #include "asio/detail/reactive_socket_recvmsg_op.hpp"
 #include "asio/detail/reactive_socket_send_op.hpp"
+#include "asio/detail/reactive_socket_send_zero_copy_op.hpp"
 #include "asio/detail/reactive_wait_op.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -285,6 +286,16 @@ public:
       const ConstBufferSequence& buffers, socket_base::message_flags flags,
       Handler& handler, const IoExecutor& io_ex)
   {
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    if ((impl.state_ & socket_ops::zero_copy)
+        && (impl.state_ & socket_ops::stream_oriented)
+        && asio::buffer_size(buffers) >= zero_copy_threshold)
+    {
+      async_send_zero_copy(impl, buffers, flags, handler, io_ex);
+      return;
+    }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
@@ -598,6 +609,49 @@ protected:
   ASIO_DECL void start_connect_op(base_implementation_type& impl,
       reactor_op* op, bool is_continuation, const void* addr, size_t addrlen);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Sends smaller than this are copied, as pinning the pages and processing
+  // the completion notification costs more than the copy.
+  enum { zero_copy_threshold = 16384 };
+
+  // Start an asynchronous zero-copy send. The data being sent must be valid
+  // until the kernel has finished with it.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zero_copy_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        reactor::zero_copy_counter(impl.reactor_data_),
+        buffers, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send(zero_copy)"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Helper class used to implement per-operation cancellation
   class reactor_op_cancellation
   {
@@ -27,6 +27,7 @@
 #include "asio/detail/scheduler_task.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -141,6 +142,13 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the recycling allocator settings used by threads running the
+  // scheduler.
+  recycling_cache_control& recycling_cache()
+  {
+    return recycling_cache_;
+  }
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -225,6 +233,10 @@ private:
   // The concurrency hint used to initialise the scheduler.
   const int concurrency_hint_;
 
+  // The recycling allocator settings and counters for threads running the
+  // scheduler.
+  recycling_cache_control recycling_cache_;
+
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
 };
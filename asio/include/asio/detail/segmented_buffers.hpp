@@ -0,0 +1,169 @@
+//
+// detail/segmented_buffers.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SEGMENTED_BUFFERS_HPP
+#define ASIO_DETAIL_SEGMENTED_BUFFERS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Iterator over the buffers that make up a range of bytes held in a chain of
+// equally sized blocks. Positions are measured from the start of the first
+// block in the chain.
+template <typename Buffer>
+class segmented_buffers_iterator
+{
+public:
+  typedef std::ptrdiff_t difference_type;
+  typedef Buffer value_type;
+  typedef const Buffer* pointer;
+  typedef Buffer reference;
+  typedef std::bidirectional_iterator_tag iterator_category;
+
+  segmented_buffers_iterator()
+    : blocks_(0),
+      block_size_(1),
+      begin_(0),
+      position_(0),
+      end_(0)
+  {
+  }
+
+  segmented_buffers_iterator(const std::deque<char*>* blocks,
+      std::size_t block_size, std::size_t begin,
+      std::size_t position, std::size_t end)
+    : blocks_(blocks),
+      block_size_(block_size),
+      begin_(begin),
+      position_(position),
+      end_(end)
+  {
+  }
+
+  reference operator*() const
+  {
+    std::size_t offset = position_ % block_size_;
+    return Buffer((*blocks_)[position_ / block_size_] + offset,
+        (std::min)(block_size_ - offset, end_ - position_));
+  }
+
+  segmented_buffers_iterator& operator++()
+  {
+    position_ = (std::min)(
+        (position_ / block_size_ + 1) * block_size_, end_);
+    return *this;
+  }
+
+  segmented_buffers_iterator operator++(int)
+  {
+    segmented_buffers_iterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  segmented_buffers_iterator& operator--()
+  {
+    position_ = (std::max)(
+        (position_ - 1) / block_size_ * block_size_, begin_);
+    return *this;
+  }
+
+  segmented_buffers_iterator operator--(int)
+  {
+    segmented_buffers_iterator tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  friend bool operator==(const segmented_buffers_iterator& a,
+      const segmented_buffers_iterator& b)
+  {
+    return a.position_ == b.position_;
+  }
+
+  friend bool operator!=(const segmented_buffers_iterator& a,
+      const segmented_buffers_iterator& b)
+  {
+    return a.position_ != b.position_;
+  }
+
+private:
+  const std::deque<char*>* blocks_;
+  std::size_t block_size_;
+  std::size_t begin_;
+  std::size_t position_;
+  std::size_t end_;
+};
+
+// A buffer sequence representing a range of bytes held in a chain of equally
+// sized blocks, with one buffer for each block that the range touches.
+template <typename Buffer>
+class segmented_buffers
+{
+public:
+  typedef Buffer value_type;
+  typedef segmented_buffers_iterator<Buffer> const_iterator;
+
+  segmented_buffers(const std::deque<char*>& blocks,
+      std::size_t block_size, std::size_t begin, std::size_t end)
+    : blocks_(&blocks),
+      block_size_(block_size),
+      begin_(begin),
+      end_(end)
+  {
+  }
+
+  // Mutable buffers may be converted to constant buffers.
+  template <typename OtherBuffer>
+  segmented_buffers(const segmented_buffers<OtherBuffer>& other)
+    : blocks_(other.blocks_),
+      block_size_(other.block_size_),
+      begin_(other.begin_),
+      end_(other.end_)
+  {
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(blocks_, block_size_, begin_, begin_, end_);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(blocks_, block_size_, begin_, end_, end_);
+  }
+
+private:
+  template <typename> friend class segmented_buffers;
+
+  const std::deque<char*>* blocks_;
+  std::size_t block_size_;
+  std::size_t begin_;
+  std::size_t end_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_SEGMENTED_BUFFERS_HPP
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/error_code.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/socket_types.hpp"
 
@@ -52,7 +53,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // The user enabled zero-copy sends.
+  zero_copy = 128
 };
 
 typedef unsigned char state_type;
@@ -81,6 +85,14 @@ ASIO_DECL bool non_blocking_accept(socket_type s,
     state_type state, void* addr, std::size_t* addrlen,
     asio::error_code& ec, socket_type& new_socket);
 
+// Accepts up to max_sockets waiting connections. Requires the listening socket
+// to be in non-blocking mode. Where supported, the new sockets are created
+// close-on-exec and, if non_blocking is true, in non-blocking mode.
+ASIO_DECL bool non_blocking_accept_batch(socket_type s,
+    state_type state, bool non_blocking, socket_type* new_sockets,
+    std::size_t max_sockets, asio::error_code& ec,
+    std::size_t& sockets_accepted);
+
 #endif // defined(ASIO_HAS_IOCP)
 
 ASIO_DECL int bind(socket_type s, const void* addr,
@@ -220,6 +232,46 @@ ASIO_DECL bool non_blocking_recvmsg(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+// Storage for the control data received with a datagram.
+union control_storage
+{
+  char data[64];
+  std::size_t align;
+};
+
+ASIO_DECL signed_size_type recvmsg(socket_type s, buf* bufs,
+    size_t count, int in_flags, int& out_flags, void* addr,
+    std::size_t* addrlen, void* control, std::size_t* controllen,
+    asio::error_code& ec);
+
+ASIO_DECL size_t sync_recvmsg(socket_type s, state_type state,
+    buf* bufs, size_t count, int in_flags, int& out_flags, void* addr,
+    std::size_t* addrlen, void* control, std::size_t* controllen,
+    asio::error_code& ec);
+
+#if !defined(ASIO_HAS_IOCP)
+
+ASIO_DECL bool non_blocking_recvmsg(socket_type s,
+    buf* bufs, size_t count, int in_flags, int& out_flags, void* addr,
+    std::size_t* addrlen, void* control, std::size_t* controllen,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // !defined(ASIO_HAS_IOCP)
+
+// Returns the segment size of a datagram coalesced by UDP generic receive
+// offload, or 0 if the control data does not contain one.
+ASIO_DECL size_t gro_segment_size(const void* control, std::size_t controllen);
+
+ASIO_DECL signed_size_type recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+#if !defined(ASIO_HAS_IOCP)
+
+ASIO_DECL bool non_blocking_recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages);
+
+#endif // !defined(ASIO_HAS_IOCP)
+
 ASIO_DECL signed_size_type send(socket_type s, const buf* bufs,
     size_t count, int flags, asio::error_code& ec);
 
@@ -251,6 +303,29 @@ ASIO_DECL bool non_blocking_send1(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+// Reads the notifications on the socket's error queue that report the
+// completion of zero-copy sends. Returns true once the send with the given id
+// has completed, or on error, and false if the send is still in progress.
+// Other errors read from the queue are kept in ec and reported when the send
+// completes.
+ASIO_DECL bool non_blocking_zero_copy_complete(socket_type s,
+    uint32_t id, asio::error_code& ec);
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+// Sends data from a file descriptor to a socket. If offset is non-null, the
+// data is read starting at *offset, and *offset is advanced past the data
+// that was sent. Otherwise, the descriptor's current position is used.
+ASIO_DECL bool non_blocking_sendfile(socket_type s, int d,
+    uint64_t* offset, size_t size, asio::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
 ASIO_DECL signed_size_type sendto(socket_type s,
     const buf* bufs, size_t count, int flags, const void* addr,
     std::size_t addrlen, asio::error_code& ec);
@@ -279,6 +354,16 @@ ASIO_DECL bool non_blocking_sendto1(socket_type s, const void* data,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+ASIO_DECL signed_size_type sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+#if !defined(ASIO_HAS_IOCP)
+
+ASIO_DECL bool non_blocking_sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages);
+
+#endif // !defined(ASIO_HAS_IOCP)
+
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
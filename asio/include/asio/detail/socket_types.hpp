@@ -81,6 +81,18 @@
 # if !defined(__SYMBIAN32__)
 #  include <netinet/tcp.h>
 # endif
+# if defined(ASIO_HAS_UDP_GSO) || defined(ASIO_HAS_UDP_GRO)
+#  include <netinet/udp.h>
+# endif
+# if defined(ASIO_HAS_MSG_ZEROCOPY)
+#  include <linux/errqueue.h>
+# endif
+# if defined(ASIO_HAS_SPLICE)
+#  include <fcntl.h>
+# endif
+# if defined(ASIO_HAS_SENDFILE)
+#  include <sys/sendfile.h>
+# endif
 # include <arpa/inet.h>
 # include <netdb.h>
 # include <net/if.h>
@@ -207,6 +219,9 @@ typedef u_long u_long_type;
 typedef u_short u_short_type;
 typedef int signed_size_type;
 struct sockaddr_un_type { u_short sun_family; char sun_path[108]; };
+struct msghdr_type { void* msg_name; int msg_namelen;
+  WSABUF* msg_iov; int msg_iovlen; int msg_flags; };
+struct mmsghdr_type { msghdr_type msg_hdr; unsigned int msg_len; };
 # define ASIO_OS_DEF(c) ASIO_OS_DEF_##c
 # define ASIO_OS_DEF_AF_UNSPEC AF_UNSPEC
 # define ASIO_OS_DEF_AF_INET AF_INET
@@ -323,6 +338,12 @@ typedef ssize_t signed_size_type;
 #else // defined(ASIO_HAS_SSIZE_T)
 typedef int signed_size_type;
 #endif // defined(ASIO_HAS_SSIZE_T)
+typedef msghdr msghdr_type;
+#if defined(ASIO_HAS_MMSG)
+typedef mmsghdr mmsghdr_type;
+#else // defined(ASIO_HAS_MMSG)
+struct mmsghdr_type { msghdr_type msg_hdr; unsigned int msg_len; };
+#endif // defined(ASIO_HAS_MMSG)
 # define ASIO_OS_DEF(c) ASIO_OS_DEF_##c
 # define ASIO_OS_DEF_AF_UNSPEC AF_UNSPEC
 # define ASIO_OS_DEF_AF_INET AF_INET
@@ -360,7 +381,30 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_SO_SNDLOWAT SO_SNDLOWAT
 # define ASIO_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define ASIO_OS_DEF_SO_REUSEADDR SO_REUSEADDR
+# if defined(ASIO_HAS_MSG_ZEROCOPY)
+#  define ASIO_OS_DEF_SO_ZEROCOPY SO_ZEROCOPY
+# endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 # define ASIO_OS_DEF_TCP_NODELAY TCP_NODELAY
+# if defined(TCP_FASTOPEN)
+#  define ASIO_OS_DEF_TCP_FASTOPEN TCP_FASTOPEN
+# else // defined(TCP_FASTOPEN)
+#  define ASIO_OS_DEF_TCP_FASTOPEN 23
+# endif // defined(TCP_FASTOPEN)
+# if defined(TCP_FASTOPEN_CONNECT)
+#  define ASIO_OS_DEF_TCP_FASTOPEN_CONNECT TCP_FASTOPEN_CONNECT
+# else // defined(TCP_FASTOPEN_CONNECT)
+#  define ASIO_OS_DEF_TCP_FASTOPEN_CONNECT 30
+# endif // defined(TCP_FASTOPEN_CONNECT)
+# if defined(UDP_SEGMENT)
+#  define ASIO_OS_DEF_UDP_SEGMENT UDP_SEGMENT
+# else // defined(UDP_SEGMENT)
+#  define ASIO_OS_DEF_UDP_SEGMENT 103
+# endif // defined(UDP_SEGMENT)
+# if defined(UDP_GRO)
+#  define ASIO_OS_DEF_UDP_GRO UDP_GRO
+# else // defined(UDP_GRO)
+#  define ASIO_OS_DEF_UDP_GRO 104
+# endif // defined(UDP_GRO)
 # define ASIO_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define ASIO_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
 # define ASIO_OS_DEF_IP_MULTICAST_LOOP IP_MULTICAST_LOOP
@@ -0,0 +1,76 @@
+//
+// detail/splice_pipe.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SPLICE_PIPE_HPP
+#define ASIO_DETAIL_SPLICE_PIPE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include "asio/error_code.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A non-blocking pipe that holds data being moved between two descriptors by
+// splice(), when neither descriptor is itself a pipe.
+class splice_pipe
+  : private noncopyable
+{
+public:
+  // Constructor.
+  ASIO_DECL splice_pipe();
+
+  // Destructor. Closes the pipe, discarding any data it still holds.
+  ASIO_DECL ~splice_pipe();
+
+  // Open the pipe.
+  ASIO_DECL asio::error_code open(asio::error_code& ec);
+
+  // Get the descriptor from which data is read.
+  int read_descriptor() const
+  {
+    return read_descriptor_;
+  }
+
+  // Get the descriptor to which data is written.
+  int write_descriptor() const
+  {
+    return write_descriptor_;
+  }
+
+private:
+  // The read end of the pipe.
+  int read_descriptor_;
+
+  // The write end of the pipe.
+  int write_descriptor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/splice_pipe.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#endif // ASIO_DETAIL_SPLICE_PIPE_HPP
@@ -0,0 +1,100 @@
+//
+// detail/splice_pipe_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SPLICE_PIPE_POOL_HPP
+#define ASIO_DETAIL_SPLICE_PIPE_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include <cstddef>
+#include <vector>
+#include "asio/error_code.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/splice_pipe.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/query.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Keeps the pipes of completed splice operations open, so that operations
+// that follow do not have to open and close a pipe of their own.
+class splice_pipe_pool
+  : public execution_context_service_base<splice_pipe_pool>
+{
+public:
+  // Constructor.
+  ASIO_DECL explicit splice_pipe_pool(execution_context& context);
+
+  // Destroy all unused pipes.
+  ASIO_DECL void shutdown();
+
+  // Get the pool belonging to an executor's context.
+  template <typename Executor>
+  static splice_pipe_pool& get(const Executor& ex,
+      typename enable_if<execution::is_executor<Executor>::value>::type* = 0)
+  {
+    return use_service<splice_pipe_pool>(
+        asio::query(ex, execution::context));
+  }
+
+  // Get the pool belonging to an executor's context.
+  template <typename Executor>
+  static splice_pipe_pool& get(const Executor& ex,
+      typename enable_if<!execution::is_executor<Executor>::value>::type* = 0)
+  {
+    return use_service<splice_pipe_pool>(ex.context());
+  }
+
+  // Take an unused pipe from the pool, or open a new one if there is none.
+  ASIO_DECL shared_ptr<splice_pipe> acquire(asio::error_code& ec);
+
+  // Return a pipe that holds no data to the pool. The pipe is closed if the
+  // pool is full.
+  ASIO_DECL void release(shared_ptr<splice_pipe>& pipe);
+
+  // Get the number of unused pipes held by the pool.
+  ASIO_DECL std::size_t unused_pipes();
+
+private:
+  // The maximum number of unused pipes kept open.
+  enum { max_unused_pipes = 16 };
+
+  // Mutex to protect access to the unused pipes.
+  asio::detail::mutex mutex_;
+
+  // The pipes that are not in use by any operation.
+  std::vector<shared_ptr<splice_pipe> > unused_pipes_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/splice_pipe_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#endif // ASIO_DETAIL_SPLICE_PIPE_POOL_HPP
@@ -16,7 +16,11 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#if defined(ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 #include "asio/detail/atomic_count.hpp"
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/mutex.hpp"
@@ -32,6 +36,19 @@
 namespace asio {
 namespace detail {
 
+// The default maximum number of ready handlers that a strand runs each time it
+// is scheduled, or 0 for no limit. Once the limit is reached, the strand
+// reschedules itself on the underlying executor so that other work can run.
+#ifndef ASIO_STRAND_HANDLER_BUDGET
+# define ASIO_STRAND_HANDLER_BUDGET 0
+#endif // ASIO_STRAND_HANDLER_BUDGET
+
+// The default maximum time, in microseconds, for which a strand runs ready
+// handlers each time it is scheduled, or 0 for no limit.
+#ifndef ASIO_STRAND_TIME_BUDGET_USEC
+# define ASIO_STRAND_TIME_BUDGET_USEC 0
+#endif // ASIO_STRAND_TIME_BUDGET_USEC
+
 // Default service implementation for a strand.
 class strand_executor_service
   : public execution_context_service_base<strand_executor_service>
@@ -46,6 +63,20 @@ public:
   private:
     friend class strand_executor_service;
 
+#if defined(ASIO_HAS_STD_ATOMIC)
+    // The state of the strand, combining the locked_flag and shutdown_flag
+    // values with a pointer to the handlers that are waiting on the strand
+    // but should not be run until after the next time the strand is
+    // scheduled. The waiting handlers form an intrusive stack, most recent
+    // first, which is pushed to by any thread using compare-and-swap and is
+    // taken as a whole by the strand itself.
+    //
+    // The strand is "locked" when there is a handler upcall in progress, or
+    // when the strand itself has been scheduled in order to invoke some
+    // pending handlers. A strand that has been shut down will accept no
+    // further handlers.
+    std::atomic<std::size_t> state_;
+#else // defined(ASIO_HAS_STD_ATOMIC)
     // Mutex to protect access to internal data.
     mutex* mutex_;
 
@@ -62,6 +93,27 @@ public:
     // after the next time the strand is scheduled. This queue must only be
     // modified while the mutex is locked.
     op_queue<scheduler_operation> waiting_queue_;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+    // The handlers that have been taken from the waiting stack but that did
+    // not fit in the strand's budget. They are run before any handlers that
+    // are still waiting. This queue is only accessed from within the strand.
+    op_queue<scheduler_operation> backlog_queue_;
+
+    // The maximum number of handlers run, and the maximum time in
+    // microseconds spent running them, each time the strand is scheduled.
+    // Zero means no limit.
+    std::atomic<std::size_t> handler_budget_;
+    std::atomic<long> time_budget_usec_;
+#else // defined(ASIO_HAS_STD_ATOMIC)
+    // The maximum number of handlers run, and the maximum time in
+    // microseconds spent running them, each time the strand is scheduled.
+    // Zero means no limit. These must only be accessed while the mutex is
+    // locked.
+    std::size_t handler_budget_;
+    long time_budget_usec_;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
@@ -122,6 +174,11 @@ public:
   ASIO_DECL static bool running_in_this_thread(
       const implementation_type& impl);
 
+  // Set the maximum number of handlers, and the maximum time in microseconds,
+  // for which the strand runs each time it is scheduled.
+  ASIO_DECL static void set_budget(const implementation_type& impl,
+      std::size_t max_handlers, long max_usec);
+
 private:
   friend class strand_impl;
   template <typename F, typename Allocator> class allocator_binder;
@@ -131,11 +188,14 @@ private:
   ASIO_DECL static bool enqueue(const implementation_type& impl,
       scheduler_operation* op);
 
-  // Transfers waiting handlers to the ready queue. Returns true if one or more
-  // handlers were transferred.
+  // Transfers as many waiting handlers to the ready queue as fit in the
+  // strand's budget. Returns true if there are handlers left to run, in which
+  // case the strand remains locked.
   ASIO_DECL static bool push_waiting_to_ready(implementation_type& impl);
 
-  // Invokes all ready-to-run handlers.
+  // Invokes ready-to-run handlers until the ready queue is empty or the
+  // strand's time budget is exhausted. Any handlers that are not run remain at
+  // the front of the ready queue for the next time the strand is scheduled.
   ASIO_DECL static void run_ready_handlers(implementation_type& impl);
 
   // Helper function to request invocation of the given function.
@@ -146,6 +206,15 @@ private:
   // Mutex to protect access to the service-wide state.
   mutex mutex_;
 
+#if defined(ASIO_HAS_STD_ATOMIC)
+  // Flags stored in the low bits of a strand's state.
+  enum
+  {
+    locked_flag = 1,
+    shutdown_flag = 2,
+    state_flags = locked_flag | shutdown_flag
+  };
+#else // defined(ASIO_HAS_STD_ATOMIC)
   // Number of mutexes shared between all strand objects.
   enum { num_mutexes = 193 };
 
@@ -155,6 +224,7 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same mutex.
   std::size_t salt_;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
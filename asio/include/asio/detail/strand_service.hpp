@@ -17,10 +17,12 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/io_context.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
 #include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/static_mutex.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -70,13 +72,83 @@ public:
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<operation> ready_queue_;
+
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+    // The number of strand objects that refer to the implementation, plus one
+    // while the strand is locked.
+    atomic_count ref_count_;
+
+    // The service that owns the implementation, or null if the service has
+    // been destroyed. Protected by the owner mutex.
+    strand_service* service_;
+
+    // Pointers to adjacent implementations in the service's list of live or
+    // free implementations.
+    strand_impl* next_impl_;
+    strand_impl* prev_impl_;
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
   };
 
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  // A counted reference to a strand implementation.
+  class implementation_type
+  {
+  public:
+    implementation_type()
+      : impl_(0)
+    {
+    }
+
+    implementation_type(const implementation_type& other)
+      : impl_(other.impl_)
+    {
+      if (impl_)
+        strand_service::add_ref(impl_);
+    }
+
+    implementation_type& operator=(const implementation_type& other)
+    {
+      strand_impl* old_impl = impl_;
+      impl_ = other.impl_;
+      if (impl_)
+        strand_service::add_ref(impl_);
+      if (old_impl)
+        strand_service::release(old_impl);
+      return *this;
+    }
+
+    ~implementation_type()
+    {
+      if (impl_)
+        strand_service::release(impl_);
+    }
+
+    operator strand_impl*() const
+    {
+      return impl_;
+    }
+
+    strand_impl* operator->() const
+    {
+      return impl_;
+    }
+
+  private:
+    friend class strand_service;
+    strand_impl* impl_;
+  };
+#else // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
   typedef strand_impl* implementation_type;
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 
   // Construct a new strand service for the specified io_context.
   ASIO_DECL explicit strand_service(asio::io_context& io_context);
 
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  // Destroy all implementations that are no longer in use.
+  ASIO_DECL ~strand_service();
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+
   // Destroy all user-defined handler objects owned by the service.
   ASIO_DECL void shutdown();
 
@@ -107,6 +179,26 @@ private:
       operation* base, const asio::error_code& ec,
       std::size_t bytes_transferred);
 
+  // Helper function to release the strand lock if there are no more handlers.
+  // Returns true if the lock is still held and the strand must be scheduled.
+  ASIO_DECL static bool push_waiting_to_ready(strand_impl* impl);
+
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  // Add a reference to an implementation.
+  static void add_ref(strand_impl* impl)
+  {
+    ref_count_up(impl->ref_count_);
+  }
+
+  // Release a reference to an implementation, returning it to the pool when
+  // there are no more references.
+  ASIO_DECL static void release(strand_impl* impl);
+
+  // Mutex to protect an implementation's pointer to its owning service, which
+  // is cleared when the service is destroyed.
+  ASIO_DECL static asio::detail::static_mutex& owner_mutex();
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+
   // The io_context used to obtain an I/O executor.
   io_context& io_context_;
 
@@ -116,15 +208,28 @@ private:
   // Mutex to protect access to the array of implementations.
   asio::detail::mutex mutex_;
 
-  // Number of implementations shared between all strand objects.
+  // Number of implementations shared between all strand objects or, when
+  // each strand has its own implementation, the maximum number of unused
+  // implementations that are kept for reuse.
 #if defined(ASIO_STRAND_IMPLEMENTATIONS)
   enum { num_implementations = ASIO_STRAND_IMPLEMENTATIONS };
 #else // defined(ASIO_STRAND_IMPLEMENTATIONS)
   enum { num_implementations = 193 };
 #endif // defined(ASIO_STRAND_IMPLEMENTATIONS)
 
+#if defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
+  // The head of a linked list of all implementations that are in use.
+  strand_impl* live_implementations_;
+
+  // The head of a linked list of unused implementations.
+  strand_impl* free_implementations_;
+
+  // The number of unused implementations.
+  std::size_t num_free_implementations_;
+#else // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
   // Pool of implementations.
   scoped_ptr<strand_impl> implementations_[num_implementations];
+#endif // defined(ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS)
 
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same strand implementation.
@@ -16,8 +16,15 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
-#include <climits>
 #include <cstddef>
+#if defined(ASIO_MSVC)
+# include <intrin.h>
+#endif // defined(ASIO_MSVC)
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+# include <atomic>
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+#include "asio/detail/arena_impl.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
 
@@ -37,83 +44,148 @@ namespace detail {
 # define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 2
 #endif // ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
 
-class thread_info_base
+#ifndef ASIO_COROUTINE_FRAME_CACHE_SIZE
+# define ASIO_COROUTINE_FRAME_CACHE_SIZE 16
+#endif // ASIO_COROUTINE_FRAME_CACHE_SIZE
+
+#ifndef ASIO_RECYCLING_ALLOCATOR_REMOTE_BATCH_SIZE
+# define ASIO_RECYCLING_ALLOCATOR_REMOTE_BATCH_SIZE 8
+#endif // ASIO_RECYCLING_ALLOCATOR_REMOTE_BATCH_SIZE
+
+// Settings and counters that are shared by the recycling allocator caches of
+// all threads running an execution context.
+class recycling_cache_control
   : private noncopyable
 {
 public:
-  struct default_tag
+  recycling_cache_control()
+    : depth_(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE),
+      hits_(0),
+      misses_(0)
   {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = 0,
-      end_mem_index = cache_size
-    };
-  };
+  }
 
-  struct awaitable_frame_tag
+  // Get the number of blocks cached per size class by each thread.
+  std::size_t depth() const
   {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = default_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
+    return depth_;
+  }
 
-  struct executor_function_tag
+  // Set the number of blocks cached per size class. Applies to threads that
+  // subsequently start running the execution context.
+  void depth(std::size_t d)
   {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = awaitable_frame_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
+    depth_ = d;
+  }
 
-  struct cancellation_signal_tag
+  // Get the number of allocations satisfied from a thread's cache.
+  long hits() const
   {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = executor_function_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
+    return hits_;
+  }
 
-  struct parallel_group_tag
+  // Get the number of allocations that could not be satisfied from a
+  // thread's cache.
+  long misses() const
   {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = cancellation_signal_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
+    return misses_;
+  }
+
+  // Add the counts from a thread that has stopped running the context.
+  void add_counts(long hits, long misses)
+  {
+    if (hits)
+      increment(hits_, hits);
+    if (misses)
+      increment(misses_, misses);
+  }
+
+private:
+  std::size_t depth_;
+  atomic_count hits_;
+  atomic_count misses_;
+};
 
-  enum { max_mem_index = parallel_group_tag::end_mem_index };
+class thread_info_base
+  : private noncopyable
+{
+public:
+  // Tags used to identify the purpose of an allocation.
+  struct default_tag {};
+  struct coroutine_frame_tag {};
+  typedef coroutine_frame_tag awaitable_frame_tag;
+  struct executor_function_tag {};
+  struct cancellation_signal_tag {};
+  struct parallel_group_tag {};
 
   thread_info_base()
+    : cache_control_(0),
+      cache_depth_(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE),
+      cache_hits_(0),
+      cache_misses_(0)
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+    , mailbox_(no_mailbox),
+      claim_failed_(false),
+      claim_failed_releases_(0),
+      remote_free_mailbox_(no_mailbox),
+      remote_free_head_(0),
+      remote_free_tail_(0),
+      remote_free_count_(0)
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
 #if defined(ASIO_HAS_STD_EXCEPTION_PTR) \
   && !defined(ASIO_NO_EXCEPTIONS)
-    : has_pending_exception_(0)
+    , has_pending_exception_(0)
 #endif // defined(ASIO_HAS_STD_EXCEPTION_PTR)
        // && !defined(ASIO_NO_EXCEPTIONS)
   {
-    for (int i = 0; i < max_mem_index; ++i)
+    for (int i = 0; i < num_size_classes; ++i)
+    {
       reusable_memory_[i] = 0;
+      reusable_count_[i] = 0;
+    }
+
+    for (int i = 0; i < num_frame_size_classes; ++i)
+    {
+      frame_memory_[i] = 0;
+      frame_count_[i] = 0;
+    }
   }
 
   ~thread_info_base()
   {
-    for (int i = 0; i < max_mem_index; ++i)
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+    flush_remote_frees();
+    release_mailbox();
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
+    for (int i = 0; i < num_size_classes; ++i)
     {
-      // The following test for non-null pointers is technically redundant, but
-      // it is significantly faster when using a tight io_context::poll() loop
-      // in latency sensitive applications.
-      if (reusable_memory_[i])
-        aligned_delete(reusable_memory_[i]);
+      while (void* const pointer = reusable_memory_[i])
+      {
+        reusable_memory_[i] = *static_cast<void**>(pointer);
+        aligned_delete(pointer);
+      }
     }
+
+    for (int i = 0; i < num_frame_size_classes; ++i)
+    {
+      while (void* const pointer = frame_memory_[i])
+      {
+        frame_memory_[i] = *static_cast<void**>(pointer);
+        aligned_delete(pointer);
+      }
+    }
+
+    if (cache_control_)
+      cache_control_->add_counts(cache_hits_, cache_misses_);
+  }
+
+  // Use the cache settings of the execution context that the thread is
+  // running, and report the cache counters back to it on destruction.
+  void attach_cache_control(recycling_cache_control& control)
+  {
+    cache_control_ = &control;
+    cache_depth_ = control.depth();
   }
 
   static void* allocate(thread_info_base* this_thread,
@@ -132,43 +204,60 @@ public:
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    // The size class and owning mailbox are stored in the two bytes following
+    // the requested size.
+    int size_class = (align <= ASIO_DEFAULT_ALIGN)
+      ? class_of(size + 2) : num_size_classes;
+    int owner = no_mailbox;
 
-    if (this_thread)
+    // Use the arena of the I/O object that is starting an operation, if any.
+    if (align <= ASIO_DEFAULT_ALIGN)
     {
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
+      if (arena_impl* a = arena_impl::current())
       {
-        if (this_thread->reusable_memory_[mem_index])
-        {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          unsigned char* const mem = static_cast<unsigned char*>(pointer);
-          if (static_cast<std::size_t>(mem[0]) >= chunks
-              && reinterpret_cast<std::size_t>(pointer) % align == 0)
-          {
-            this_thread->reusable_memory_[mem_index] = 0;
-            mem[size] = mem[0];
-            return pointer;
-          }
-        }
+        void* const pointer = a->allocate(size + 2);
+        unsigned char* const mem = static_cast<unsigned char*>(pointer);
+        mem[size] = static_cast<unsigned char>(num_size_classes);
+        mem[size + 1] = static_cast<unsigned char>(arena_block);
+        return pointer;
       }
+    }
 
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
+    if (this_thread)
+    {
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+      owner = this_thread->claim_mailbox();
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
+      if (size_class < num_size_classes)
       {
-        if (this_thread->reusable_memory_[mem_index])
+        void* pointer = this_thread->reusable_memory_[size_class];
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+        if (!pointer && this_thread->reclaim_remote_frees())
+          pointer = this_thread->reusable_memory_[size_class];
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+        if (pointer)
         {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          this_thread->reusable_memory_[mem_index] = 0;
-          aligned_delete(pointer);
-          break;
+          this_thread->reusable_memory_[size_class] =
+            *static_cast<void**>(pointer);
+          --this_thread->reusable_count_[size_class];
+          ++this_thread->cache_hits_;
+          unsigned char* const mem = static_cast<unsigned char*>(pointer);
+          mem[size] = static_cast<unsigned char>(size_class);
+          mem[size + 1] = static_cast<unsigned char>(owner);
+          return pointer;
         }
       }
+
+      ++this_thread->cache_misses_;
     }
 
-    void* const pointer = aligned_new(align, chunks * chunk_size + 1);
+    std::size_t block_size = (size_class < num_size_classes)
+      ? class_size(size_class) : size + 2;
+    void* const pointer = aligned_new(align, block_size);
     unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
+    mem[size] = static_cast<unsigned char>(size_class);
+    mem[size + 1] = static_cast<unsigned char>(owner);
     return pointer;
   }
 
@@ -176,22 +265,89 @@ public:
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    unsigned char* const mem = static_cast<unsigned char*>(pointer);
+    int size_class = mem[size];
+
+    if (mem[size + 1] == arena_block)
+    {
+      arena_impl::deallocate(pointer);
+      return;
+    }
+
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+    // Return blocks to the thread that allocated them, if it is still running.
+    int owner = mem[size + 1];
+    if (owner != no_mailbox && size_class < num_size_classes)
     {
       if (this_thread)
       {
-        for (int mem_index = Purpose::begin_mem_index;
-            mem_index < Purpose::end_mem_index; ++mem_index)
+        if (owner != this_thread->mailbox_)
         {
-          if (this_thread->reusable_memory_[mem_index] == 0)
-          {
-            unsigned char* const mem = static_cast<unsigned char*>(pointer);
-            mem[0] = mem[size];
-            this_thread->reusable_memory_[mem_index] = pointer;
-            return;
-          }
+          this_thread->defer_remote_free(pointer, size_class, owner);
+          return;
         }
       }
+      else
+      {
+        mem[sizeof(void*)] = static_cast<unsigned char>(size_class);
+        if (return_to_mailbox(owner, pointer, pointer))
+          return;
+      }
+    }
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
+    if (this_thread && size_class < num_size_classes)
+      if (this_thread->cache_block(pointer, size_class))
+        return;
+
+    aligned_delete(pointer);
+  }
+
+  // Coroutine frames are kept in a separate pool, with more size classes and
+  // a deeper cache, as a chain of nested coroutines holds several frames at
+  // once. Frames are not taken from an I/O object's arena, and are cached by
+  // whichever thread frees them.
+  static void* allocate(coroutine_frame_tag, thread_info_base* this_thread,
+      std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
+  {
+    // The size class is stored in the byte following the requested size.
+    int size_class = (align <= ASIO_DEFAULT_ALIGN)
+      ? class_of(size + 1, num_frame_size_classes) : num_frame_size_classes;
+
+    if (this_thread && size_class < num_frame_size_classes)
+    {
+      if (void* const pointer = this_thread->frame_memory_[size_class])
+      {
+        this_thread->frame_memory_[size_class] = *static_cast<void**>(pointer);
+        --this_thread->frame_count_[size_class];
+        ++this_thread->cache_hits_;
+        static_cast<unsigned char*>(pointer)[size] =
+          static_cast<unsigned char>(size_class);
+        return pointer;
+      }
+
+      ++this_thread->cache_misses_;
+    }
+
+    std::size_t block_size = (size_class < num_frame_size_classes)
+      ? class_size(size_class) : size + 1;
+    void* const pointer = aligned_new(align, block_size);
+    static_cast<unsigned char*>(pointer)[size] =
+      static_cast<unsigned char>(size_class);
+    return pointer;
+  }
+
+  static void deallocate(coroutine_frame_tag, thread_info_base* this_thread,
+      void* pointer, std::size_t size)
+  {
+    int size_class = static_cast<unsigned char*>(pointer)[size];
+    if (this_thread && size_class < num_frame_size_classes
+        && this_thread->frame_count_[size_class] < frame_cache_depth)
+    {
+      *static_cast<void**>(pointer) = this_thread->frame_memory_[size_class];
+      this_thread->frame_memory_[size_class] = pointer;
+      ++this_thread->frame_count_[size_class];
+      return;
     }
 
     aligned_delete(pointer);
@@ -237,12 +393,295 @@ public:
   }
 
 private:
-#if defined(ASIO_HAS_IO_URING)
-  enum { chunk_size = 8 };
-#else // defined(ASIO_HAS_IO_URING)
-  enum { chunk_size = 4 };
-#endif // defined(ASIO_HAS_IO_URING)
-  void* reusable_memory_[max_mem_index];
+  // Blocks are grouped into size classes with two classes per power of two,
+  // i.e. 32, 48, 64, 96, 128, ... bytes. Larger blocks are not cached.
+  enum { num_size_classes = 15 };
+
+  // Coroutine frames use the same size classes, up to 8192 bytes.
+  enum { num_frame_size_classes = 17 };
+
+  // The maximum number of unused coroutine frames kept for each size class.
+  enum { frame_cache_depth = ASIO_COROUTINE_FRAME_CACHE_SIZE };
+
+  // The number of mailboxes available for returning blocks to the threads
+  // that allocated them. The owner byte of a block is either a mailbox index,
+  // no_mailbox, or arena_block for blocks allocated from an I/O object's arena.
+  enum
+  {
+    num_mailboxes = 254,
+    no_mailbox = num_mailboxes,
+    arena_block = no_mailbox + 1
+  };
+
+  static std::size_t class_size(int size_class)
+  {
+    return static_cast<std::size_t>((size_class & 1) ? 48 : 32)
+      << (size_class >> 1);
+  }
+
+  static int class_of(std::size_t size,
+      int num_classes = num_size_classes)
+  {
+    if (size <= 32)
+      return 0;
+    if (size > class_size(num_classes - 1))
+      return num_classes;
+
+    // A size in the range (2^b, 2^(b+1)] belongs to the class of size 1.5*2^b
+    // when bit b-1 of size-1 is clear, and to the class of size 2^(b+1)
+    // otherwise.
+    unsigned int n = static_cast<unsigned int>(size - 1);
+    int b = highest_bit(n);
+    return 2 * b - 9 + static_cast<int>((n >> (b - 1)) & 1);
+  }
+
+  // Get the index of the most significant set bit of a non-zero value.
+  static int highest_bit(unsigned int n)
+  {
+#if defined(__GNUC__)
+    return static_cast<int>(sizeof(unsigned int) * 8 - 1) - __builtin_clz(n);
+#elif defined(ASIO_MSVC)
+    unsigned long index = 0;
+    _BitScanReverse(&index, n);
+    return static_cast<int>(index);
+#else // defined(ASIO_MSVC)
+    int b = 0;
+    for (int shift = 16; shift > 0; shift >>= 1)
+    {
+      if (n >> shift)
+      {
+        n >>= shift;
+        b += shift;
+      }
+    }
+    return b;
+#endif // defined(ASIO_MSVC)
+  }
+
+  // Add an unused block to the list for its size class, if there is room.
+  bool cache_block(void* pointer, int size_class,
+      std::size_t extra_depth = 0)
+  {
+    if (reusable_count_[size_class] < cache_depth_ + extra_depth)
+    {
+      *static_cast<void**>(pointer) = reusable_memory_[size_class];
+      reusable_memory_[size_class] = pointer;
+      ++reusable_count_[size_class];
+      return true;
+    }
+    return false;
+  }
+
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+  // Blocks freed by other threads are returned to the allocating thread
+  // through a mailbox. The mailbox index is stored in each block, and a
+  // thread claims a mailbox on its first allocation. When the owner exits it
+  // closes the mailbox by replacing the head with a sentinel, and frees the
+  // blocks it removed. A push that finds the mailbox closed fails, so no
+  // block can be left behind in a mailbox that nobody will drain.
+  struct mailbox
+  {
+    std::atomic<void*> head_;
+    std::atomic<bool> owned_;
+    char padding_[64];
+
+    // The head of a closed mailbox.
+    void* closed()
+    {
+      return this;
+    }
+  };
+
+  static mailbox* mailboxes()
+  {
+    static mailbox m[num_mailboxes];
+    return m;
+  }
+
+  // The number of times a mailbox has been given up.
+  static std::atomic<unsigned long>& mailbox_releases()
+  {
+    static std::atomic<unsigned long> n(0);
+    return n;
+  }
+
+  // Claim a mailbox for the thread, if it does not already have one. When all
+  // mailboxes are owned, the thread tries again only after one is given up.
+  int claim_mailbox()
+  {
+    if (mailbox_ == no_mailbox && cache_depth_ > 0)
+    {
+      unsigned long releases =
+        mailbox_releases().load(std::memory_order_acquire);
+      if (claim_failed_ && releases == claim_failed_releases_)
+        return mailbox_;
+
+      mailbox* m = mailboxes();
+      for (int i = 0; i < num_mailboxes; ++i)
+      {
+        if (!m[i].owned_.load(std::memory_order_relaxed)
+            && !m[i].owned_.exchange(true, std::memory_order_acquire))
+        {
+          m[i].head_.store(0, std::memory_order_relaxed);
+          mailbox_ = i;
+          claim_failed_ = false;
+          return mailbox_;
+        }
+      }
+
+      claim_failed_ = true;
+      claim_failed_releases_ = releases;
+    }
+    return mailbox_;
+  }
+
+  // Close the thread's mailbox, free any blocks waiting in it, and give it up
+  // for another thread to claim.
+  void release_mailbox()
+  {
+    if (mailbox_ == no_mailbox)
+      return;
+    mailbox& m = mailboxes()[mailbox_];
+    void* pointer = m.head_.exchange(m.closed(), std::memory_order_acquire);
+    while (pointer)
+    {
+      void* const next = *static_cast<void**>(pointer);
+      aligned_delete(pointer);
+      pointer = next;
+    }
+    m.owned_.store(false, std::memory_order_release);
+    mailbox_releases().fetch_add(1, std::memory_order_release);
+    mailbox_ = no_mailbox;
+  }
+
+  // Push a chain of blocks to a mailbox. Returns false if the mailbox has
+  // been closed, in which case the blocks must be disposed of by the caller.
+  static bool return_to_mailbox(int owner, void* head, void* tail)
+  {
+    mailbox& m = mailboxes()[owner];
+    void* next = m.head_.load(std::memory_order_relaxed);
+    do
+    {
+      if (next == m.closed())
+        return false;
+      *static_cast<void**>(tail) = next;
+    } while (!m.head_.compare_exchange_weak(next, head,
+          std::memory_order_release, std::memory_order_relaxed));
+    return true;
+  }
+
+  // Move the blocks returned by other threads into the thread's lists.
+  // Returns true if any blocks were returned.
+  bool reclaim_remote_frees()
+  {
+    if (mailbox_ == no_mailbox)
+      return false;
+    mailbox& m = mailboxes()[mailbox_];
+    if (!m.head_.load(std::memory_order_relaxed))
+      return false;
+    void* pointer = m.head_.exchange(0, std::memory_order_acquire);
+    while (pointer)
+    {
+      void* const next = *static_cast<void**>(pointer);
+      int size_class = static_cast<unsigned char*>(pointer)[sizeof(void*)];
+      if (!cache_block(pointer, size_class, remote_free_batch_size))
+        aligned_delete(pointer);
+      pointer = next;
+    }
+    return true;
+  }
+
+  // Add a block to the batch of blocks to be returned to another thread.
+  void defer_remote_free(void* pointer, int size_class, int owner)
+  {
+    if (owner != remote_free_mailbox_)
+    {
+      flush_remote_frees();
+      remote_free_mailbox_ = owner;
+    }
+
+    static_cast<unsigned char*>(pointer)[sizeof(void*)] =
+      static_cast<unsigned char>(size_class);
+    *static_cast<void**>(pointer) = remote_free_head_;
+    remote_free_head_ = pointer;
+    if (!remote_free_tail_)
+      remote_free_tail_ = pointer;
+
+    if (++remote_free_count_ >= remote_free_batch_size)
+      flush_remote_frees();
+  }
+
+  // Return the current batch of blocks to the thread that allocated them.
+  void flush_remote_frees()
+  {
+    if (!remote_free_head_)
+      return;
+
+    if (!return_to_mailbox(remote_free_mailbox_,
+          remote_free_head_, remote_free_tail_))
+    {
+      // The owner has stopped, so keep or free the blocks here.
+      *static_cast<void**>(remote_free_tail_) = 0;
+      void* pointer = remote_free_head_;
+      while (pointer)
+      {
+        void* const next = *static_cast<void**>(pointer);
+        int size_class = static_cast<unsigned char*>(pointer)[sizeof(void*)];
+        if (!cache_block(pointer, size_class))
+          aligned_delete(pointer);
+        pointer = next;
+      }
+    }
+
+    remote_free_head_ = 0;
+    remote_free_tail_ = 0;
+    remote_free_count_ = 0;
+  }
+
+  // The number of blocks freed by this thread that are batched together before
+  // being returned to the allocating thread.
+  enum { remote_free_batch_size = ASIO_RECYCLING_ALLOCATOR_REMOTE_BATCH_SIZE };
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
+  // The heads of the lists of unused blocks for each size class. Each unused
+  // block stores a pointer to the next block in the list.
+  void* reusable_memory_[num_size_classes];
+
+  // The number of unused blocks in each list.
+  std::size_t reusable_count_[num_size_classes];
+
+  // The heads of the lists of unused coroutine frames for each size class.
+  void* frame_memory_[num_frame_size_classes];
+
+  // The number of unused coroutine frames in each list.
+  std::size_t frame_count_[num_frame_size_classes];
+
+  // The settings and counters of the execution context being run, if any.
+  recycling_cache_control* cache_control_;
+
+  // The maximum number of unused blocks kept for each size class.
+  std::size_t cache_depth_;
+
+  // The number of allocations satisfied from, and not satisfied from, the
+  // unused blocks.
+  long cache_hits_;
+  long cache_misses_;
+
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+  // The mailbox through which other threads return blocks to this thread.
+  int mailbox_;
+
+  // Whether the last attempt to claim a mailbox found them all owned, and the
+  // number of mailboxes that had been given up at the time.
+  bool claim_failed_;
+  unsigned long claim_failed_releases_;
+
+  // The batch of blocks waiting to be returned to another thread's mailbox.
+  int remote_free_mailbox_;
+  void* remote_free_head_;
+  void* remote_free_tail_;
+  std::size_t remote_free_count_;
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
 
 #if defined(ASIO_HAS_STD_EXCEPTION_PTR) \
   && !defined(ASIO_NO_EXCEPTIONS)
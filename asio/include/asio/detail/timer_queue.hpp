@@ -31,6 +31,9 @@
 namespace asio {
 namespace detail {
 
+template <typename Clock, typename WaitTraits>
+struct chrono_time_traits;
+
 template <typename Time_Traits>
 class timer_queue
   : public timer_queue_base
@@ -68,7 +71,8 @@ public:
 
   // Constructor.
   timer_queue()
-    : timers_(),
+    : timer_queue_base(is_steady(static_cast<Time_Traits*>(0))),
+      timers_(),
       heap_()
   {
   }
@@ -97,6 +101,8 @@ public:
       }
 
       // Insert the new timer into the linked list of active timers.
+      if (timer.heap_index_ == 0 || timers_ == 0)
+        this->earliest_changed();
       timer.next_ = timers_;
       timer.prev_ = 0;
       if (timers_)
@@ -174,6 +180,7 @@ public:
     }
 
     heap_.clear();
+    this->earliest_changed();
   }
 
   // Cancel and dequeue operations for the given timer.
@@ -291,6 +298,8 @@ private:
   {
     // Remove the timer from the heap.
     std::size_t index = timer.heap_index_;
+    if (index == 0 || (timers_ == &timer && timer.next_ == 0))
+      this->earliest_changed();
     if (!heap_.empty() && index < heap_.size())
     {
       if (index == heap_.size() - 1)
@@ -337,6 +346,20 @@ private:
     return time.is_pos_infinity();
   }
 
+  // Determine if the traits use a steady clock.
+  template <typename Traits>
+  static bool is_steady(Traits*)
+  {
+    return false;
+  }
+
+  // Determine if the traits use a steady clock.
+  template <typename Clock, typename WaitTraits>
+  static bool is_steady(chrono_time_traits<Clock, WaitTraits>*)
+  {
+    return Clock::is_steady;
+  }
+
   // Helper function to convert a duration into milliseconds.
   template <typename Duration>
   long to_msec(const Duration& d, long max_duration) const
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
@@ -29,8 +30,19 @@ class timer_queue_base
   : private noncopyable
 {
 public:
-  // Constructor.
-  timer_queue_base() : next_(0) {}
+  // Constructor. A queue whose clock is not steady has its earliest deadline
+  // recalculated every time the set is consulted, since its clock may be
+  // adjusted at any time.
+  explicit timer_queue_base(bool steady = false)
+    : next_(0),
+      changed_list_(0),
+      changed_target_(this),
+      next_changed_(0),
+      changed_(false),
+      steady_(steady),
+      deadline_(0)
+  {
+  }
 
   // Destructor.
   virtual ~timer_queue_base() {}
@@ -50,11 +62,51 @@ public:
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
 
+protected:
+  // Notify the owning set that the earliest timer in the queue has changed,
+  // so that its cached deadline is recalculated.
+  void earliest_changed()
+  {
+    timer_queue_base* q = changed_target_;
+    if (q->changed_list_ && !q->changed_)
+    {
+      q->changed_ = true;
+      q->next_changed_ = *q->changed_list_;
+      *q->changed_list_ = q;
+    }
+  }
+
+  // Redirect change notifications from a queue that is used as the
+  // implementation of another queue.
+  static void forward_changes(timer_queue_base& from, timer_queue_base& to)
+  {
+    from.changed_target_ = &to;
+  }
+
 private:
   friend class timer_queue_set;
 
   // Next timer queue in the set.
   timer_queue_base* next_;
+
+  // The set's list of queues with changed deadlines, or null if the queue has
+  // not been added to a set.
+  timer_queue_base** changed_list_;
+
+  // The queue that receives change notifications.
+  timer_queue_base* changed_target_;
+
+  // Next timer queue in the set's list of changed queues.
+  timer_queue_base* next_changed_;
+
+  // Whether the queue is currently in the set's list of changed queues.
+  bool changed_;
+
+  // Whether the queue's clock is steady, so that its deadline may be cached.
+  bool steady_;
+
+  // The cached deadline of the earliest timer, as maintained by the set.
+  int64_t deadline_;
 };
 
 template <typename Time_Traits>
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <limits>
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/timer_queue_base.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -51,7 +53,42 @@ public:
   ASIO_DECL void get_all_timers(op_queue<operation>& ops);
 
 private:
+#if defined(ASIO_HAS_CHRONO)
+  // Queue deadlines are cached as absolute times on the steady clock, so that
+  // a queue is consulted only when its earliest timer changes or falls due.
+  // Only queues with a steady clock are cached in this way. To bound the
+  // effect of any difference in rate between the steady clock and the steady
+  // clock used by a queue, deadlines are never cached further ahead than this.
+  enum { max_cached_usec = 5 * 60 * 1000 * 1000 };
+
+  // The cached deadline used for queues that contain no timers.
+  static int64_t no_deadline()
+  {
+    return (std::numeric_limits<int64_t>::max)();
+  }
+
+  // Recalculate the cached deadlines of queues whose earliest timer has
+  // changed, and then the earliest deadline across all queues.
+  ASIO_DECL void update_earliest() const;
+
+  // Get the current time on the clock used for cached deadlines.
+  ASIO_DECL static int64_t now_usec();
+#endif // defined(ASIO_HAS_CHRONO)
+
+  // The head of a linked list of all timer queues.
   timer_queue_base* first_;
+
+  // The number of queues whose clock is not steady.
+  std::size_t unsteady_count_;
+
+  // The head of a linked list of queues with changed deadlines.
+  mutable timer_queue_base* first_changed_;
+
+  // Whether the earliest deadline must be recalculated from all queues.
+  mutable bool rescan_;
+
+  // The earliest cached deadline across all queues.
+  mutable int64_t earliest_;
 };
 
 } // namespace detail
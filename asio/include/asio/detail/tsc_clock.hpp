@@ -0,0 +1,167 @@
+//
+// detail/tsc_clock.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TSC_CLOCK_HPP
+#define ASIO_DETAIL_TSC_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#if defined(ASIO_HAS_TSC_CLOCK)
+# if defined(ASIO_MSVC)
+#  include <intrin.h>
+# else // defined(ASIO_MSVC)
+#  include <x86intrin.h>
+# endif // defined(ASIO_MSVC)
+#endif // defined(ASIO_HAS_TSC_CLOCK)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#ifndef ASIO_TSC_CLOCK_CALIBRATION_USEC
+# define ASIO_TSC_CLOCK_CALIBRATION_USEC 10000
+#endif // ASIO_TSC_CLOCK_CALIBRATION_USEC
+
+// A steady clock that reads the processor's time stamp counter and converts
+// it to nanoseconds. The counter frequency is calibrated against steady_clock
+// over the interval between static initialisation and the first use of the
+// clock. If the processor does not advertise an invariant time stamp counter,
+// the clock falls back to steady_clock.
+class tsc_clock
+{
+public:
+  typedef chrono::nanoseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef chrono::time_point<tsc_clock, duration> time_point;
+
+  ASIO_STATIC_CONSTEXPR(bool, is_steady = true);
+
+  // Get the current time.
+  static time_point now() ASIO_NOEXCEPT
+  {
+#if defined(ASIO_HAS_TSC_CLOCK)
+    const calibration& c = get_calibration();
+    if (c.invariant)
+    {
+      uint64_t ticks = read_counter();
+      if (ticks >= c.base_ticks)
+        return time_point(duration(c.base_ns
+              + static_cast<rep>(scale(ticks - c.base_ticks, c.scale))));
+      return time_point(duration(c.base_ns
+            - static_cast<rep>(scale(c.base_ticks - ticks, c.scale))));
+    }
+#endif // defined(ASIO_HAS_TSC_CLOCK)
+    return time_point(chrono::duration_cast<duration>(
+          chrono::steady_clock::now().time_since_epoch()));
+  }
+
+  // Determine whether the time stamp counter is used. Calling this function
+  // also completes the calibration, if it has not already been done.
+  static bool is_invariant() ASIO_NOEXCEPT
+  {
+#if defined(ASIO_HAS_TSC_CLOCK)
+    return get_calibration().invariant;
+#else // defined(ASIO_HAS_TSC_CLOCK)
+    return false;
+#endif // defined(ASIO_HAS_TSC_CLOCK)
+  }
+
+#if defined(ASIO_HAS_TSC_CLOCK)
+  struct sample
+  {
+    uint64_t ticks;
+    chrono::steady_clock::time_point time;
+  };
+
+  // Get the sample that starts the calibration interval. The first call,
+  // normally made during static initialisation, takes the sample.
+  static const sample& start_sample() ASIO_NOEXCEPT
+  {
+    static const sample s = take_sample();
+    return s;
+  }
+
+private:
+  struct calibration
+  {
+    bool invariant;
+    uint64_t base_ticks;
+    rep base_ns;
+    uint64_t scale; // Nanoseconds per tick as 32.32 fixed point.
+  };
+
+  static const calibration& get_calibration() ASIO_NOEXCEPT
+  {
+    static const calibration c = calibrate();
+    return c;
+  }
+
+  static uint64_t read_counter() ASIO_NOEXCEPT
+  {
+    return __rdtsc();
+  }
+
+  // Pair a steady_clock reading with the midpoint of two counter reads that
+  // bracket it.
+  static sample take_sample() ASIO_NOEXCEPT
+  {
+    uint64_t before = read_counter();
+    chrono::steady_clock::time_point time = chrono::steady_clock::now();
+    uint64_t after = read_counter();
+    sample s = { before + (after - before) / 2, time };
+    return s;
+  }
+
+  static uint64_t scale(uint64_t ticks, uint64_t factor) ASIO_NOEXCEPT
+  {
+#if defined(ASIO_MSVC)
+    uint64_t high = 0;
+    uint64_t low = _umul128(ticks, factor, &high);
+    return (high << 32) | (low >> 32);
+#else // defined(ASIO_MSVC)
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(ticks) * factor) >> 32);
+#endif // defined(ASIO_MSVC)
+  }
+
+  ASIO_DECL static calibration calibrate() ASIO_NOEXCEPT;
+#endif // defined(ASIO_HAS_TSC_CLOCK)
+};
+
+#if defined(ASIO_HAS_TSC_CLOCK)
+// Start the calibration interval during static initialisation, so that the
+// first call to now() rarely has to wait for the interval to elapse.
+static const tsc_clock::sample& tsc_clock_start_instance
+  = tsc_clock::start_sample();
+#endif // defined(ASIO_HAS_TSC_CLOCK)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/tsc_clock.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_DETAIL_TSC_CLOCK_HPP
@@ -215,6 +215,13 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the recycling allocator settings used by threads running the
+  // io_context.
+  recycling_cache_control& recycling_cache()
+  {
+    return recycling_cache_;
+  }
+
 private:
 #if defined(WINVER) && (WINVER < 0x0500)
   typedef DWORD dword_ptr_t;
@@ -326,6 +333,10 @@ private:
   // The concurrency hint used to initialise the io_context.
   const int concurrency_hint_;
 
+  // The recycling allocator settings and counters for threads running the
+  // io_context.
+  recycling_cache_control recycling_cache_;
+
   // The thread that is running the io_context.
   scoped_ptr<thread> thread_;
 };
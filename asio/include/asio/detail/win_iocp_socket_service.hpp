@@ -20,11 +20,16 @@
 #if defined(ASIO_HAS_IOCP)
 
 #include <cstring>
+#include <vector>
+#include "asio/datagram_slot.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/post.hpp"
 #include "asio/socket_base.hpp"
+#include "asio/detail/accept_batch_handler.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/datagram_slot_handler.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_invoke_helpers.hpp"
@@ -395,6 +400,29 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous send of a batch of datagrams. Windows cannot send
+  // more than one datagram per operation, so only the first slot is sent. The
+  // slots and the data being sent must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_send_batch(implementation_type& impl,
+      basic_datagram_slot<const_buffer, endpoint_type>* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (count == 0)
+    {
+      asio::post(io_ex, detail::bind_handler(
+            handler, asio::error_code(), std::size_t(0)));
+      return;
+    }
+
+    datagram_slot_handler<basic_datagram_slot<
+      const_buffer, endpoint_type>, Handler> handler2(slots, handler);
+    async_send_to(impl, slots[0].buffer(),
+        slots[0].endpoint(), flags, handler2, io_ex);
+  }
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -510,6 +538,53 @@ public:
     }
   }
 
+  // Receive a datagram, or a run of datagrams coalesced by generic receive
+  // offload. Not supported on Windows.
+  template <typename MutableBufferSequence>
+  std::size_t receive_coalesced(implementation_type&,
+      const MutableBufferSequence&, endpoint_type&, std::size_t&,
+      socket_base::message_flags, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous receive of a datagram, or a run of datagrams
+  // coalesced by generic receive offload. Not supported on Windows.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_coalesced(implementation_type&,
+      const MutableBufferSequence&, endpoint_type&, std::size_t&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(handler, ec, bytes_transferred));
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. Windows cannot
+  // receive more than one datagram per operation, so only the first slot is
+  // filled. The slots and the buffers they refer to must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_batch(implementation_type& impl,
+      basic_datagram_slot<mutable_buffer, endpoint_type>* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (count == 0)
+    {
+      asio::post(io_ex, detail::bind_handler(
+            handler, asio::error_code(), std::size_t(0)));
+      return;
+    }
+
+    datagram_slot_handler<basic_datagram_slot<
+      mutable_buffer, endpoint_type>, Handler> handler2(slots, handler);
+    async_receive_from(impl, slots[0].buffer(),
+        slots[0].endpoint(), flags, handler2, io_ex);
+  }
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type& impl, Socket& peer,
@@ -620,6 +695,31 @@ public:
         p.p->address_length(), o);
     p.v = p.p = 0;
   }
+
+  // Start an asynchronous accept of a batch of connections. Windows cannot
+  // accept more than one connection per operation, so at most one connection
+  // is accepted.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_move_accept_batch(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, std::size_t max_connections,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    typedef typename Protocol::socket::template
+      rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+    if (max_connections == 0)
+    {
+      asio::post(io_ex, detail::move_binder2<Handler,
+            asio::error_code, std::vector<peer_socket_type> >(0,
+              ASIO_MOVE_CAST(Handler)(handler), asio::error_code(),
+              std::vector<peer_socket_type>()));
+      return;
+    }
+
+    accept_batch_handler<peer_socket_type, Handler> handler2(handler);
+    async_move_accept(impl, peer_io_ex,
+        static_cast<endpoint_type*>(0), handler2, io_ex);
+  }
 #endif // defined(ASIO_HAS_MOVE)
 
   // Connect the socket to the specified endpoint.
@@ -38,6 +38,14 @@
 
 #include "asio/detail/push_options.hpp"
 
+// The size of the buffer used to hold a target executor within an any_executor
+// object. Larger executors are held in shared, heap-allocated storage. The
+// buffer is never smaller than the size of a shared_ptr plus a pointer, which
+// is the default.
+#if !defined(ASIO_ANY_EXECUTOR_INLINE_SIZE)
+# define ASIO_ANY_EXECUTOR_INLINE_SIZE 0
+#endif // !defined(ASIO_ANY_EXECUTOR_INLINE_SIZE)
+
 namespace asio {
 
 #if defined(GENERATING_DOCUMENTATION)
@@ -1300,8 +1308,14 @@ private:
 /*private:*/public:
 //  template <typename...> friend class any_executor;
 
-  typedef aligned_storage<
-      sizeof(asio::detail::shared_ptr<void>) + sizeof(void*),
+  enum
+  {
+    min_object_size = sizeof(asio::detail::shared_ptr<void>) + sizeof(void*),
+    object_size = ASIO_ANY_EXECUTOR_INLINE_SIZE > min_object_size
+      ? ASIO_ANY_EXECUTOR_INLINE_SIZE : min_object_size
+  };
+
+  typedef aligned_storage<object_size,
       alignment_of<asio::detail::shared_ptr<void> >::value
     >::type object_type;
 
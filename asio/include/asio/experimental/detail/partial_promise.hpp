@@ -15,6 +15,8 @@
 #include "asio/detail/config.hpp"
 #include "asio/append.hpp"
 #include "asio/awaitable.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/experimental/coro_traits.hpp"
 
 #if defined(ASIO_HAS_STD_COROUTINE)
@@ -68,6 +70,23 @@ struct partial_promise_base
 template <>
 struct partial_promise_base<std::allocator<void>>
 {
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  void* operator new(const std::size_t size)
+  {
+    return asio::detail::thread_info_base::allocate(
+        asio::detail::thread_info_base::coroutine_frame_tag(),
+        asio::detail::thread_context::top_of_thread_call_stack(),
+        size);
+  }
+
+  void operator delete(void* raw, const std::size_t size)
+  {
+    asio::detail::thread_info_base::deallocate(
+        asio::detail::thread_info_base::coroutine_frame_tag(),
+        asio::detail::thread_context::top_of_thread_call_stack(),
+        raw, size);
+  }
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
 };
 
 template <typename Allocator>
@@ -17,6 +17,8 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/cancellation_signal.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/utility.hpp"
 #include <tuple>
 
@@ -125,14 +127,18 @@ struct promise_impl<void(Ts...), Executor, Allocator>
     if (completion)
       cancel_();
 
+    // The default allocator is replaced by the coroutine frame pool.
+    using recycling_alloc_t = asio::detail::get_recycling_allocator<
+      typename asio::decay<Alloc>::type,
+      asio::detail::thread_info_base::coroutine_frame_tag>;
     using impl_t = completion_impl<
-      typename asio::decay<Alloc>::type, Handler>;
+      typename recycling_alloc_t::type, Handler>;
     using alloc_t = typename std::allocator_traits<
-      typename asio::decay<Alloc>::type>::template rebind_alloc<impl_t>;
+      typename recycling_alloc_t::type>::template rebind_alloc<impl_t>;
 
-    alloc_t alloc_{alloc};
+    alloc_t alloc_{recycling_alloc_t::get(alloc)};
     auto p = std::allocator_traits<alloc_t>::allocate(alloc_, 1u);
-    completion = new (p) impl_t(std::forward<Alloc>(alloc),
+    completion = new (p) impl_t(recycling_alloc_t::get(alloc),
         std::forward<Handler>(handler));
   }
 
@@ -185,7 +191,9 @@ struct promise_handler<void(Ts...), Executor, Allocator>
       Allocator allocator, Executor executor) // get_associated_allocator(exec)
     : impl_(
         std::allocate_shared<promise_impl<void(Ts...), Executor, Allocator>>(
-          allocator, allocator, executor))
+          asio::detail::get_recycling_allocator<Allocator,
+            asio::detail::thread_info_base::coroutine_frame_tag>::get(
+              allocator), allocator, executor))
   {
   }
 
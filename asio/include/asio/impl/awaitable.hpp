@@ -83,7 +83,7 @@ public:
   void* operator new(std::size_t size)
   {
     return asio::detail::thread_info_base::allocate(
-        asio::detail::thread_info_base::awaitable_frame_tag(),
+        asio::detail::thread_info_base::coroutine_frame_tag(),
         asio::detail::thread_context::top_of_thread_call_stack(),
         size);
   }
@@ -91,7 +91,7 @@ public:
   void operator delete(void* pointer, std::size_t size)
   {
     asio::detail::thread_info_base::deallocate(
-        asio::detail::thread_info_base::awaitable_frame_tag(),
+        asio::detail::thread_info_base::coroutine_frame_tag(),
         asio::detail::thread_context::top_of_thread_call_stack(),
         pointer, size);
   }
@@ -131,6 +131,21 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::set_recycling_allocator_cache_depth(std::size_t depth)
+{
+  impl_.recycling_cache().depth(depth);
+}
+
+io_context::count_type io_context::recycling_allocator_cache_hits() const
+{
+  return static_cast<count_type>(impl_.recycling_cache().hits());
+}
+
+io_context::count_type io_context::recycling_allocator_cache_misses() const
+{
+  return static_cast<count_type>(impl_.recycling_cache().misses());
+}
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
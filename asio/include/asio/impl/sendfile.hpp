@@ -0,0 +1,502 @@
+//
+// impl/sendfile.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SENDFILE_HPP
+#define ASIO_IMPL_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <vector>
+#include "asio/associator.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Wait until a descriptor has data to be read.
+  template <typename Executor, typename Handler>
+  inline void sendfile_source_wait(
+      posix::basic_stream_descriptor<Executor>& d,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    d.async_wait(posix::descriptor_base::wait_read,
+        ASIO_MOVE_CAST(Handler)(handler));
+  }
+
+  // Read the next block of data from a descriptor or stream-oriented file.
+  template <typename Source, typename Handler>
+  inline void sendfile_source_read(Source& s, uint64_t,
+      const asio::mutable_buffer& buffer,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    s.async_read_some(buffer, ASIO_MOVE_CAST(Handler)(handler));
+  }
+
+#if defined(ASIO_HAS_FILE)
+  // Files are always ready to be read.
+  template <typename Executor, typename Handler>
+  inline void sendfile_source_wait(basic_stream_file<Executor>& f,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    f.async_read_some(asio::mutable_buffer(),
+        ASIO_MOVE_CAST(Handler)(handler));
+  }
+
+  // Files are always ready to be read.
+  template <typename Executor, typename Handler>
+  inline void sendfile_source_wait(basic_random_access_file<Executor>& f,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    f.async_read_some_at(0, asio::mutable_buffer(),
+        ASIO_MOVE_CAST(Handler)(handler));
+  }
+
+  // Read the next block of data from a random-access file.
+  template <typename Executor, typename Handler>
+  inline void sendfile_source_read(basic_random_access_file<Executor>& f,
+      uint64_t offset, const asio::mutable_buffer& buffer,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    f.async_read_some_at(offset, buffer, ASIO_MOVE_CAST(Handler)(handler));
+  }
+#endif // defined(ASIO_HAS_FILE)
+
+  // Sends data from a source to a socket. The data is passed to the kernel
+  // using sendfile() if the source supports it, otherwise splice() if the
+  // source is a pipe. If neither is supported, the data is copied through a
+  // buffer using the source's and socket's asynchronous operations.
+  template <typename Socket, typename Source, typename WriteHandler>
+  class sendfile_op
+    : public base_from_cancellation_state<WriteHandler>
+  {
+  public:
+    sendfile_op(Socket& socket, Source& source, bool use_offset,
+        uint64_t offset, std::size_t length, WriteHandler& handler)
+      : base_from_cancellation_state<WriteHandler>(
+          handler, enable_partial_cancellation()),
+        socket_(socket),
+        source_(source),
+        use_offset_(use_offset),
+        offset_(offset),
+        length_(length),
+        total_transferred_(0),
+        state_(sendfile_state),
+        copy_size_(0),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    sendfile_op(const sendfile_op& other)
+      : base_from_cancellation_state<WriteHandler>(other),
+        socket_(other.socket_),
+        source_(other.source_),
+        use_offset_(other.use_offset_),
+        offset_(other.offset_),
+        length_(other.length_),
+        total_transferred_(other.total_transferred_),
+        state_(other.state_),
+        buffer_(other.buffer_),
+        copy_size_(other.copy_size_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    sendfile_op(sendfile_op&& other)
+      : base_from_cancellation_state<WriteHandler>(
+          ASIO_MOVE_CAST(base_from_cancellation_state<
+            WriteHandler>)(other)),
+        socket_(other.socket_),
+        source_(other.source_),
+        use_offset_(other.use_offset_),
+        offset_(other.offset_),
+        length_(other.length_),
+        total_transferred_(other.total_transferred_),
+        state_(other.state_),
+        buffer_(ASIO_MOVE_CAST(std::vector<unsigned char>)(other.buffer_)),
+        copy_size_(other.copy_size_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec)
+    {
+      (*this)(ec, 0, 0);
+    }
+
+    void operator()(asio::error_code ec,
+        std::size_t bytes_transferred, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        // The system calls block unless the socket is in non-blocking mode.
+        // The mode is left in place, as other operations may be using the
+        // socket concurrently.
+        if (!socket_.native_non_blocking())
+          socket_.native_non_blocking(true, ec);
+      }
+      else if (state_ == copy_read_state && !ec)
+      {
+        if (bytes_transferred == 0)
+          ec = asio::error::eof;
+        offset_ += bytes_transferred;
+        copy_size_ = bytes_transferred;
+        state_ = copy_write_state;
+      }
+      else if (state_ == copy_write_state)
+      {
+        total_transferred_ += bytes_transferred;
+        state_ = copy_read_state;
+      }
+
+      while (!ec && total_transferred_ < length_)
+      {
+        if (this->cancelled() != cancellation_type::none)
+        {
+          ec = error::operation_aborted;
+          break;
+        }
+
+        std::size_t max_size = length_ - total_transferred_;
+        std::size_t n = 0;
+        switch (state_)
+        {
+        case sendfile_state:
+          if (!socket_ops::non_blocking_sendfile(socket_.native_handle(),
+                source_.native_handle(), use_offset_ ? &offset_ : 0,
+                max_size, ec, n))
+          {
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+            socket_.async_wait(socket_base::wait_write,
+                ASIO_MOVE_CAST(sendfile_op)(*this));
+            return;
+          }
+          if (ec == asio::error::invalid_argument && total_transferred_ == 0)
+          {
+            // The source does not support sendfile(). A splice() from the
+            // source's current position would ignore the offset.
+            asio::error::clear(ec);
+            state_ = use_offset_ ? copy_read_state : splice_state;
+            continue;
+          }
+          break;
+
+        case splice_state:
+          if (!descriptor_ops::non_blocking_splice(source_.native_handle(),
+                socket_.native_handle(), max_size, ec, n))
+          {
+            // Either the pipe is empty or the socket is full. A socket that
+            // is ready for writing means that the pipe is empty.
+            asio::error_code poll_ec;
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+            if (socket_ops::poll_write(socket_.native_handle(),
+                  socket_ops::user_set_non_blocking, 0, poll_ec) > 0)
+              sendfile_source_wait(source_,
+                  ASIO_MOVE_CAST(sendfile_op)(*this));
+            else
+              socket_.async_wait(socket_base::wait_write,
+                  ASIO_MOVE_CAST(sendfile_op)(*this));
+            return;
+          }
+          if (ec == asio::error::invalid_argument && total_transferred_ == 0)
+          {
+            // The source is not a pipe.
+            asio::error::clear(ec);
+            state_ = copy_read_state;
+            continue;
+          }
+          break;
+
+        case copy_read_state:
+          {
+            if (buffer_.empty())
+              buffer_.resize(max_size < 65536 ? max_size : 65536);
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+            sendfile_source_read(source_, offset_, asio::buffer(buffer_,
+                  max_size < buffer_.size() ? max_size : buffer_.size()),
+                ASIO_MOVE_CAST(sendfile_op)(*this));
+          }
+          return;
+
+        default: // copy_write_state
+          {
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+            asio::async_write(socket_,
+                asio::buffer(buffer_, copy_size_),
+                ASIO_MOVE_CAST(sendfile_op)(*this));
+          }
+          return;
+        }
+
+        if (!ec && n == 0)
+          ec = asio::error::eof;
+        total_transferred_ += n;
+      }
+
+      if (start_ == 1)
+      {
+        // The operation completed without waiting, so the handler must not
+        // be invoked from within the initiating function.
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+        asio::post(socket_.get_executor(),
+            detail::bind_handler(ASIO_MOVE_CAST(sendfile_op)(*this), ec));
+        return;
+      }
+
+      ASIO_MOVE_OR_LVALUE(WriteHandler)(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    enum state_type
+    {
+      sendfile_state,
+      splice_state,
+      copy_read_state,
+      copy_write_state
+    };
+
+    Socket& socket_;
+    Source& source_;
+    bool use_offset_;
+    uint64_t offset_;
+    std::size_t length_;
+    std::size_t total_transferred_;
+    state_type state_;
+    std::vector<unsigned char> buffer_;
+    std::size_t copy_size_;
+    int start_;
+    WriteHandler handler_;
+  };
+
+  template <typename Socket, typename Source, typename WriteHandler>
+  inline asio_handler_allocate_is_deprecated
+  asio_handler_allocate(std::size_t size,
+      sendfile_op<Socket, Source, WriteHandler>* this_handler)
+  {
+#if defined(ASIO_NO_DEPRECATED)
+    asio_handler_alloc_helpers::allocate(size, this_handler->handler_);
+    return asio_handler_allocate_is_no_longer_used();
+#else // defined(ASIO_NO_DEPRECATED)
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Socket, typename Source, typename WriteHandler>
+  inline asio_handler_deallocate_is_deprecated
+  asio_handler_deallocate(void* pointer, std::size_t size,
+      sendfile_op<Socket, Source, WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Socket, typename Source, typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      sendfile_op<Socket, Source, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Socket,
+      typename Source, typename WriteHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(Function& function,
+      sendfile_op<Socket, Source, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Function, typename Socket,
+      typename Source, typename WriteHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(const Function& function,
+      sendfile_op<Socket, Source, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Socket>
+  class initiate_async_sendfile
+  {
+  public:
+    typedef typename Socket::executor_type executor_type;
+
+    explicit initiate_async_sendfile(Socket& socket)
+      : socket_(socket)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename WriteHandler, typename Source>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        Source* source, bool use_offset, uint64_t offset,
+        std::size_t length) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      non_const_lvalue<WriteHandler> handler2(handler);
+      sendfile_op<Socket, Source, typename decay<WriteHandler>::type>(
+          socket_, *source, use_offset, offset, length, handler2.value)(
+            asio::error_code(), 0, 1);
+    }
+
+  private:
+    Socket& socket_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Socket, typename Source, typename WriteHandler,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::sendfile_op<Socket, Source, WriteHandler>,
+    DefaultCandidate>
+  : Associator<WriteHandler, DefaultCandidate>
+{
+  static typename Associator<WriteHandler, DefaultCandidate>::type
+  get(const detail::sendfile_op<Socket, Source, WriteHandler>& h)
+    ASIO_NOEXCEPT
+  {
+    return Associator<WriteHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static ASIO_AUTO_RETURN_TYPE_PREFIX2(
+      typename Associator<WriteHandler, DefaultCandidate>::type)
+  get(const detail::sendfile_op<Socket, Source, WriteHandler>& h,
+      const DefaultCandidate& c) ASIO_NOEXCEPT
+    ASIO_AUTO_RETURN_TYPE_SUFFIX((
+      Associator<WriteHandler, DefaultCandidate>::get(h.handler_, c)))
+  {
+    return Associator<WriteHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_FILE)
+
+template <typename Protocol, typename Executor, typename FileExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken>
+inline ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    basic_random_access_file<FileExecutor>& f, uint64_t offset,
+    std::size_t length, ASIO_MOVE_ARG(WriteToken) token)
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<
+          basic_stream_socket<Protocol, Executor> > >(),
+        token, &f, true, offset, length)))
+{
+  return async_initiate<WriteToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_sendfile<
+        basic_stream_socket<Protocol, Executor> >(s),
+      token, &f, true, offset, length);
+}
+
+template <typename Protocol, typename Executor, typename FileExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken>
+inline ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    basic_stream_file<FileExecutor>& f, std::size_t length,
+    ASIO_MOVE_ARG(WriteToken) token)
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<
+          basic_stream_socket<Protocol, Executor> > >(),
+        token, &f, false, uint64_t(0), length)))
+{
+  return async_initiate<WriteToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_sendfile<
+        basic_stream_socket<Protocol, Executor> >(s),
+      token, &f, false, uint64_t(0), length);
+}
+
+#endif // defined(ASIO_HAS_FILE)
+
+template <typename Protocol, typename Executor, typename DescriptorExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken>
+inline ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<DescriptorExecutor>& d,
+    std::size_t length, ASIO_MOVE_ARG(WriteToken) token)
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<
+          basic_stream_socket<Protocol, Executor> > >(),
+        token, &d, false, uint64_t(0), length)))
+{
+  return async_initiate<WriteToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_sendfile<
+        basic_stream_socket<Protocol, Executor> >(s),
+      token, &d, false, uint64_t(0), length);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SENDFILE_HPP
@@ -0,0 +1,417 @@
+//
+// impl/splice.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SPLICE_HPP
+#define ASIO_IMPL_SPLICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <vector>
+#include "asio/associator.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/splice_pipe_pool.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Moves data from a source to a destination with splice(), through a pipe
+  // taken from the source's execution context. If either end does not support
+  // splice(), the data is copied through a buffer using the streams'
+  // asynchronous operations.
+  template <typename Source, typename Destination, typename SpliceHandler>
+  class splice_op
+    : public base_from_cancellation_state<SpliceHandler>
+  {
+  public:
+    splice_op(Source& source, Destination& destination,
+        std::size_t max_bytes, SpliceHandler& handler)
+      : base_from_cancellation_state<SpliceHandler>(
+          handler, enable_partial_cancellation()),
+        source_(source),
+        destination_(destination),
+        max_bytes_(max_bytes),
+        total_transferred_(0),
+        state_(splice_state),
+        pool_(0),
+        pipe_size_(0),
+        copy_size_(0),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(SpliceHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    splice_op(const splice_op& other)
+      : base_from_cancellation_state<SpliceHandler>(other),
+        source_(other.source_),
+        destination_(other.destination_),
+        max_bytes_(other.max_bytes_),
+        total_transferred_(other.total_transferred_),
+        state_(other.state_),
+        pool_(other.pool_),
+        pipe_(other.pipe_),
+        pipe_size_(other.pipe_size_),
+        buffer_(other.buffer_),
+        copy_size_(other.copy_size_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    splice_op(splice_op&& other)
+      : base_from_cancellation_state<SpliceHandler>(
+          ASIO_MOVE_CAST(base_from_cancellation_state<
+            SpliceHandler>)(other)),
+        source_(other.source_),
+        destination_(other.destination_),
+        max_bytes_(other.max_bytes_),
+        total_transferred_(other.total_transferred_),
+        state_(other.state_),
+        pool_(other.pool_),
+        pipe_(ASIO_MOVE_CAST(shared_ptr<splice_pipe>)(other.pipe_)),
+        pipe_size_(other.pipe_size_),
+        buffer_(ASIO_MOVE_CAST(std::vector<unsigned char>)(other.buffer_)),
+        copy_size_(other.copy_size_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(SpliceHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec)
+    {
+      (*this)(ec, 0, 0);
+    }
+
+    void operator()(asio::error_code ec,
+        std::size_t bytes_transferred, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        pool_ = &splice_pipe_pool::get(source_.get_executor());
+        pipe_ = pool_->acquire(ec);
+
+        // The system calls block unless the streams are in non-blocking mode.
+        // The mode is left in place, as other operations may be using the
+        // streams concurrently.
+        if (!ec && !source_.native_non_blocking())
+          source_.native_non_blocking(true, ec);
+        if (!ec && !destination_.native_non_blocking())
+          destination_.native_non_blocking(true, ec);
+      }
+      else if (state_ == copy_read_state && !ec)
+      {
+        if (bytes_transferred == 0)
+          ec = asio::error::eof;
+        copy_size_ = bytes_transferred;
+        state_ = copy_write_state;
+      }
+      else if (state_ == copy_write_state)
+      {
+        total_transferred_ += bytes_transferred;
+        state_ = copy_read_state;
+      }
+
+      while (!ec && total_transferred_ < max_bytes_)
+      {
+        if (this->cancelled() != cancellation_type::none)
+        {
+          ec = error::operation_aborted;
+          break;
+        }
+
+        std::size_t n = 0;
+        switch (state_)
+        {
+        case splice_state:
+          if (pipe_size_ == 0)
+          {
+            // Move data from the source into the pipe.
+            if (!descriptor_ops::non_blocking_splice(source_.native_handle(),
+                  pipe_->write_descriptor(), max_bytes_ - total_transferred_,
+                  ec, n))
+            {
+              ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+              source_.async_wait(Source::wait_read,
+                  ASIO_MOVE_CAST(splice_op)(*this));
+              return;
+            }
+            if (ec == asio::error::invalid_argument
+                && total_transferred_ == 0)
+            {
+              // The source does not support splice().
+              asio::error::clear(ec);
+              state_ = copy_read_state;
+              continue;
+            }
+            if (!ec && n == 0)
+              ec = asio::error::eof;
+            if (ec)
+              break;
+            pipe_size_ = n;
+          }
+
+          // Move data from the pipe to the destination.
+          if (!descriptor_ops::non_blocking_splice(pipe_->read_descriptor(),
+                destination_.native_handle(), pipe_size_, ec, n))
+          {
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+            destination_.async_wait(Destination::wait_write,
+                ASIO_MOVE_CAST(splice_op)(*this));
+            return;
+          }
+          if (ec == asio::error::invalid_argument
+              && total_transferred_ == 0)
+          {
+            // The destination does not support splice(). Take the data back
+            // out of the pipe and write it using a buffer.
+            buffer_.resize(pipe_size_ < 65536 ? 65536 : pipe_size_);
+            descriptor_ops::non_blocking_read1(pipe_->read_descriptor(),
+                &buffer_[0], pipe_size_, ec, copy_size_);
+            pipe_size_ = 0;
+            state_ = copy_write_state;
+            continue;
+          }
+          pipe_size_ -= n;
+          total_transferred_ += n;
+          break;
+
+        case copy_read_state:
+          {
+            std::size_t max_size = max_bytes_ - total_transferred_;
+            if (buffer_.empty())
+              buffer_.resize(max_size < 65536 ? max_size : 65536);
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+            source_.async_read_some(asio::buffer(buffer_,
+                  max_size < buffer_.size() ? max_size : buffer_.size()),
+                ASIO_MOVE_CAST(splice_op)(*this));
+          }
+          return;
+
+        default: // copy_write_state
+          {
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+            asio::async_write(destination_,
+                asio::buffer(buffer_, copy_size_),
+                ASIO_MOVE_CAST(splice_op)(*this));
+          }
+          return;
+        }
+      }
+
+      if (start_ == 1)
+      {
+        // The operation completed without waiting, so the handler must not
+        // be invoked from within the initiating function.
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+        asio::post(source_.get_executor(),
+            detail::bind_handler(ASIO_MOVE_CAST(splice_op)(*this), ec));
+        return;
+      }
+
+      // A pipe that still holds data is closed, discarding the data.
+      if (pipe_ && pipe_size_ == 0)
+        pool_->release(pipe_);
+      pipe_.reset();
+
+      ASIO_MOVE_OR_LVALUE(SpliceHandler)(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    enum state_type
+    {
+      splice_state,
+      copy_read_state,
+      copy_write_state
+    };
+
+    Source& source_;
+    Destination& destination_;
+    std::size_t max_bytes_;
+    std::size_t total_transferred_;
+    state_type state_;
+    splice_pipe_pool* pool_;
+    shared_ptr<splice_pipe> pipe_;
+    std::size_t pipe_size_;
+    std::vector<unsigned char> buffer_;
+    std::size_t copy_size_;
+    int start_;
+    SpliceHandler handler_;
+  };
+
+  template <typename Source, typename Destination, typename SpliceHandler>
+  inline asio_handler_allocate_is_deprecated
+  asio_handler_allocate(std::size_t size,
+      splice_op<Source, Destination, SpliceHandler>* this_handler)
+  {
+#if defined(ASIO_NO_DEPRECATED)
+    asio_handler_alloc_helpers::allocate(size, this_handler->handler_);
+    return asio_handler_allocate_is_no_longer_used();
+#else // defined(ASIO_NO_DEPRECATED)
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Source, typename Destination, typename SpliceHandler>
+  inline asio_handler_deallocate_is_deprecated
+  asio_handler_deallocate(void* pointer, std::size_t size,
+      splice_op<Source, Destination, SpliceHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Source, typename Destination, typename SpliceHandler>
+  inline bool asio_handler_is_continuation(
+      splice_op<Source, Destination, SpliceHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Source,
+      typename Destination, typename SpliceHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(Function& function,
+      splice_op<Source, Destination, SpliceHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Function, typename Source,
+      typename Destination, typename SpliceHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(const Function& function,
+      splice_op<Source, Destination, SpliceHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Source>
+  class initiate_async_splice
+  {
+  public:
+    typedef typename Source::executor_type executor_type;
+
+    explicit initiate_async_splice(Source& source)
+      : source_(source)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return source_.get_executor();
+    }
+
+    template <typename SpliceHandler, typename Destination>
+    void operator()(ASIO_MOVE_ARG(SpliceHandler) handler,
+        Destination* destination, std::size_t max_bytes) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(SpliceHandler, handler) type_check;
+
+      non_const_lvalue<SpliceHandler> handler2(handler);
+      splice_op<Source, Destination, typename decay<SpliceHandler>::type>(
+          source_, *destination, max_bytes, handler2.value)(
+            asio::error_code(), 0, 1);
+    }
+
+  private:
+    Source& source_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Source, typename Destination, typename SpliceHandler,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::splice_op<Source, Destination, SpliceHandler>,
+    DefaultCandidate>
+  : Associator<SpliceHandler, DefaultCandidate>
+{
+  static typename Associator<SpliceHandler, DefaultCandidate>::type
+  get(const detail::splice_op<Source, Destination, SpliceHandler>& h)
+    ASIO_NOEXCEPT
+  {
+    return Associator<SpliceHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static ASIO_AUTO_RETURN_TYPE_PREFIX2(
+      typename Associator<SpliceHandler, DefaultCandidate>::type)
+  get(const detail::splice_op<Source, Destination, SpliceHandler>& h,
+      const DefaultCandidate& c) ASIO_NOEXCEPT
+    ASIO_AUTO_RETURN_TYPE_SUFFIX((
+      Associator<SpliceHandler, DefaultCandidate>::get(h.handler_, c)))
+  {
+    return Associator<SpliceHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename SpliceSource, typename SpliceDestination,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceToken>
+inline ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(SpliceToken,
+    void (asio::error_code, std::size_t))
+async_splice(SpliceSource& s, SpliceDestination& d, std::size_t max_bytes,
+    ASIO_MOVE_ARG(SpliceToken) token)
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<SpliceToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_splice<SpliceSource> >(),
+        token, &d, max_bytes)))
+{
+  return async_initiate<SpliceToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_splice<SpliceSource>(s),
+      token, &d, max_bytes);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SPLICE_HPP
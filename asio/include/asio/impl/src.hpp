@@ -33,9 +33,11 @@
 #include "asio/impl/serial_port_base.ipp"
 #include "asio/impl/system_context.ipp"
 #include "asio/impl/thread_pool.ipp"
+#include "asio/detail/impl/arena_impl.ipp"
 #include "asio/detail/impl/buffer_sequence_adapter.ipp"
 #include "asio/detail/impl/descriptor_ops.ipp"
 #include "asio/detail/impl/dev_poll_reactor.ipp"
+#include "asio/detail/impl/double_mapped_memory.ipp"
 #include "asio/detail/impl/epoll_reactor.ipp"
 #include "asio/detail/impl/eventfd_select_interrupter.ipp"
 #include "asio/detail/impl/handler_tracking.ipp"
@@ -60,12 +62,15 @@
 #include "asio/detail/impl/signal_set_service.ipp"
 #include "asio/detail/impl/socket_ops.ipp"
 #include "asio/detail/impl/socket_select_interrupter.ipp"
+#include "asio/detail/impl/splice_pipe.ipp"
+#include "asio/detail/impl/splice_pipe_pool.ipp"
 #include "asio/detail/impl/strand_executor_service.ipp"
 #include "asio/detail/impl/strand_service.ipp"
 #include "asio/detail/impl/thread_context.ipp"
 #include "asio/detail/impl/throw_error.ipp"
 #include "asio/detail/impl/timer_queue_ptime.ipp"
 #include "asio/detail/impl/timer_queue_set.ipp"
+#include "asio/detail/impl/tsc_clock.ipp"
 #include "asio/detail/impl/win_iocp_file_service.ipp"
 #include "asio/detail/impl/win_iocp_handle_service.ipp"
 #include "asio/detail/impl/win_iocp_io_context.ipp"
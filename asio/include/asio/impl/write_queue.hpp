@@ -0,0 +1,378 @@
+//
+// impl/write_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_WRITE_QUEUE_HPP
+#define ASIO_IMPL_WRITE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/wait_handler.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Starts the queue's write operations, and handles their completion.
+  template <typename AsyncWriteStream>
+  class write_queue_handler
+  {
+  public:
+    explicit write_queue_handler(write_queue<AsyncWriteStream>* queue)
+      : queue_(queue)
+    {
+    }
+
+    void operator()()
+    {
+      queue_->start_write();
+    }
+
+    void operator()(const asio::error_code& ec, std::size_t)
+    {
+      queue_->write_complete(ec);
+    }
+
+  private:
+    write_queue<AsyncWriteStream>* queue_;
+  };
+
+  template <typename AsyncWriteStream>
+  class initiate_async_write_queue_push
+  {
+  public:
+    typedef typename write_queue<AsyncWriteStream>::executor_type
+      executor_type;
+
+    explicit initiate_async_write_queue_push(
+        write_queue<AsyncWriteStream>& queue)
+      : queue_(queue)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return queue_.get_executor();
+    }
+
+    template <typename PushHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(PushHandler) handler,
+        const ConstBufferSequence& message) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a PushHandler.
+      ASIO_WAIT_HANDLER_CHECK(PushHandler, handler) type_check;
+
+      typedef typename decay<PushHandler>::type handler_type;
+      non_const_lvalue<PushHandler> handler2(handler);
+
+      asio::error_code ec;
+      {
+        detail::mutex::scoped_lock lock(queue_.mutex_);
+        if (queue_.error_)
+          ec = queue_.error_;
+        else
+        {
+          // The handler is called once the message has been written.
+          // Ownership of the handler passes to the queue.
+          typedef wait_handler<handler_type, executor_type> op;
+          typename op::ptr p = { asio::detail::addressof(handler2.value),
+            op::ptr::allocate(handler2.value), 0 };
+          p.p = new (p.v) op(handler2.value, queue_.get_executor());
+
+          bool start = false;
+          if (queue_.held_ops_.empty() && queue_.has_room())
+            start = queue_.enqueue(message, p.p);
+          else
+          {
+            // Hold the message back until there is room in the queue.
+            queue_.held_counts_.push_back(
+                queue_.add_buffers(message, queue_.held_buffers_));
+            queue_.held_ops_.push(p.p);
+          }
+          p.v = p.p = 0;
+          lock.unlock();
+
+          if (start)
+            asio::post(queue_.get_executor(),
+                write_queue_handler<AsyncWriteStream>(&queue_));
+          return;
+        }
+      }
+
+      asio::post(queue_.get_executor(),
+          detail::bind_handler(
+            ASIO_MOVE_CAST(handler_type)(handler2.value), ec));
+    }
+
+  private:
+    write_queue<AsyncWriteStream>& queue_;
+  };
+} // namespace detail
+
+template <typename AsyncWriteStream>
+write_queue<AsyncWriteStream>::~write_queue()
+{
+  while (detail::wait_op* op = pending_ops_.front())
+  {
+    pending_ops_.pop();
+    op->destroy();
+  }
+
+  while (detail::wait_op* op = held_ops_.front())
+  {
+    held_ops_.pop();
+    op->destroy();
+  }
+}
+
+template <typename AsyncWriteStream>
+std::size_t write_queue<AsyncWriteStream>::queued_bytes() const
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  return queued_bytes_;
+}
+
+template <typename AsyncWriteStream>
+std::size_t write_queue<AsyncWriteStream>::queued_messages() const
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  return queued_messages_;
+}
+
+template <typename AsyncWriteStream>
+template <typename ConstBufferSequence>
+bool write_queue<AsyncWriteStream>::try_push(
+    const ConstBufferSequence& message)
+{
+  bool start = false;
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    if (error_ || !held_ops_.empty() || !has_room())
+      return false;
+    start = enqueue_copy(message);
+  }
+
+  if (start)
+    asio::post(get_executor(),
+        detail::write_queue_handler<AsyncWriteStream>(this));
+
+  return true;
+}
+
+template <typename AsyncWriteStream>
+template <typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code)) PushToken>
+ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(PushToken,
+    void (asio::error_code))
+write_queue<AsyncWriteStream>::async_push(
+    const ConstBufferSequence& message,
+    ASIO_MOVE_ARG(PushToken) token)
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<PushToken, void (asio::error_code)>(
+        declval<detail::initiate_async_write_queue_push<
+          AsyncWriteStream> >(), token, message)))
+{
+  return async_initiate<PushToken, void (asio::error_code)>(
+      detail::initiate_async_write_queue_push<AsyncWriteStream>(*this),
+      token, message);
+}
+
+template <typename AsyncWriteStream>
+template <typename ConstBufferSequence, typename List>
+std::size_t write_queue<AsyncWriteStream>::add_buffers(
+    const ConstBufferSequence& message, List& list)
+{
+  return add_buffers(asio::buffer_sequence_begin(message),
+      asio::buffer_sequence_end(message), list);
+}
+
+template <typename AsyncWriteStream>
+template <typename Iterator, typename List>
+std::size_t write_queue<AsyncWriteStream>::add_buffers(
+    Iterator iter, Iterator end, List& list)
+{
+  std::size_t count = 0;
+  for (; iter != end; ++iter)
+  {
+    asio::const_buffer buffer(*iter);
+    if (buffer.size() > 0)
+    {
+      message_buffer b = { buffer.data(), 0, buffer.size() };
+      list.push_back(b);
+      ++count;
+    }
+  }
+  return count;
+}
+
+template <typename AsyncWriteStream>
+template <typename ConstBufferSequence>
+bool write_queue<AsyncWriteStream>::enqueue_copy(
+    const ConstBufferSequence& message)
+{
+  std::size_t size = asio::buffer_size(message);
+  if (size > 0)
+  {
+    std::size_t offset = pending_copies_.size();
+    message_buffer b = { 0, offset, size };
+    pending_buffers_.push_back(b);
+    pending_copies_.resize(offset + size);
+    asio::buffer_copy(asio::buffer(&pending_copies_[offset], size), message);
+  }
+
+  queued_bytes_ += size;
+  ++queued_messages_;
+
+  if (writing_)
+    return false;
+  writing_ = true;
+  return true;
+}
+
+template <typename AsyncWriteStream>
+template <typename ConstBufferSequence>
+bool write_queue<AsyncWriteStream>::enqueue(
+    const ConstBufferSequence& message, detail::wait_op* op)
+{
+  add_buffers(message, pending_buffers_);
+  pending_ops_.push(op);
+  queued_bytes_ += asio::buffer_size(message);
+  ++queued_messages_;
+
+  if (writing_)
+    return false;
+  writing_ = true;
+  return true;
+}
+
+template <typename AsyncWriteStream>
+void write_queue<AsyncWriteStream>::enqueue_held()
+{
+  while (detail::wait_op* op = held_ops_.front())
+  {
+    if (!has_room())
+      break;
+
+    std::size_t count = held_counts_.front();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      queued_bytes_ += held_buffers_.front().size_;
+      pending_buffers_.push_back(held_buffers_.front());
+      held_buffers_.pop_front();
+    }
+    held_counts_.pop_front();
+    held_ops_.pop();
+    pending_ops_.push(op);
+    ++queued_messages_;
+  }
+}
+
+template <typename AsyncWriteStream>
+void write_queue<AsyncWriteStream>::take_pending()
+{
+  // No write is outstanding, so all queued messages are pending.
+  writing_copies_.swap(pending_copies_);
+  writing_ops_.push(pending_ops_);
+  writing_bytes_ = queued_bytes_;
+  writing_messages_ = queued_messages_;
+
+  writing_buffers_.reserve(pending_buffers_.size());
+  for (std::size_t i = 0; i < pending_buffers_.size(); ++i)
+  {
+    const message_buffer& b = pending_buffers_[i];
+    writing_buffers_.push_back(asio::const_buffer(
+          b.data_ ? b.data_ : &writing_copies_[b.offset_], b.size_));
+  }
+  pending_buffers_.clear();
+}
+
+template <typename AsyncWriteStream>
+void write_queue<AsyncWriteStream>::start_write()
+{
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    take_pending();
+  }
+
+  asio::async_write(next_layer_, writing_buffers_,
+      detail::write_queue_handler<AsyncWriteStream>(this));
+}
+
+template <typename AsyncWriteStream>
+void write_queue<AsyncWriteStream>::write_complete(
+    const asio::error_code& ec)
+{
+  detail::op_queue<detail::wait_op> ops;
+  bool more = false;
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+
+    queued_bytes_ -= writing_bytes_;
+    queued_messages_ -= writing_messages_;
+    writing_buffers_.clear();
+    writing_copies_.clear();
+    writing_bytes_ = 0;
+    writing_messages_ = 0;
+    ops.push(writing_ops_);
+
+    if (ec)
+    {
+      // Discard the unwritten messages and fail all waiting pushes.
+      error_ = ec;
+      pending_buffers_.clear();
+      pending_copies_.clear();
+      held_buffers_.clear();
+      held_counts_.clear();
+      ops.push(pending_ops_);
+      ops.push(held_ops_);
+      queued_bytes_ = 0;
+      queued_messages_ = 0;
+    }
+    else
+      enqueue_held();
+
+    if (queued_messages_ == 0)
+      writing_ = false;
+    else
+    {
+      take_pending();
+      more = true;
+    }
+  }
+
+  if (more)
+  {
+    asio::async_write(next_layer_, writing_buffers_,
+        detail::write_queue_handler<AsyncWriteStream>(this));
+  }
+
+  while (detail::wait_op* op = ops.front())
+  {
+    ops.pop();
+    op->ec_ = ec;
+    op->complete(this, ec, 0);
+  }
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_WRITE_QUEUE_HPP
@@ -523,6 +523,36 @@ public:
    */
   ASIO_DECL void restart();
 
+  /// Set the depth of the per-thread caches used to recycle handler memory.
+  /**
+   * Each thread that runs the io_context caches the memory of completed
+   * handlers for reuse by subsequent operations. Cached blocks are grouped
+   * into size classes, and this function sets the maximum number of blocks
+   * that each thread keeps for each size class. A depth of zero disables
+   * caching. The default is given by @c ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE.
+   *
+   * The new depth applies to subsequent invocations of the run(), run_one(),
+   * poll() or poll_one() functions. This function must not be called while
+   * there are any unfinished calls to these functions.
+   */
+  ASIO_DECL void set_recycling_allocator_cache_depth(std::size_t depth);
+
+  /// Get the number of handler memory allocations satisfied from the
+  /// per-thread caches.
+  /**
+   * The count includes only those invocations of the run(), run_one(), poll()
+   * or poll_one() functions that have returned.
+   */
+  ASIO_DECL count_type recycling_allocator_cache_hits() const;
+
+  /// Get the number of handler memory allocations that could not be satisfied
+  /// from the per-thread caches.
+  /**
+   * The count includes only those invocations of the run(), run_one(), poll()
+   * or poll_one() functions that have returned.
+   */
+  ASIO_DECL count_type recycling_allocator_cache_misses() const;
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
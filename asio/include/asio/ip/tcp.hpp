@@ -125,6 +125,79 @@ public:
     ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NODELAY)> no_delay;
 #endif
 
+#if defined(ASIO_HAS_TCP_FASTOPEN) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to enable TCP Fast Open on a listening socket.
+  /**
+   * Implements the IPPROTO_TCP/TCP_FASTOPEN socket option. The value is the
+   * maximum number of pending Fast Open connections, and must be set on the
+   * acceptor before it starts listening. A client that presents a valid
+   * cookie may then send data in its SYN, and the data is available to read
+   * as soon as the connection is accepted.
+   *
+   * @par Example
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.open(endpoint.protocol());
+   * acceptor.set_option(asio::ip::tcp::fast_open(16));
+   * acceptor.bind(endpoint);
+   * acceptor.listen();
+   * @endcode
+   *
+   * @note Available on Linux only. The server side must also be enabled in
+   * the net.ipv4.tcp_fastopen sysctl.
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined fast_open;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_FASTOPEN)> fast_open;
+#endif
+
+  /// Socket option to connect using TCP Fast Open.
+  /**
+   * Implements the IPPROTO_TCP/TCP_FASTOPEN_CONNECT socket option. When the
+   * option is set and a Fast Open cookie for the server is known, a connect
+   * operation completes immediately without sending anything. The SYN is then
+   * sent, together with the data, by the first write operation on the socket.
+   * Otherwise a normal handshake is performed, and the cookie is obtained for
+   * later connections.
+   *
+   * @par Example
+   * Sending a request in the SYN:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * socket.open(asio::ip::tcp::v4());
+   * socket.set_option(asio::ip::tcp::fast_open_connect(true));
+   * socket.async_connect(endpoint,
+   *     [&](asio::error_code ec)
+   *     {
+   *       if (!ec)
+   *         asio::async_write(socket, asio::buffer(request), handler);
+   *     });
+   * @endcode
+   *
+   * @note Available on Linux only. The client side must also be enabled in
+   * the net.ipv4.tcp_fastopen sysctl, which is the default. Errors from the
+   * handshake are reported by the first write operation rather than by the
+   * connect operation.
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined fast_open_connect;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_FASTOPEN_CONNECT)>
+      fast_open_connect;
+#endif
+#endif // defined(ASIO_HAS_TCP_FASTOPEN) || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const tcp& p1, const tcp& p2)
   {
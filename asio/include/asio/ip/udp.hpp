@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/basic_datagram_socket.hpp"
+#include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_endpoint.hpp"
 #include "asio/ip/basic_resolver.hpp"
@@ -81,6 +82,67 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+#if defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for UDP generic segmentation offload.
+  /**
+   * Implements the IPPROTO_UDP/UDP_SEGMENT socket option. When the option is
+   * set to a non-zero segment size, the kernel splits each buffer passed to a
+   * send operation into datagrams of that size. Only the last datagram may be
+   * shorter. This allows many datagrams to be sent with one system call.
+   *
+   * @par Example
+   * Sending 16 datagrams of 1200 bytes each with one operation:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * socket.set_option(asio::ip::udp::segment_size(1200));
+   * socket.send_to(asio::buffer(data, 16 * 1200), destination);
+   * @endcode
+   *
+   * @note Available on Linux only.
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_UDP), ASIO_OS_DEF(UDP_SEGMENT)> segment_size;
+#endif
+#endif // defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_UDP_GRO) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for UDP generic receive offload.
+  /**
+   * Implements the IPPROTO_UDP/UDP_GRO socket option. When the option is set,
+   * the kernel may coalesce consecutive datagrams from the same sender into a
+   * single receive. Use basic_datagram_socket::receive_coalesced() or
+   * basic_datagram_socket::async_receive_coalesced() to obtain the size of
+   * the individual datagrams.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::generic_receive_offload option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @note Available on Linux only.
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined generic_receive_offload;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_UDP), ASIO_OS_DEF(UDP_GRO)> generic_receive_offload;
+#endif
+#endif // defined(ASIO_HAS_UDP_GRO) || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
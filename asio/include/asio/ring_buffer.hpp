@@ -0,0 +1,639 @@
+//
+// ring_buffer.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RING_BUFFER_HPP
+#define ASIO_RING_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include "asio/buffer.hpp"
+#include "asio/detail/array.hpp"
+#include "asio/detail/double_mapped_memory.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A circular buffer of bytes.
+/**
+ * The @c ring_buffer class holds a sequence of bytes in a circular region of
+ * memory. Bytes are appended at the end of the sequence and consumed from the
+ * beginning without moving the bytes that remain, so that a buffer that is
+ * repeatedly filled and partially consumed, as when reading a pipelined
+ * protocol, never copies data. The memory is reallocated only when the size
+ * of the sequence exceeds the capacity.
+ *
+ * A range of bytes that wraps around the end of the memory is represented as
+ * two buffers. Alternatively, a ring buffer may be constructed with the @c
+ * double_mapped mapping type, where supported by the operating system. The
+ * memory is then mapped twice at adjacent addresses, and every range of bytes
+ * is represented as a single contiguous buffer.
+ *
+ * A @c ring_buffer is used with I/O operations by way of the @c
+ * dynamic_ring_buffer class, which is returned by the asio::dynamic_buffer
+ * function.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Examples
+ * Reading newline-delimited messages from a socket:
+ * @code
+ * asio::ring_buffer b;
+ * for (;;)
+ * {
+ *   std::size_t n = asio::read_until(sock, asio::dynamic_buffer(b), '\n');
+ *   process_message(b.data(0, n));
+ *   b.consume(n);
+ * }
+ * @endcode
+ */
+class ring_buffer
+  : private noncopyable
+{
+public:
+#if defined(GENERATING_DOCUMENTATION)
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef implementation_defined const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef implementation_defined mutable_buffers_type;
+#else
+  typedef detail::array<const_buffer, 2> const_buffers_type;
+  typedef detail::array<mutable_buffer, 2> mutable_buffers_type;
+#endif
+
+  /// The ways in which the underlying memory may be mapped.
+  enum mapping_type
+  {
+    /// The memory is mapped once. A range of bytes that wraps around the end
+    /// of the memory is represented as two buffers.
+    single_mapped,
+
+    /// The memory is mapped twice, at adjacent addresses, so that every range
+    /// of bytes is represented as a single buffer. The capacity is rounded up
+    /// to a multiple of the page size.
+    double_mapped
+  };
+
+  /// Construct a ring buffer.
+  /**
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   *
+   * @param mapping Specifies how the underlying memory is to be mapped.
+   *
+   * @throws asio::system_error Thrown on failure. The error
+   * asio::error::operation_not_supported indicates that the @c
+   * double_mapped mapping type is not supported on the current platform.
+   */
+  explicit ring_buffer(
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)(),
+      mapping_type mapping = single_mapped)
+    : data_(0),
+      capacity_(0),
+      begin_(0),
+      size_(0),
+      max_size_(maximum_size),
+      mapping_(mapping)
+  {
+    if (mapping_ == double_mapped)
+      reallocate(detail::double_mapped_memory::granularity());
+  }
+
+  /// Destructor.
+  ~ring_buffer()
+  {
+    deallocate(data_, capacity_);
+  }
+
+  /// Get the number of bytes in the buffer.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the maximum size of the buffer.
+  std::size_t max_size() const ASIO_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// Get the maximum size that the buffer may grow to without triggering
+  /// reallocation.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return (std::min)(capacity_, max_size_);
+  }
+
+  /// Get the way in which the underlying memory is mapped.
+  mapping_type mapping() const ASIO_NOEXCEPT
+  {
+    return mapping_;
+  }
+
+  /// Get a sequence of buffers that represents the bytes in the buffer.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * buffer is shorter, the buffer sequence represents as many bytes as are
+   * available.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements. The sequence contains two buffers,
+   * the second of which is empty unless the bytes wrap around the end of the
+   * underlying memory.
+   *
+   * @note The returned object is invalidated by any @c ring_buffer member
+   * function that grows the buffer or consumes from it.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIO_NOEXCEPT
+  {
+    return make_buffers<mutable_buffer, mutable_buffers_type>(pos, n);
+  }
+
+  /// Get a sequence of buffers that represents the bytes in the buffer.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * buffer is shorter, the buffer sequence represents as many bytes as are
+   * available.
+   *
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements. The sequence contains two buffers, the
+   * second of which is empty unless the bytes wrap around the end of the
+   * underlying memory.
+   *
+   * @note The returned object is invalidated by any @c ring_buffer member
+   * function that grows the buffer or consumes from it.
+   */
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const ASIO_NOEXCEPT
+  {
+    return make_buffers<const_buffer, const_buffers_type>(pos, n);
+  }
+
+  /// Reserve space for additional bytes.
+  /**
+   * Ensures that the buffer can grow by @c n bytes without reallocating.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void reserve(std::size_t n)
+  {
+    if (size_ > max_size_ || max_size_ - size_ < n)
+    {
+      std::length_error ex("ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (capacity_ - size_ < n)
+      reallocate(size_ + n);
+  }
+
+  /// Grow the buffer by the specified number of bytes.
+  /**
+   * Appends @c n bytes with unspecified values to the end of the buffer.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    reserve(n);
+    size_ += n;
+  }
+
+  /// Shrink the buffer by the specified number of bytes.
+  /**
+   * Removes @c n bytes from the end of the buffer. If @c n is greater than
+   * the size of the buffer, the buffer is emptied.
+   */
+  void shrink(std::size_t n) ASIO_NOEXCEPT
+  {
+    size_ -= (std::min)(n, size_);
+    if (size_ == 0)
+      begin_ = 0;
+  }
+
+  /// Consume the specified number of bytes from the beginning of the buffer.
+  /**
+   * Removes @c n bytes from the beginning of the buffer. The bytes that remain
+   * are not moved. If @c n is greater than the size of the buffer, the buffer
+   * is emptied.
+   */
+  void consume(std::size_t n) ASIO_NOEXCEPT
+  {
+    std::size_t consume_length = (std::min)(n, size_);
+    begin_ += consume_length;
+    if (begin_ >= capacity_)
+      begin_ -= capacity_;
+    size_ -= consume_length;
+    if (size_ == 0)
+      begin_ = 0;
+  }
+
+private:
+  enum { buffer_delta = 128 };
+
+  template <typename Buffer, typename Buffers>
+  Buffers make_buffers(std::size_t pos, std::size_t n) const ASIO_NOEXCEPT
+  {
+    pos = (std::min)(pos, size_);
+    n = (std::min)(n, size_ - pos);
+
+    std::size_t start = begin_ + pos;
+    if (start >= capacity_)
+      start -= capacity_;
+
+    std::size_t first = n;
+    if (mapping_ == single_mapped)
+      first = (std::min)(n, capacity_ - start);
+
+    Buffers buffers = {{
+      Buffer(data_ + start, first),
+      Buffer(data_, n - first)
+    }};
+    return buffers;
+  }
+
+  // Move the bytes into new memory with at least the specified capacity.
+  void reallocate(std::size_t min_capacity)
+  {
+    std::size_t new_capacity = (std::max<std::size_t>)(
+        min_capacity, buffer_delta);
+    if (capacity_ <= (std::numeric_limits<std::size_t>::max)() / 2)
+      new_capacity = (std::max)(new_capacity, capacity_ * 2);
+
+    if (mapping_ == double_mapped)
+    {
+      std::size_t granularity = detail::double_mapped_memory::granularity();
+      new_capacity = (new_capacity + granularity - 1) / granularity;
+      new_capacity *= granularity;
+    }
+
+    char* new_data = allocate(new_capacity);
+    if (size_ > 0)
+    {
+      std::size_t first = (std::min)(size_, capacity_ - begin_);
+      std::memcpy(new_data, data_ + begin_, first);
+      std::memcpy(new_data + first, data_, size_ - first);
+    }
+
+    deallocate(data_, capacity_);
+    data_ = new_data;
+    capacity_ = new_capacity;
+    begin_ = 0;
+  }
+
+  char* allocate(std::size_t n)
+  {
+    if (mapping_ == double_mapped)
+    {
+      asio::error_code ec;
+      void* p = detail::double_mapped_memory::map(n, ec);
+      asio::detail::throw_error(ec, "ring_buffer");
+      return static_cast<char*>(p);
+    }
+
+    return new char[n];
+  }
+
+  void deallocate(char* p, std::size_t n)
+  {
+    if (mapping_ == double_mapped)
+      detail::double_mapped_memory::unmap(p, n);
+    else
+      delete[] p;
+  }
+
+  char* data_;
+  std::size_t capacity_;
+  std::size_t begin_;
+  std::size_t size_;
+  const std::size_t max_size_;
+  const mapping_type mapping_;
+};
+
+/// Adapt a ring_buffer to the DynamicBuffer requirements.
+class dynamic_ring_buffer
+{
+public:
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef ring_buffer::const_buffers_type const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef ring_buffer::mutable_buffers_type mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a ring buffer.
+  /**
+   * @param b The ring buffer to be used as backing storage for the dynamic
+   * buffer. The object stores a reference to the ring buffer and the user is
+   * responsible for ensuring that the ring buffer object remains valid while
+   * the dynamic_ring_buffer object, and copies of the object, are in use.
+   *
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   * The ring buffer's own maximum size also applies.
+   */
+  explicit dynamic_ring_buffer(ring_buffer& b,
+      std::size_t maximum_size =
+        (std::numeric_limits<std::size_t>::max)()) ASIO_NOEXCEPT
+    : ring_(b),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_((std::numeric_limits<std::size_t>::max)()),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(maximum_size)
+  {
+  }
+
+  /// @b DynamicBuffer_v2: Copy construct a dynamic buffer.
+  dynamic_ring_buffer(const dynamic_ring_buffer& other) ASIO_NOEXCEPT
+    : ring_(other.ring_),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_(other.size_),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(other.max_size_)
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+  /// Move construct a dynamic buffer.
+  dynamic_ring_buffer(dynamic_ring_buffer&& other) ASIO_NOEXCEPT
+    : ring_(other.ring_),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_(other.size_),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(other.max_size_)
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+  /// @b DynamicBuffer_v1: Get the size of the input sequence.
+  /// @b DynamicBuffer_v2: Get the current size of the underlying memory.
+  /**
+   * @returns @b DynamicBuffer_v1 The current size of the input sequence.
+   * @b DynamicBuffer_v2: The current size of the ring buffer if less than
+   * max_size(). Otherwise returns max_size().
+   */
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    if (size_ != (std::numeric_limits<std::size_t>::max)())
+      return size_;
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    return (std::min)(ring_.size(), max_size());
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  /**
+   * @returns @b DynamicBuffer_v1: The allowed maximum of the sum of the sizes
+   * of the input sequence and output sequence. @b DynamicBuffer_v2: The allowed
+   * maximum size of the underlying memory.
+   */
+  std::size_t max_size() const ASIO_NOEXCEPT
+  {
+    return (std::min)(max_size_, ring_.max_size());
+  }
+
+  /// Get the maximum size that the buffer may grow to without triggering
+  /// reallocation.
+  /**
+   * @returns @b DynamicBuffer_v1: The current total capacity of the buffer,
+   * i.e. for both the input sequence and output sequence. @b DynamicBuffer_v2:
+   * The current capacity of the ring buffer if less than max_size(). Otherwise
+   * returns max_size().
+   */
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return (std::min)(ring_.capacity(), max_size());
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the input
+  /// sequence.
+  /**
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements, representing the ring buffer memory in
+   * the input sequence.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  const_buffers_type data() const ASIO_NOEXCEPT
+  {
+    return static_cast<const ring_buffer&>(ring_).data(0, size());
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing the ring buffer memory.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that grows the buffer or consumes from
+   * it.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIO_NOEXCEPT
+  {
+    return ring_.data(pos, clamp(pos, n));
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that grows the buffer or consumes from
+   * it.
+   */
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const ASIO_NOEXCEPT
+  {
+    return static_cast<const ring_buffer&>(ring_).data(pos, clamp(pos, n));
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the output
+  /// sequence, with the given size.
+  /**
+   * Ensures that the output sequence can accommodate @c n bytes, growing the
+   * ring buffer as necessary.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing ring buffer memory at
+   * the start of the output sequence of size @c n.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    if (size() > max_size() || max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (size_ == (std::numeric_limits<std::size_t>::max)())
+      size_ = ring_.size(); // Enable v1 behaviour.
+
+    ring_.shrink(ring_.size() - size_);
+    ring_.grow(n);
+
+    return ring_.data(size_, n);
+  }
+
+  /// @b DynamicBuffer_v1: Move bytes from the output sequence to the input
+  /// sequence.
+  /**
+   * @param n The number of bytes to append from the start of the output
+   * sequence to the end of the input sequence. The remainder of the output
+   * sequence is discarded.
+   *
+   * Requires a preceding call <tt>prepare(x)</tt> where <tt>x >= n</tt>, and
+   * no intervening operations that modify the input or output sequence.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n)
+  {
+    size_ += (std::min)(n, ring_.size() - size_);
+    ring_.shrink(ring_.size() - size_);
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Grow the underlying memory by the specified number of
+  /// bytes.
+  /**
+   * Grows the ring buffer to accommodate an additional @c n bytes at the end.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    if (size() > max_size() || max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    ring_.grow(n);
+  }
+
+  /// @b DynamicBuffer_v2: Shrink the underlying memory by the specified number
+  /// of bytes.
+  /**
+   * Removes @c n bytes from the end of the ring buffer. If @c n is greater
+   * than the current size of the ring buffer, the ring buffer is emptied.
+   */
+  void shrink(std::size_t n)
+  {
+    ring_.shrink(n);
+  }
+
+  /// @b DynamicBuffer_v1: Remove characters from the input sequence.
+  /// @b DynamicBuffer_v2: Consume the specified number of bytes from the
+  /// beginning of the underlying memory.
+  /**
+   * @b DynamicBuffer_v1: Removes @c n characters from the beginning of the
+   * input sequence. @note If @c n is greater than the size of the input
+   * sequence, the entire input sequence is consumed and no error is issued.
+   *
+   * @b DynamicBuffer_v2: Removes @c n bytes from the beginning of the ring
+   * buffer, without moving the bytes that remain. If @c n is greater than the
+   * current size of the ring buffer, the ring buffer is emptied.
+   */
+  void consume(std::size_t n)
+  {
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    if (size_ != (std::numeric_limits<std::size_t>::max)())
+    {
+      std::size_t consume_length = (std::min)(n, size_);
+      ring_.consume(consume_length);
+      size_ -= consume_length;
+      return;
+    }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    ring_.consume(n);
+  }
+
+private:
+  // Limit a range of the underlying memory to max_size().
+  std::size_t clamp(std::size_t pos, std::size_t n) const ASIO_NOEXCEPT
+  {
+    return pos < max_size() ? (std::min)(n, max_size() - pos) : 0;
+  }
+
+  ring_buffer& ring_;
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  std::size_t size_;
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  const std::size_t max_size_;
+};
+
+/// Create a new dynamic buffer that represents the given ring buffer.
+/**
+ * @returns <tt>dynamic_ring_buffer(data)</tt>.
+ */
+ASIO_NODISCARD inline dynamic_ring_buffer dynamic_buffer(
+    ring_buffer& data) ASIO_NOEXCEPT
+{
+  return dynamic_ring_buffer(data);
+}
+
+/// Create a new dynamic buffer that represents the given ring buffer.
+/**
+ * @returns <tt>dynamic_ring_buffer(data, max_size)</tt>.
+ */
+ASIO_NODISCARD inline dynamic_ring_buffer dynamic_buffer(
+    ring_buffer& data, std::size_t max_size) ASIO_NOEXCEPT
+{
+  return dynamic_ring_buffer(data, max_size);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_RING_BUFFER_HPP
@@ -0,0 +1,705 @@
+//
+// segmented_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SEGMENTED_BUFFER_HPP
+#define ASIO_SEGMENTED_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+#include "asio/buffer.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/segmented_buffers.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A pool of equally sized blocks shared by a number of segmented buffers.
+/**
+ * By default, each @c segmented_buffer keeps only a few of the blocks that it
+ * releases, and frees the rest. When many buffers grow and shrink over time,
+ * such as the receive buffers of the connections of a server, a @c
+ * segmented_buffer_pool lets them share the released blocks instead. Each
+ * buffer constructed with the pool takes its blocks from the pool, and returns
+ * them to the pool when they are consumed or when the buffer is destroyed.
+ *
+ * The pool keeps up to a maximum number of unused blocks, and frees any blocks
+ * returned beyond that number. The pool must outlive the buffers that use it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class segmented_buffer_pool
+  : private noncopyable
+{
+public:
+  /// Construct a pool of blocks.
+  /**
+   * @param block_size Specifies the size of each block of memory, in bytes.
+   *
+   * @param max_unused_blocks Specifies the maximum number of unused blocks
+   * that the pool keeps for reuse.
+   */
+  explicit segmented_buffer_pool(std::size_t block_size = 4096,
+      std::size_t max_unused_blocks = 64)
+    : block_size_(block_size > 0 ? block_size : 1),
+      max_unused_blocks_(max_unused_blocks)
+  {
+    unused_blocks_.reserve(max_unused_blocks_);
+  }
+
+  /// Destructor.
+  ~segmented_buffer_pool()
+  {
+    for (std::size_t i = 0; i < unused_blocks_.size(); ++i)
+      delete[] unused_blocks_[i];
+  }
+
+  /// Get the size of each block of memory.
+  std::size_t block_size() const ASIO_NOEXCEPT
+  {
+    return block_size_;
+  }
+
+  /// Get the number of unused blocks held by the pool.
+  std::size_t unused_blocks() const
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    return unused_blocks_.size();
+  }
+
+private:
+  friend class segmented_buffer;
+
+  // Take an unused block, or allocate a new one.
+  char* allocate()
+  {
+    {
+      detail::mutex::scoped_lock lock(mutex_);
+      if (!unused_blocks_.empty())
+      {
+        char* block = unused_blocks_.back();
+        unused_blocks_.pop_back();
+        return block;
+      }
+    }
+    return new char[block_size_];
+  }
+
+  // Keep a block for reuse, or free it if the pool is full.
+  void deallocate(char* block) ASIO_NOEXCEPT
+  {
+    {
+      detail::mutex::scoped_lock lock(mutex_);
+      if (unused_blocks_.size() < max_unused_blocks_)
+      {
+        // Space for the maximum number of blocks was reserved on
+        // construction, so this cannot throw.
+        unused_blocks_.push_back(block);
+        return;
+      }
+    }
+    delete[] block;
+  }
+
+  mutable detail::mutex mutex_;
+  std::vector<char*> unused_blocks_;
+  const std::size_t block_size_;
+  const std::size_t max_unused_blocks_;
+};
+
+/// A buffer of bytes held in a chain of fixed-size blocks.
+/**
+ * The @c segmented_buffer class holds a sequence of bytes in a chain of
+ * equally sized blocks of memory. Growing the buffer adds blocks to the end of
+ * the chain, and consuming from the buffer removes whole blocks from the
+ * beginning. Bytes are never moved once written, so that a large message may
+ * be received without reallocating or copying the part already received.
+ *
+ * A range of bytes is represented as a sequence with one buffer per block,
+ * which may be passed directly to scatter-gather I/O operations.
+ *
+ * Blocks that are released by @c consume are kept for reuse by later growth.
+ * A buffer constructed without a pool keeps at most four such blocks, and
+ * frees any others. To share released blocks between buffers and keep more of
+ * them, construct the buffers with a common segmented_buffer_pool.
+ *
+ * A @c segmented_buffer is used with I/O operations by way of the @c
+ * dynamic_segmented_buffer class, which is returned by the
+ * asio::dynamic_buffer function.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Examples
+ * Reading a message body of known length from a socket:
+ * @code
+ * asio::segmented_buffer b;
+ * asio::read(sock, asio::dynamic_buffer(b),
+ *     asio::transfer_exactly(content_length));
+ * process_body(b.data(0, b.size()));
+ * @endcode
+ */
+class segmented_buffer
+  : private noncopyable
+{
+public:
+#if defined(GENERATING_DOCUMENTATION)
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef implementation_defined const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef implementation_defined mutable_buffers_type;
+#else
+  typedef detail::segmented_buffers<const_buffer> const_buffers_type;
+  typedef detail::segmented_buffers<mutable_buffer> mutable_buffers_type;
+#endif
+
+  /// Construct a segmented buffer.
+  /**
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   *
+   * @param block_size Specifies the size of each block of memory, in bytes.
+   */
+  explicit segmented_buffer(
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)(),
+      std::size_t block_size = 4096)
+    : pool_(0),
+      block_size_(block_size > 0 ? block_size : 1),
+      begin_(0),
+      size_(0),
+      max_size_(maximum_size)
+  {
+    spare_blocks_.reserve(max_spare_blocks);
+  }
+
+  /// Construct a segmented buffer that obtains its blocks from a pool.
+  /**
+   * @param pool The pool from which blocks are obtained, and to which they
+   * are returned. The buffer uses the pool's block size. The pool must
+   * outlive the buffer.
+   *
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   */
+  explicit segmented_buffer(segmented_buffer_pool& pool,
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)())
+    : pool_(&pool),
+      block_size_(pool.block_size()),
+      begin_(0),
+      size_(0),
+      max_size_(maximum_size)
+  {
+    spare_blocks_.reserve(1);
+  }
+
+  /// Destructor.
+  ~segmented_buffer()
+  {
+    for (std::size_t i = 0; i < blocks_.size(); ++i)
+      free_block(blocks_[i]);
+    for (std::size_t i = 0; i < spare_blocks_.size(); ++i)
+      free_block(spare_blocks_[i]);
+  }
+
+  /// Get the number of bytes in the buffer.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the maximum size of the buffer.
+  std::size_t max_size() const ASIO_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// Get the maximum size that the buffer may grow to without adding blocks.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return (std::min)(blocks_.size() * block_size_ - begin_, max_size_);
+  }
+
+  /// Get the size of each block of memory.
+  std::size_t block_size() const ASIO_NOEXCEPT
+  {
+    return block_size_;
+  }
+
+  /// Get a sequence of buffers that represents the bytes in the buffer.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * buffer is shorter, the buffer sequence represents as many bytes as are
+   * available.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, with one buffer for each block that
+   * holds part of the range.
+   *
+   * @note The returned object is invalidated by any @c segmented_buffer member
+   * function that grows the buffer or consumes from it.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIO_NOEXCEPT
+  {
+    pos = (std::min)(pos, size_);
+    n = (std::min)(n, size_ - pos);
+    return mutable_buffers_type(blocks_,
+        block_size_, begin_ + pos, begin_ + pos + n);
+  }
+
+  /// Get a sequence of buffers that represents the bytes in the buffer.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * buffer is shorter, the buffer sequence represents as many bytes as are
+   * available.
+   *
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements, with one buffer for each block that
+   * holds part of the range.
+   *
+   * @note The returned object is invalidated by any @c segmented_buffer member
+   * function that grows the buffer or consumes from it.
+   */
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const ASIO_NOEXCEPT
+  {
+    pos = (std::min)(pos, size_);
+    n = (std::min)(n, size_ - pos);
+    return const_buffers_type(blocks_,
+        block_size_, begin_ + pos, begin_ + pos + n);
+  }
+
+  /// Reserve space for additional bytes.
+  /**
+   * Ensures that the buffer can grow by @c n bytes without adding blocks.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void reserve(std::size_t n)
+  {
+    if (size_ > max_size_ || max_size_ - size_ < n)
+    {
+      std::length_error ex("segmented_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    while (blocks_.size() * block_size_ - begin_ - size_ < n)
+    {
+      // The spare list has room for a new block, so that the block is owned
+      // by one of the lists even if adding it to the chain throws.
+      if (spare_blocks_.empty())
+        spare_blocks_.push_back(
+            pool_ ? pool_->allocate() : new char[block_size_]);
+      blocks_.push_back(spare_blocks_.back());
+      spare_blocks_.pop_back();
+    }
+  }
+
+  /// Grow the buffer by the specified number of bytes.
+  /**
+   * Appends @c n bytes with unspecified values to the end of the buffer.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    reserve(n);
+    size_ += n;
+  }
+
+  /// Shrink the buffer by the specified number of bytes.
+  /**
+   * Removes @c n bytes from the end of the buffer. If @c n is greater than
+   * the size of the buffer, the buffer is emptied.
+   */
+  void shrink(std::size_t n) ASIO_NOEXCEPT
+  {
+    size_ -= (std::min)(n, size_);
+  }
+
+  /// Consume the specified number of bytes from the beginning of the buffer.
+  /**
+   * Removes @c n bytes from the beginning of the buffer, and releases any
+   * blocks that no longer hold bytes. The bytes that remain are not moved. If
+   * @c n is greater than the size of the buffer, the buffer is emptied.
+   */
+  void consume(std::size_t n) ASIO_NOEXCEPT
+  {
+    std::size_t consume_length = (std::min)(n, size_);
+    begin_ += consume_length;
+    size_ -= consume_length;
+
+    while (begin_ >= block_size_)
+    {
+      release_block(blocks_.front());
+      blocks_.pop_front();
+      begin_ -= block_size_;
+    }
+
+    if (size_ == 0)
+      begin_ = 0;
+  }
+
+private:
+  enum { max_spare_blocks = 4 };
+
+  // Keep a block that no longer holds bytes for reuse.
+  void release_block(char* block) ASIO_NOEXCEPT
+  {
+    if (!pool_ && spare_blocks_.size() < max_spare_blocks)
+      spare_blocks_.push_back(block);
+    else
+      free_block(block);
+  }
+
+  // Return a block to the pool, or free it if there is no pool.
+  void free_block(char* block) ASIO_NOEXCEPT
+  {
+    if (pool_)
+      pool_->deallocate(block);
+    else
+      delete[] block;
+  }
+
+  segmented_buffer_pool* pool_;
+  std::deque<char*> blocks_;
+  std::vector<char*> spare_blocks_;
+  const std::size_t block_size_;
+  std::size_t begin_;
+  std::size_t size_;
+  const std::size_t max_size_;
+};
+
+/// Adapt a segmented_buffer to the DynamicBuffer requirements.
+class dynamic_segmented_buffer
+{
+public:
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef segmented_buffer::const_buffers_type const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef segmented_buffer::mutable_buffers_type mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a segmented buffer.
+  /**
+   * @param b The segmented buffer to be used as backing storage for the
+   * dynamic buffer. The object stores a reference to the segmented buffer and
+   * the user is responsible for ensuring that the segmented buffer object
+   * remains valid while the dynamic_segmented_buffer object, and copies of
+   * the object, are in use.
+   *
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   * The segmented buffer's own maximum size also applies.
+   */
+  explicit dynamic_segmented_buffer(segmented_buffer& b,
+      std::size_t maximum_size =
+        (std::numeric_limits<std::size_t>::max)()) ASIO_NOEXCEPT
+    : buffer_(b),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_((std::numeric_limits<std::size_t>::max)()),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(maximum_size)
+  {
+  }
+
+  /// @b DynamicBuffer_v2: Copy construct a dynamic buffer.
+  dynamic_segmented_buffer(
+      const dynamic_segmented_buffer& other) ASIO_NOEXCEPT
+    : buffer_(other.buffer_),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_(other.size_),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(other.max_size_)
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+  /// Move construct a dynamic buffer.
+  dynamic_segmented_buffer(dynamic_segmented_buffer&& other) ASIO_NOEXCEPT
+    : buffer_(other.buffer_),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_(other.size_),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(other.max_size_)
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+  /// @b DynamicBuffer_v1: Get the size of the input sequence.
+  /// @b DynamicBuffer_v2: Get the current size of the underlying memory.
+  /**
+   * @returns @b DynamicBuffer_v1 The current size of the input sequence.
+   * @b DynamicBuffer_v2: The current size of the segmented buffer if less than
+   * max_size(). Otherwise returns max_size().
+   */
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    if (size_ != (std::numeric_limits<std::size_t>::max)())
+      return size_;
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    return (std::min)(buffer_.size(), max_size());
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  /**
+   * @returns @b DynamicBuffer_v1: The allowed maximum of the sum of the sizes
+   * of the input sequence and output sequence. @b DynamicBuffer_v2: The allowed
+   * maximum size of the underlying memory.
+   */
+  std::size_t max_size() const ASIO_NOEXCEPT
+  {
+    return (std::min)(max_size_, buffer_.max_size());
+  }
+
+  /// Get the maximum size that the buffer may grow to without triggering
+  /// reallocation.
+  /**
+   * @returns @b DynamicBuffer_v1: The current total capacity of the buffer,
+   * i.e. for both the input sequence and output sequence. @b DynamicBuffer_v2:
+   * The current capacity of the segmented buffer if less than max_size().
+   * Otherwise returns max_size().
+   */
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return (std::min)(buffer_.capacity(), max_size());
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the input
+  /// sequence.
+  /**
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements, representing the segmented buffer
+   * memory in the input sequence.
+   *
+   * @note The returned object is invalidated by any @c
+   * dynamic_segmented_buffer or @c segmented_buffer member function that
+   * modifies the input sequence or output sequence.
+   */
+  const_buffers_type data() const ASIO_NOEXCEPT
+  {
+    return static_cast<const segmented_buffer&>(buffer_).data(0, size());
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing the segmented buffer
+   * memory.
+   *
+   * @note The returned object is invalidated by any @c
+   * dynamic_segmented_buffer or @c segmented_buffer member function that
+   * grows the buffer or consumes from it.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIO_NOEXCEPT
+  {
+    return buffer_.data(pos, clamp(pos, n));
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @note The returned object is invalidated by any @c
+   * dynamic_segmented_buffer or @c segmented_buffer member function that
+   * grows the buffer or consumes from it.
+   */
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const ASIO_NOEXCEPT
+  {
+    return static_cast<const segmented_buffer&>(buffer_).data(
+        pos, clamp(pos, n));
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the output
+  /// sequence, with the given size.
+  /**
+   * Ensures that the output sequence can accommodate @c n bytes, adding blocks
+   * to the segmented buffer as necessary.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing segmented buffer memory
+   * at the start of the output sequence of size @c n.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c
+   * dynamic_segmented_buffer or @c segmented_buffer member function that
+   * modifies the input sequence or output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    if (size() > max_size() || max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_segmented_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (size_ == (std::numeric_limits<std::size_t>::max)())
+      size_ = buffer_.size(); // Enable v1 behaviour.
+
+    buffer_.shrink(buffer_.size() - size_);
+    buffer_.grow(n);
+
+    return buffer_.data(size_, n);
+  }
+
+  /// @b DynamicBuffer_v1: Move bytes from the output sequence to the input
+  /// sequence.
+  /**
+   * @param n The number of bytes to append from the start of the output
+   * sequence to the end of the input sequence. The remainder of the output
+   * sequence is discarded.
+   *
+   * Requires a preceding call <tt>prepare(x)</tt> where <tt>x >= n</tt>, and
+   * no intervening operations that modify the input or output sequence.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n)
+  {
+    size_ += (std::min)(n, buffer_.size() - size_);
+    buffer_.shrink(buffer_.size() - size_);
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Grow the underlying memory by the specified number of
+  /// bytes.
+  /**
+   * Grows the segmented buffer to accommodate an additional @c n bytes at the
+   * end.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    if (size() > max_size() || max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_segmented_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    buffer_.grow(n);
+  }
+
+  /// @b DynamicBuffer_v2: Shrink the underlying memory by the specified number
+  /// of bytes.
+  /**
+   * Removes @c n bytes from the end of the segmented buffer. If @c n is
+   * greater than the current size of the segmented buffer, the segmented
+   * buffer is emptied.
+   */
+  void shrink(std::size_t n)
+  {
+    buffer_.shrink(n);
+  }
+
+  /// @b DynamicBuffer_v1: Remove characters from the input sequence.
+  /// @b DynamicBuffer_v2: Consume the specified number of bytes from the
+  /// beginning of the underlying memory.
+  /**
+   * @b DynamicBuffer_v1: Removes @c n characters from the beginning of the
+   * input sequence. @note If @c n is greater than the size of the input
+   * sequence, the entire input sequence is consumed and no error is issued.
+   *
+   * @b DynamicBuffer_v2: Removes @c n bytes from the beginning of the
+   * segmented buffer, releasing any blocks that no longer hold bytes. If @c n
+   * is greater than the current size of the segmented buffer, the segmented
+   * buffer is emptied.
+   */
+  void consume(std::size_t n)
+  {
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    if (size_ != (std::numeric_limits<std::size_t>::max)())
+    {
+      std::size_t consume_length = (std::min)(n, size_);
+      buffer_.consume(consume_length);
+      size_ -= consume_length;
+      return;
+    }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    buffer_.consume(n);
+  }
+
+private:
+  // Limit a range of the underlying memory to max_size().
+  std::size_t clamp(std::size_t pos, std::size_t n) const ASIO_NOEXCEPT
+  {
+    return pos < max_size() ? (std::min)(n, max_size() - pos) : 0;
+  }
+
+  segmented_buffer& buffer_;
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  std::size_t size_;
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  const std::size_t max_size_;
+};
+
+/// Create a new dynamic buffer that represents the given segmented buffer.
+/**
+ * @returns <tt>dynamic_segmented_buffer(data)</tt>.
+ */
+ASIO_NODISCARD inline dynamic_segmented_buffer dynamic_buffer(
+    segmented_buffer& data) ASIO_NOEXCEPT
+{
+  return dynamic_segmented_buffer(data);
+}
+
+/// Create a new dynamic buffer that represents the given segmented buffer.
+/**
+ * @returns <tt>dynamic_segmented_buffer(data, max_size)</tt>.
+ */
+ASIO_NODISCARD inline dynamic_segmented_buffer dynamic_buffer(
+    segmented_buffer& data, std::size_t max_size) ASIO_NOEXCEPT
+{
+  return dynamic_segmented_buffer(data, max_size);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SEGMENTED_BUFFER_HPP
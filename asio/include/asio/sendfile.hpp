@@ -0,0 +1,329 @@
+//
+// sendfile.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SENDFILE_HPP
+#define ASIO_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SENDFILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/error.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+
+#if defined(ASIO_HAS_FILE)
+# include "asio/basic_random_access_file.hpp"
+# include "asio/basic_stream_file.hpp"
+#endif // defined(ASIO_HAS_FILE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename> class initiate_async_sendfile;
+
+} // namespace detail
+
+/**
+ * @defgroup async_sendfile asio::async_sendfile
+ *
+ * @brief The @c async_sendfile function is a composed asynchronous operation
+ * that sends data from a file or descriptor to a stream socket, without
+ * copying the data through the program's memory.
+ */
+/*@{*/
+
+#if defined(ASIO_HAS_FILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+/// Start an asynchronous operation to send data from a random-access file to
+/// a stream socket.
+/**
+ * This function is used to asynchronously send a certain number of bytes from
+ * a file, starting at the specified offset, to a stream socket. It is an
+ * initiating function for an @ref asynchronous_operation, and always returns
+ * immediately. The asynchronous operation will continue until one of the
+ * following conditions is true:
+ *
+ * @li The specified number of bytes has been sent.
+ *
+ * @li The end of the file is reached, in which case the operation fails with
+ * asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * The data is passed from the file to the socket by the kernel, using the
+ * @c sendfile system call. If the kernel does not support this for the file,
+ * the data is instead read into a buffer and written to the socket. The
+ * file's current position is not used or changed.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's @c async_wait function, and is known as a <em>composed
+ * operation</em>. The program must ensure that the socket performs no other
+ * write operations until this operation completes. The socket is placed into
+ * non-blocking mode, and is left in that mode when the operation completes.
+ *
+ * @param s The socket to which the data is to be sent.
+ *
+ * @param f The file from which the data is to be read. The file object must
+ * remain valid until the completion handler is called.
+ *
+ * @param offset The offset in the file at which the data starts.
+ *
+ * @param length The number of bytes to be sent.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the send completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes sent to the socket. If an error occurred, this will
+ *   // be less than the number of bytes requested.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * asio::random_access_file file(my_context, "index.html",
+ *     asio::random_access_file::read_only);
+ * asio::async_sendfile(socket, file, 0, file.size(), handler);
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ *
+ * @note Available on Linux only.
+ */
+template <typename Protocol, typename Executor, typename FileExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    basic_random_access_file<FileExecutor>& f, uint64_t offset,
+    std::size_t length,
+    ASIO_MOVE_ARG(WriteToken) token
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor))
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<
+          basic_stream_socket<Protocol, Executor> > >(),
+        token, &f, true, offset, length)));
+
+/// Start an asynchronous operation to send data from a stream-oriented file
+/// to a stream socket.
+/**
+ * This function is used to asynchronously send a certain number of bytes from
+ * a file, starting at the file's current position, to a stream socket. It is
+ * an initiating function for an @ref asynchronous_operation, and always
+ * returns immediately. The asynchronous operation will continue until one of
+ * the following conditions is true:
+ *
+ * @li The specified number of bytes has been sent.
+ *
+ * @li The end of the file is reached, in which case the operation fails with
+ * asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * The data is passed from the file to the socket by the kernel, using the
+ * @c sendfile system call. If the kernel does not support this for the file,
+ * the data is instead read into a buffer and written to the socket. The
+ * file's position is advanced past the data that has been read.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's @c async_wait function, and is known as a <em>composed
+ * operation</em>. The program must ensure that the socket performs no other
+ * write operations, and the file no other read operations, until this
+ * operation completes. The socket is placed into non-blocking mode, and is
+ * left in that mode when the operation completes.
+ *
+ * @param s The socket to which the data is to be sent.
+ *
+ * @param f The file from which the data is to be read. The file object must
+ * remain valid until the completion handler is called.
+ *
+ * @param length The number of bytes to be sent.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the send completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes sent to the socket. If an error occurred, this will
+ *   // be less than the number of bytes requested.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ *
+ * @note Available on Linux only.
+ */
+template <typename Protocol, typename Executor, typename FileExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    basic_stream_file<FileExecutor>& f, std::size_t length,
+    ASIO_MOVE_ARG(WriteToken) token
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor))
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<
+          basic_stream_socket<Protocol, Executor> > >(),
+        token, &f, false, uint64_t(0), length)));
+
+#endif // defined(ASIO_HAS_FILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+/// Start an asynchronous operation to send data from a stream-oriented
+/// descriptor to a stream socket.
+/**
+ * This function is used to asynchronously send a certain number of bytes from
+ * a descriptor, such as a pipe or a regular file, to a stream socket. It is
+ * an initiating function for an @ref asynchronous_operation, and always
+ * returns immediately. The asynchronous operation will continue until one of
+ * the following conditions is true:
+ *
+ * @li The specified number of bytes has been sent.
+ *
+ * @li The end of the data is reached, in which case the operation fails with
+ * asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * The data is passed from the descriptor to the socket by the kernel. The
+ * @c sendfile system call is used where the descriptor supports it, and the
+ * @c splice system call is used for pipes. Otherwise, the data is read into a
+ * buffer and written to the socket.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's and descriptor's @c async_wait functions, and is known as a
+ * <em>composed operation</em>. The program must ensure that the socket
+ * performs no other write operations, and the descriptor no other read
+ * operations, until this operation completes. The socket is placed into
+ * non-blocking mode, and is left in that mode when the operation completes.
+ *
+ * @param s The socket to which the data is to be sent.
+ *
+ * @param d The descriptor from which the data is to be read. The descriptor
+ * object must remain valid until the completion handler is called.
+ *
+ * @param length The number of bytes to be sent.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the send completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes sent to the socket. If an error occurred, this will
+ *   // be less than the number of bytes requested.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ *
+ * @note Available on Linux only.
+ */
+template <typename Protocol, typename Executor, typename DescriptorExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(WriteToken,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<DescriptorExecutor>& d,
+    std::size_t length,
+    ASIO_MOVE_ARG(WriteToken) token
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor))
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<
+          basic_stream_socket<Protocol, Executor> > >(),
+        token, &d, false, uint64_t(0), length)));
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/sendfile.hpp"
+
+#endif // defined(ASIO_HAS_SENDFILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SENDFILE_HPP
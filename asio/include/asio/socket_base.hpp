@@ -503,6 +503,51 @@ public:
     enable_connection_aborted;
 #endif
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to send data without copying it.
+  /**
+   * Implements the SOL_SOCKET/SO_ZEROCOPY socket option. When the option is
+   * set on a stream socket, asynchronous send operations of 16 KiB or more
+   * pass the MSG_ZEROCOPY flag, and the kernel transmits directly from the
+   * caller's buffers. Such an operation does not complete until the kernel
+   * reports that it has finished with the buffers, so the buffers must remain
+   * valid, and unmodified, until the completion handler is called.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::zero_copy option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::zero_copy option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @note Available on Linux only, when the epoll reactor is used. If an
+   * operation is cancelled after its data has been passed to the kernel, the
+   * kernel may continue to read from the buffers after the completion handler
+   * is called.
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined zero_copy;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_ZEROCOPY)> zero_copy;
+#endif
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
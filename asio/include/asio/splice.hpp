@@ -0,0 +1,151 @@
+//
+// splice.hpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SPLICE_HPP
+#define ASIO_SPLICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename> class initiate_async_splice;
+
+} // namespace detail
+
+/**
+ * @defgroup async_splice asio::async_splice
+ *
+ * @brief The @c async_splice function is a composed asynchronous operation
+ * that moves data from one stream to another, without copying the data
+ * through the program's memory.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to move data from one stream to another.
+/**
+ * This function is used to asynchronously move a certain number of bytes from
+ * a source stream to a destination stream. It is an initiating function for an
+ * @ref asynchronous_operation, and always returns immediately. The
+ * asynchronous operation will continue until one of the following conditions
+ * is true:
+ *
+ * @li The specified number of bytes has been moved.
+ *
+ * @li The end of the source's data is reached, in which case the operation
+ * fails with asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * The data is moved by the kernel, using the @c splice system call to pass it
+ * through a pipe. The pipe is kept open by the source's execution context once
+ * the operation completes, and is reused by later operations. If the kernel
+ * does not support this for the source or destination, the data is instead
+ * read into a buffer and written to the destination.
+ *
+ * This operation is implemented in terms of zero or more calls to the source's
+ * and destination's @c async_wait functions, and is known as a <em>composed
+ * operation</em>. The program must ensure that the source performs no other
+ * read operations, and the destination no other write operations, until this
+ * operation completes. The source and destination are placed into
+ * non-blocking mode, and are left in that mode when the operation completes.
+ *
+ * @param s The stream from which the data is to be read. The type must be a
+ * specialisation of basic_stream_socket or posix::basic_stream_descriptor.
+ *
+ * @param d The stream to which the data is to be written. The type must be a
+ * specialisation of basic_stream_socket or posix::basic_stream_descriptor.
+ *
+ * @param max_bytes The number of bytes to be moved.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written to the destination. If an error occurred, this
+ *   // will be less than the number of bytes requested.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * Forwarding everything received on one socket to another:
+ * @code
+ * asio::async_splice(client, server,
+ *     std::numeric_limits<std::size_t>::max(), handler);
+ * @endcode
+ * The operation completes with asio::error::eof once the client shuts down
+ * its side of the connection.
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ *
+ * @note Available on Linux only. If the operation fails, or is cancelled,
+ * after data has been read from the source but before it has been written to
+ * the destination, that data is discarded.
+ */
+template <typename SpliceSource, typename SpliceDestination,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceToken
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename SpliceSource::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(SpliceToken,
+    void (asio::error_code, std::size_t))
+async_splice(SpliceSource& s, SpliceDestination& d, std::size_t max_bytes,
+    ASIO_MOVE_ARG(SpliceToken) token
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename SpliceSource::executor_type))
+  ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+    async_initiate<SpliceToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_splice<SpliceSource> >(),
+        token, &d, max_bytes)));
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/splice.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SPLICE_HPP
@@ -362,6 +362,33 @@ public:
     return detail::strand_executor_service::running_in_this_thread(impl_);
   }
 
+  /// Set the strand's execution budget.
+  /**
+   * Limits the work that the strand performs each time it is scheduled on the
+   * underlying executor. When the budget is used up, the strand schedules
+   * itself again behind any other work that is queued on the underlying
+   * executor, so that a busy strand does not monopolise a thread.
+   *
+   * The budget is shared by all copies of the strand. It takes effect the next
+   * time the strand is scheduled.
+   *
+   * @param max_handlers The maximum number of function objects to run each
+   * time the strand is scheduled, or 0 for no limit.
+   *
+   * @param max_usec The maximum time, in microseconds, to spend running
+   * function objects each time the strand is scheduled, or 0 for no limit. At
+   * least one function object is run. This limit is ignored if the platform
+   * has no steady clock.
+   *
+   * New strands use the values of the @c ASIO_STRAND_HANDLER_BUDGET and
+   * @c ASIO_STRAND_TIME_BUDGET_USEC macros, both of which default to 0.
+   */
+  void set_budget(std::size_t max_handlers, long max_usec = 0) ASIO_NOEXCEPT
+  {
+    detail::strand_executor_service::set_budget(
+        impl_, max_handlers, max_usec);
+  }
+
   /// Compare two strands for equality.
   /**
    * Two strands are equal if they refer to the same ordered, non-concurrent
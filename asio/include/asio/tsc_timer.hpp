@@ -0,0 +1,54 @@
+//
+// tsc_timer.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TSC_TIMER_HPP
+#define ASIO_TSC_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/tsc_clock.hpp"
+
+namespace asio {
+
+/// A steady clock based on the processor's invariant time stamp counter.
+/**
+ * The tsc_clock class meets the C++11 clock requirements and reports time in
+ * nanoseconds. On x86-64 processors that advertise an invariant time stamp
+ * counter, @c now() reads the counter directly and scales it using a
+ * frequency calibrated against @c steady_clock. On all other systems it falls
+ * back to @c steady_clock.
+ *
+ * The calibration interval starts during static initialisation and ends the
+ * first time the clock is used. The first call waits only if less than
+ * @c ASIO_TSC_CLOCK_CALIBRATION_USEC microseconds (10000 by default) have
+ * elapsed since the program started. Call @c tsc_clock::is_invariant() during
+ * program startup to keep the calibration off a latency sensitive path.
+ */
+#if defined(GENERATING_DOCUMENTATION)
+typedef implementation_defined tsc_clock;
+#else // defined(GENERATING_DOCUMENTATION)
+typedef detail::tsc_clock tsc_clock;
+#endif // defined(GENERATING_DOCUMENTATION)
+
+/// Typedef for a timer based on the time stamp counter clock.
+typedef basic_waitable_timer<tsc_clock> tsc_timer;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_TSC_TIMER_HPP
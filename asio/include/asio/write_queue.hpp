@@ -0,0 +1,327 @@
+//
+// write_queue.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_WRITE_QUEUE_HPP
+#define ASIO_WRITE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/detail/wait_op.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename> class initiate_async_write_queue_push;
+template <typename> class write_queue_handler;
+
+} // namespace detail
+
+/// Queues messages for writing to a stream, combining them into as few write
+/// operations as possible.
+/**
+ * The write_queue class template maintains the outbound message queue of a
+ * stream, such as an ip::tcp::socket or an ssl::stream. Messages may be pushed
+ * onto the queue from any thread.
+ *
+ * The queue keeps at most one write operation outstanding on the stream. When
+ * that operation completes, all messages pushed in the meantime are written
+ * using a single gather operation. Many small messages are therefore sent with
+ * a single system call, rather than one call per message.
+ *
+ * A message pushed using async_push() is not copied. The queue refers to the
+ * caller's buffers, which must remain valid until the push operation
+ * completes once the message has been written. A message pushed using
+ * try_push() is copied into the queue, and the caller's buffers may be reused
+ * as soon as the function returns.
+ *
+ * The queue has limits on the number of bytes and the number of messages that
+ * may be waiting to be written. While either limit is reached, try_push()
+ * fails and async_push() holds the message back until enough of the queue has
+ * been written. Producers that wait for each push to complete before pushing
+ * again are thereby held to the rate at which the stream accepts data. A limit
+ * of 0 means that the corresponding quantity is not limited.
+ *
+ * If a write fails, the queue discards any unwritten messages and all further
+ * pushes fail with the same error.
+ *
+ * The write_queue object must outlive the write operations that it starts on
+ * the stream. To shut down, close the stream and allow the outstanding write
+ * to complete before destroying the queue.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for calls to try_push(), async_push(),
+ * queued_bytes() and queued_messages(). The write operations are started
+ * through the stream's executor, so other operations on the stream must also
+ * be performed through that executor.
+ *
+ * @par Example
+ * @code asio::write_queue<asio::ip::tcp::socket&> queue(socket);
+ * ...
+ * queue.async_push(asio::buffer(message),
+ *     [](asio::error_code ec)
+ *     {
+ *       if (!ec)
+ *       {
+ *         // The message has been written, and its buffers may be reused.
+ *       }
+ *     }); @endcode
+ */
+template <typename AsyncWriteStream>
+class write_queue
+  : private noncopyable
+{
+public:
+  /// The type of the next layer.
+  typedef typename remove_reference<AsyncWriteStream>::type next_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename next_layer_type::executor_type executor_type;
+
+#if defined(GENERATING_DOCUMENTATION)
+  /// The default limit on the number of bytes waiting to be written.
+  static const std::size_t default_max_bytes = implementation_defined;
+
+  /// The default limit on the number of messages waiting to be written.
+  static const std::size_t default_max_messages = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, default_max_bytes = 1024 * 1024);
+  ASIO_STATIC_CONSTANT(std::size_t, default_max_messages = 65536);
+#endif
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  template <typename Arg>
+  explicit write_queue(Arg& a)
+    : next_layer_(a),
+      max_bytes_(default_max_bytes),
+      max_messages_(default_max_messages),
+      queued_bytes_(0),
+      queued_messages_(0),
+      writing_bytes_(0),
+      writing_messages_(0),
+      writing_(false)
+  {
+  }
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  /**
+   * @param a The argument used to initialise the next layer.
+   *
+   * @param max_bytes The number of bytes waiting to be written at which the
+   * queue is considered full, or 0 if the number of bytes is not limited.
+   *
+   * @param max_messages The number of messages waiting to be written at which
+   * the queue is considered full, or 0 if the number of messages is not
+   * limited.
+   */
+  template <typename Arg>
+  write_queue(Arg& a, std::size_t max_bytes, std::size_t max_messages)
+    : next_layer_(a),
+      max_bytes_(max_bytes),
+      max_messages_(max_messages),
+      queued_bytes_(0),
+      queued_messages_(0),
+      writing_bytes_(0),
+      writing_messages_(0),
+      writing_(false)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Destroys the handlers of any async_push() operations that are still
+   * waiting for room in the queue, without invoking them.
+   */
+  ~write_queue();
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return next_layer_.get_executor();
+  }
+
+  /// Get the number of bytes that have been pushed but not yet written.
+  std::size_t queued_bytes() const;
+
+  /// Get the number of messages that have been pushed but not yet written.
+  std::size_t queued_messages() const;
+
+  /// Push a copy of a message onto the queue, if there is room for it.
+  /**
+   * @param message The message to be written. The bytes are copied into the
+   * queue before the function returns.
+   *
+   * @returns @c true if the message was added to the queue. Returns @c false,
+   * and leaves the queue unchanged, if the queue is full or a previous write
+   * failed.
+   */
+  template <typename ConstBufferSequence>
+  bool try_push(const ConstBufferSequence& message);
+
+  /// Push a message onto the queue and wait until it has been written.
+  /**
+   * This function is used to add a message to the queue without copying it.
+   * If the queue is full, the message is held back until there is room for it.
+   * The asynchronous operation completes once the message has been written, or
+   * with an error if a write fails.
+   *
+   * @param message The message to be written. Although the buffers object may
+   * be copied as necessary, ownership of the underlying memory blocks is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the message has been
+   * written. If a previous write failed, invocation of the handler will be
+   * performed in a manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        PushToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE_PREFIX(PushToken,
+      void (asio::error_code))
+  async_push(const ConstBufferSequence& message,
+      ASIO_MOVE_ARG(PushToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    ASIO_INITFN_AUTO_RESULT_TYPE_SUFFIX((
+      async_initiate<PushToken, void (asio::error_code)>(
+          declval<detail::initiate_async_write_queue_push<
+            AsyncWriteStream> >(), token, message)));
+
+private:
+  friend class detail::initiate_async_write_queue_push<AsyncWriteStream>;
+  friend class detail::write_queue_handler<AsyncWriteStream>;
+
+  // A buffer of a queued message. Messages pushed by try_push() are copied,
+  // and refer to an offset in the copied data until their write starts.
+  struct message_buffer
+  {
+    const void* data_;
+    std::size_t offset_;
+    std::size_t size_;
+  };
+
+  // Determine whether the queue has room for another message. A limit of 0
+  // means no limit. The mutex must be held.
+  bool has_room() const
+  {
+    return (max_bytes_ == 0 || queued_bytes_ < max_bytes_)
+      && (max_messages_ == 0 || queued_messages_ < max_messages_);
+  }
+
+  // Add the buffers of a message to a list without copying them. Returns the
+  // number of buffers added.
+  template <typename ConstBufferSequence, typename List>
+  static std::size_t add_buffers(const ConstBufferSequence& message,
+      List& list);
+
+  template <typename Iterator, typename List>
+  static std::size_t add_buffers(Iterator iter, Iterator end, List& list);
+
+  // Copy a message to the end of the pending data. The mutex must be held.
+  // Returns true if the caller must start a write.
+  template <typename ConstBufferSequence>
+  bool enqueue_copy(const ConstBufferSequence& message);
+
+  // Add a message to the pending data without copying it. The operation
+  // completes once the message has been written. The mutex must be held.
+  // Returns true if the caller must start a write.
+  template <typename ConstBufferSequence>
+  bool enqueue(const ConstBufferSequence& message, detail::wait_op* op);
+
+  // Move held back messages to the pending data while there is room. The mutex
+  // must be held.
+  void enqueue_held();
+
+  // Take the pending data as the data for the next write. The mutex must be
+  // held.
+  void take_pending();
+
+  // Start a write of the pending data.
+  void start_write();
+
+  // Handle the completion of a write.
+  void write_complete(const asio::error_code& ec);
+
+  // The next layer.
+  AsyncWriteStream next_layer_;
+
+  // The limits at which the queue is full.
+  std::size_t max_bytes_;
+  std::size_t max_messages_;
+
+  // Protects the state below.
+  mutable detail::mutex mutex_;
+
+  // The buffers of the messages pushed since the current write started, the
+  // bytes of those that were copied, and the pushes waiting for them to be
+  // written.
+  std::vector<message_buffer> pending_buffers_;
+  std::vector<unsigned char> pending_copies_;
+  detail::op_queue<detail::wait_op> pending_ops_;
+
+  // The buffers being written by the current write operation, the copied
+  // bytes they refer to, and the pushes waiting for them to be written.
+  std::vector<asio::const_buffer> writing_buffers_;
+  std::vector<unsigned char> writing_copies_;
+  detail::op_queue<detail::wait_op> writing_ops_;
+
+  // The total size of the pending and writing messages, and their number.
+  std::size_t queued_bytes_;
+  std::size_t queued_messages_;
+
+  // The size and number of messages being written by the current write.
+  std::size_t writing_bytes_;
+  std::size_t writing_messages_;
+
+  // Whether a write operation is outstanding or about to be started.
+  bool writing_;
+
+  // The error from a failed write.
+  asio::error_code error_;
+
+  // The messages held back until there is room in the queue, the number of
+  // buffers in each, and the pushes waiting for them.
+  std::deque<message_buffer> held_buffers_;
+  std::deque<std::size_t> held_counts_;
+  detail::op_queue<detail::wait_op> held_ops_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/write_queue.hpp"
+
+#endif // ASIO_WRITE_QUEUE_HPP
@@ -44,6 +44,21 @@ awaitable<void> produce_tokens(std::size_t bytes_per_token,
   }
 }
 
+#if defined(ASIO_HAS_SPLICE)
+
+awaitable<void> transfer(tcp::socket& from,
+    tcp::socket& to, token_channel& tokens)
+{
+  for (;;)
+  {
+    // The data is moved by the kernel, without being copied into our memory.
+    std::size_t bytes_available = co_await tokens.async_receive(use_awaitable);
+    co_await asio::async_splice(from, to, bytes_available, use_awaitable);
+  }
+}
+
+#else // defined(ASIO_HAS_SPLICE)
+
 awaitable<void> transfer(tcp::socket& from,
     tcp::socket& to, token_channel& tokens)
 {
@@ -63,6 +78,8 @@ awaitable<void> transfer(tcp::socket& from,
   }
 }
 
+#endif // defined(ASIO_HAS_SPLICE)
+
 awaitable<void> proxy(tcp::socket client, tcp::endpoint target)
 {
   constexpr std::size_t number_of_tokens = 100;
@@ -11,43 +11,22 @@
 #ifndef HIGH_RES_CLOCK_HPP
 #define HIGH_RES_CLOCK_HPP
 
-#include <boost/config.hpp>
+#include <asio/tsc_timer.hpp>
 #include <boost/cstdint.hpp>
 
-#if defined(ASIO_WINDOWS)
-
-inline boost::uint64_t high_res_clock()
-{
-  LARGE_INTEGER i;
-  QueryPerformanceCounter(&i);
-  return i.QuadPart;
-}
-
-#elif defined(__GNUC__) && defined(__x86_64__)
-
-inline boost::uint64_t high_res_clock()
+// Completes the clock's calibration. Call before taking timestamps.
+inline void high_res_clock_init()
 {
-  unsigned long low, high;
-  __asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
-  return (((boost::uint64_t)high) << 32) | low;
+  asio::tsc_clock::is_invariant();
 }
 
-#else
-
-#include <boost/date_time/posix_time/posix_time_types.hpp>
-
+// Returns a timestamp in nanoseconds. Uses the processor's time stamp counter
+// when it is invariant, and steady_clock otherwise. The latency clients scale
+// the timestamps against the wall clock and report microseconds.
 inline boost::uint64_t high_res_clock()
 {
-  boost::posix_time::ptime now =
-    boost::posix_time::microsec_clock::universal_time();
-
-  boost::posix_time::ptime epoch(
-      boost::gregorian::date(1970, 1, 1),
-      boost::posix_time::seconds(0));
-
-  return (now - epoch).total_microseconds();
+  return static_cast<boost::uint64_t>(
+      asio::tsc_clock::now().time_since_epoch().count());
 }
 
-#endif
-
 #endif // HIGH_RES_CLOCK_HPP
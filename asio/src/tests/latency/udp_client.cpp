@@ -53,6 +53,8 @@ int main(int argc, char* argv[])
   std::vector<unsigned char> write_buf(buf_size);
   std::vector<unsigned char> read_buf(buf_size);
 
+  high_res_clock_init();
+
   ptime start = microsec_clock::universal_time();
   boost::uint64_t start_hr = high_res_clock();
 
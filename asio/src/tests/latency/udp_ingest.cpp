@@ -0,0 +1,247 @@
+//
+// udp_ingest.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/io_context.hpp>
+#include <asio/ip/udp.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using asio::ip::udp;
+
+// Measures the cost of receiving datagrams. Each round sends a burst of
+// datagrams over the loopback interface, then times how long the receiver
+// takes to drain them from the socket. The receiver uses one of:
+//
+// - async_receive_from, which receives one datagram per operation;
+//
+// - async_receive_batch, which receives up to <batchsize> datagrams per
+//   operation;
+//
+// - async_receive_coalesced, where the sender uses segmentation offload to
+//   send <batchsize> datagrams per operation and the receiver uses generic
+//   receive offload to receive them in one operation.
+//
+// Sending and receiving alternate on one thread, so that the result does not
+// depend on the number of processors.
+//
+// The absolute times vary between machines, and between runs on a shared
+// machine, by as much as the difference between the first two modes. Compare
+// the modes by running them one after another with the same arguments, e.g.:
+//
+//   for m in single batch coalesced; do udp_ingest $m 64 64 2000; done
+
+const std::size_t burst_size = 256;
+
+class single_receiver
+{
+public:
+  single_receiver(udp::socket& socket, std::size_t buf_size, std::size_t)
+    : socket_(socket),
+      buffer_(buf_size),
+      remaining_(0)
+  {
+  }
+
+  void receive(std::size_t n)
+  {
+    remaining_ = n;
+    start();
+  }
+
+private:
+  void start()
+  {
+    socket_.async_receive_from(asio::buffer(buffer_), sender_, handler{this});
+  }
+
+  struct handler
+  {
+    single_receiver* r;
+
+    void operator()(const asio::error_code& ec, std::size_t)
+    {
+      if (!ec && --r->remaining_ > 0)
+        r->start();
+    }
+  };
+
+  udp::socket& socket_;
+  std::vector<unsigned char> buffer_;
+  udp::endpoint sender_;
+  std::size_t remaining_;
+};
+
+class batch_receiver
+{
+public:
+  batch_receiver(udp::socket& socket,
+      std::size_t buf_size, std::size_t batch_size)
+    : socket_(socket),
+      buffer_(buf_size * batch_size),
+      slots_(batch_size),
+      remaining_(0)
+  {
+    for (std::size_t i = 0; i < batch_size; ++i)
+      slots_[i].buffer(asio::buffer(&buffer_[i * buf_size], buf_size));
+  }
+
+  void receive(std::size_t n)
+  {
+    remaining_ = n;
+    start();
+  }
+
+private:
+  void start()
+  {
+    std::size_t n = remaining_ < slots_.size() ? remaining_ : slots_.size();
+    socket_.async_receive_batch(&slots_[0], n, handler{this});
+  }
+
+  struct handler
+  {
+    batch_receiver* r;
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      if (!ec && (r->remaining_ -= n) > 0)
+        r->start();
+    }
+  };
+
+  udp::socket& socket_;
+  std::vector<unsigned char> buffer_;
+  std::vector<udp::socket::receive_slot> slots_;
+  std::size_t remaining_;
+};
+
+#if defined(ASIO_HAS_UDP_GSO) && defined(ASIO_HAS_UDP_GRO)
+
+class coalesced_receiver
+{
+public:
+  coalesced_receiver(udp::socket& socket,
+      std::size_t buf_size, std::size_t batch_size)
+    : socket_(socket),
+      buffer_(buf_size * batch_size),
+      segment_size_(0),
+      remaining_(0)
+  {
+    socket_.set_option(udp::generic_receive_offload(true));
+  }
+
+  void receive(std::size_t n)
+  {
+    remaining_ = n;
+    start();
+  }
+
+private:
+  void start()
+  {
+    socket_.async_receive_coalesced(asio::buffer(buffer_),
+        sender_, segment_size_, handler{this});
+  }
+
+  struct handler
+  {
+    coalesced_receiver* r;
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      if (ec)
+        return;
+      std::size_t datagrams = (n + r->segment_size_ - 1) / r->segment_size_;
+      if ((r->remaining_ -= datagrams) > 0)
+        r->start();
+    }
+  };
+
+  udp::socket& socket_;
+  std::vector<unsigned char> buffer_;
+  udp::endpoint sender_;
+  std::size_t segment_size_;
+  std::size_t remaining_;
+};
+
+#endif // defined(ASIO_HAS_UDP_GSO) && defined(ASIO_HAS_UDP_GRO)
+
+template <typename Receiver>
+void run(std::size_t buf_size, std::size_t batch_size,
+    int rounds, bool offload)
+{
+  asio::io_context io_context(1);
+
+  udp::socket receiver_socket(io_context,
+      udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  receiver_socket.set_option(
+      udp::socket::receive_buffer_size(4 * 1024 * 1024));
+  Receiver receiver(receiver_socket, buf_size, batch_size);
+
+  udp::socket sender_socket(io_context, udp::endpoint(udp::v4(), 0));
+  std::size_t segments = 1;
+#if defined(ASIO_HAS_UDP_GSO)
+  if (offload)
+  {
+    sender_socket.set_option(udp::segment_size(static_cast<int>(buf_size)));
+    segments = batch_size;
+  }
+#else // defined(ASIO_HAS_UDP_GSO)
+  (void)offload;
+#endif // defined(ASIO_HAS_UDP_GSO)
+  std::vector<unsigned char> data(buf_size * segments);
+  udp::endpoint target = receiver_socket.local_endpoint();
+
+  std::chrono::steady_clock::duration elapsed{};
+  for (int i = 0; i < rounds; ++i)
+  {
+    for (std::size_t j = 0; j < burst_size; j += segments)
+      sender_socket.send_to(asio::buffer(data), target);
+
+    std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+    receiver.receive(burst_size);
+    io_context.restart();
+    io_context.run();
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+
+  double seconds = std::chrono::duration<double>(elapsed).count();
+  double datagrams = static_cast<double>(burst_size) * rounds;
+  std::printf("%f datagrams/sec\t%f ns/datagram\n",
+      datagrams / seconds, seconds * 1e9 / datagrams);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: udp_ingest {single|batch|coalesced}"
+        " <bufsize> <batchsize> <rounds>\n");
+    return 1;
+  }
+
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[2]));
+  std::size_t batch_size = static_cast<std::size_t>(std::atoi(argv[3]));
+  int rounds = std::atoi(argv[4]);
+
+  if (std::strcmp(argv[1], "batch") == 0)
+    run<batch_receiver>(buf_size, batch_size, rounds, false);
+#if defined(ASIO_HAS_UDP_GSO) && defined(ASIO_HAS_UDP_GRO)
+  else if (std::strcmp(argv[1], "coalesced") == 0)
+    run<coalesced_receiver>(buf_size, batch_size, rounds, true);
+#endif // defined(ASIO_HAS_UDP_GSO) && defined(ASIO_HAS_UDP_GRO)
+  else
+    run<single_receiver>(buf_size, batch_size, rounds, false);
+}
@@ -0,0 +1,413 @@
+//
+// allocations.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route all of asio's memory through the global operator new, so that the
+// replacement in benchmark.hpp sees every allocation.
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+
+#include "asio.hpp"
+#include "asio/experimental/channel.hpp"
+#include "asio/experimental/parallel_group.hpp"
+#include <cstring>
+#include "benchmark.hpp"
+
+//------------------------------------------------------------------------------
+
+// Benchmarks using completion handlers. Each handler starts the next
+// iteration, so that an operation's memory can be recycled by the next.
+
+struct post_handler
+{
+  asio::io_context* ctx;
+  benchmark* b;
+
+  void operator()()
+  {
+    if (b->next())
+      asio::post(*ctx, *this);
+  }
+};
+
+struct dispatch_handler
+{
+  benchmark* b;
+
+  void operator()() {}
+};
+
+struct dispatch_loop
+{
+  asio::io_context* ctx;
+  benchmark* b;
+
+  void operator()()
+  {
+    // The handler is invoked immediately, since we are inside run().
+    while (b->next())
+      asio::dispatch(*ctx, dispatch_handler{b});
+  }
+};
+
+struct strand_handler
+{
+  asio::strand<asio::io_context::executor_type>* s;
+  benchmark* b;
+
+  void operator()()
+  {
+    if (b->next())
+      asio::post(*s, *this);
+  }
+};
+
+struct timer_handler
+{
+  asio::steady_timer* t;
+  benchmark* b;
+
+  void operator()(const asio::error_code&)
+  {
+    if (b->next())
+    {
+      t->expires_at(asio::steady_timer::time_point::min());
+      t->async_wait(*this);
+    }
+  }
+};
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+struct socket_pair
+{
+  explicit socket_pair(asio::io_context& ctx)
+    : writer(ctx),
+      reader(ctx)
+  {
+    asio::local::connect_pair(writer, reader);
+    std::memset(write_data, 'x', sizeof(write_data));
+  }
+
+  asio::local::stream_protocol::socket writer;
+  asio::local::stream_protocol::socket reader;
+  char write_data[64];
+  char read_data[64];
+};
+
+struct socket_handler
+{
+  socket_pair* p;
+  benchmark* b;
+
+  void start()
+  {
+    asio::async_write(p->writer, asio::buffer(p->write_data),
+        [](const asio::error_code&, std::size_t) {});
+    p->reader.async_read_some(asio::buffer(p->read_data), *this);
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t)
+  {
+    if (!ec && b->next())
+      start();
+  }
+};
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+asio::awaitable<void> empty_coroutine()
+{
+  co_return;
+}
+
+struct co_spawn_handler
+{
+  asio::io_context* ctx;
+  benchmark* b;
+
+  void operator()(std::exception_ptr)
+  {
+    if (b->next())
+      asio::co_spawn(*ctx, empty_coroutine(), *this);
+  }
+};
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+struct parallel_group_handler
+{
+  asio::io_context* ctx;
+  benchmark* b;
+
+  void start()
+  {
+    asio::experimental::make_parallel_group(
+        asio::post(*ctx, asio::deferred),
+        asio::post(*ctx, asio::deferred)
+      ).async_wait(asio::experimental::wait_for_all(), *this);
+  }
+
+  void operator()(std::array<std::size_t, 2>)
+  {
+    if (b->next())
+      start();
+  }
+};
+
+typedef asio::experimental::channel<void(asio::error_code, int)> int_channel;
+
+struct channel_handler
+{
+  int_channel* ch;
+  benchmark* b;
+
+  void start()
+  {
+    ch->async_send(asio::error_code(), 42,
+        [](const asio::error_code&) {});
+    ch->async_receive(*this);
+  }
+
+  void operator()(const asio::error_code& ec, int)
+  {
+    if (!ec && b->next())
+      start();
+  }
+};
+
+void run_callback_benchmarks()
+{
+  {
+    benchmark b("post", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      asio::post(ctx, post_handler{&ctx, &b});
+      ctx.run();
+      b.report();
+    }
+  }
+
+  {
+    benchmark b("dispatch", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      asio::post(ctx, dispatch_loop{&ctx, &b});
+      ctx.run();
+      b.report();
+    }
+  }
+
+  {
+    benchmark b("strand_post", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      asio::strand<asio::io_context::executor_type> s(ctx.get_executor());
+      asio::post(s, strand_handler{&s, &b});
+      ctx.run();
+      b.report();
+    }
+  }
+
+  {
+    benchmark b("timer_wait", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      asio::steady_timer t(ctx, asio::steady_timer::time_point::min());
+      t.async_wait(timer_handler{&t, &b});
+      ctx.run();
+      b.report();
+    }
+  }
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  {
+    benchmark b("socket_read_write", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      socket_pair p(ctx);
+      socket_handler{&p, &b}.start();
+      ctx.run();
+      b.report();
+    }
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_CO_AWAIT)
+  {
+    benchmark b("co_spawn", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      asio::co_spawn(ctx, empty_coroutine(), co_spawn_handler{&ctx, &b});
+      ctx.run();
+      b.report();
+    }
+  }
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+  {
+    benchmark b("parallel_group", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      parallel_group_handler{&ctx, &b}.start();
+      ctx.run();
+      b.report();
+    }
+  }
+
+  {
+    benchmark b("channel", "callback");
+    if (b.enabled())
+    {
+      asio::io_context ctx;
+      int_channel ch(ctx, 1);
+      channel_handler{&ch, &b}.start();
+      ctx.run();
+      b.report();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
+// Benchmarks using use_awaitable. Each benchmark is a single coroutine that
+// performs all iterations.
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+asio::awaitable<void> post_coroutine(benchmark& b)
+{
+  while (b.next())
+    co_await asio::post(asio::use_awaitable);
+}
+
+asio::awaitable<void> dispatch_coroutine(benchmark& b)
+{
+  while (b.next())
+    co_await asio::dispatch(asio::use_awaitable);
+}
+
+asio::awaitable<void> strand_post_coroutine(benchmark& b)
+{
+  asio::strand<asio::any_io_executor> s(co_await asio::this_coro::executor);
+  while (b.next())
+    co_await asio::post(s, asio::use_awaitable);
+}
+
+asio::awaitable<void> timer_wait_coroutine(benchmark& b)
+{
+  asio::steady_timer t(co_await asio::this_coro::executor);
+  while (b.next())
+  {
+    t.expires_at(asio::steady_timer::time_point::min());
+    co_await t.async_wait(asio::use_awaitable);
+  }
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+asio::awaitable<void> socket_read_write_coroutine(benchmark& b)
+{
+  asio::any_io_executor ex = co_await asio::this_coro::executor;
+  asio::local::stream_protocol::socket writer(ex), reader(ex);
+  asio::local::connect_pair(writer, reader);
+
+  char write_data[64], read_data[64];
+  std::memset(write_data, 'x', sizeof(write_data));
+  while (b.next())
+  {
+    co_await asio::async_write(writer,
+        asio::buffer(write_data), asio::use_awaitable);
+    co_await reader.async_read_some(
+        asio::buffer(read_data), asio::use_awaitable);
+  }
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+asio::awaitable<void> co_spawn_coroutine(benchmark& b)
+{
+  asio::any_io_executor ex = co_await asio::this_coro::executor;
+  while (b.next())
+    co_await asio::co_spawn(ex, empty_coroutine(), asio::use_awaitable);
+}
+
+asio::awaitable<void> parallel_group_coroutine(benchmark& b)
+{
+  asio::any_io_executor ex = co_await asio::this_coro::executor;
+  while (b.next())
+  {
+    co_await asio::experimental::make_parallel_group(
+        asio::post(ex, asio::deferred),
+        asio::post(ex, asio::deferred)
+      ).async_wait(asio::experimental::wait_for_all(), asio::use_awaitable);
+  }
+}
+
+asio::awaitable<void> channel_coroutine(benchmark& b)
+{
+  int_channel ch(co_await asio::this_coro::executor, 1);
+  while (b.next())
+  {
+    co_await ch.async_send(asio::error_code(), 42, asio::use_awaitable);
+    co_await ch.async_receive(asio::use_awaitable);
+  }
+}
+
+void run_awaitable_benchmark(const char* name,
+    asio::awaitable<void> (*coroutine)(benchmark&))
+{
+  benchmark b(name, "awaitable");
+  if (b.enabled())
+  {
+    asio::io_context ctx;
+    asio::co_spawn(ctx, coroutine(b), asio::detached);
+    ctx.run();
+    b.report();
+  }
+}
+
+void run_awaitable_benchmarks()
+{
+  run_awaitable_benchmark("post", post_coroutine);
+  run_awaitable_benchmark("dispatch", dispatch_coroutine);
+  run_awaitable_benchmark("strand_post", strand_post_coroutine);
+  run_awaitable_benchmark("timer_wait", timer_wait_coroutine);
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  run_awaitable_benchmark("socket_read_write", socket_read_write_coroutine);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+  run_awaitable_benchmark("co_spawn", co_spawn_coroutine);
+  run_awaitable_benchmark("parallel_group", parallel_group_coroutine);
+  run_awaitable_benchmark("channel", channel_coroutine);
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+  if (!start_benchmarks(argc, argv, "allocations"))
+    return 1;
+
+  run_callback_benchmarks();
+#if defined(ASIO_HAS_CO_AWAIT)
+  run_awaitable_benchmarks();
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+  return 0;
+}
@@ -0,0 +1,204 @@
+//
+// benchmark.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef PERFORMANCE_BENCHMARK_HPP
+#define PERFORMANCE_BENCHMARK_HPP
+
+// Support for benchmarks that report allocations and time per operation. This
+// header replaces the global operator new and delete, and so must be included
+// by only one source file in a program. Define ASIO_DISABLE_STD_ALIGNED_ALLOC
+// before including any asio header so that all of asio's memory is counted.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+//------------------------------------------------------------------------------
+
+// Global operator new and delete, replaced to count allocations.
+
+// GCC cannot tell that the replaced operator delete is paired with the
+// replaced operator new when it inlines them.
+#if defined(__GNUC__) && (__GNUC__ >= 11) && !defined(__clang__)
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // defined(__GNUC__) && (__GNUC__ >= 11) && !defined(__clang__)
+
+namespace {
+
+std::atomic<std::size_t> allocation_count(0);
+std::atomic<std::size_t> allocation_bytes(0);
+
+void* counted_allocate(std::size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  if (void* p = counted_allocate(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  if (void* p = counted_allocate(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+//------------------------------------------------------------------------------
+
+// Measures the steady-state cost of an operation. Each benchmark performs a
+// number of warm-up iterations, so that the recycling allocator caches are
+// populated, and then the measured iterations. Asynchronous benchmarks should
+// perform all iterations within a single call to io_context::run(), as the
+// caches belong to the thread running the io_context.
+
+const char* filter = 0;
+std::size_t iterations = 100000;
+
+class benchmark
+{
+public:
+  benchmark(const char* name, const char* model)
+    : name_(name),
+      model_(model),
+      warmup_(iterations / 10 + 1),
+      count_(0),
+      allocations_(0),
+      bytes_(0)
+  {
+  }
+
+  // Whether the benchmark was selected on the command line.
+  bool enabled() const
+  {
+    return !filter || std::strstr(name_, filter) || std::strstr(model_, filter);
+  }
+
+  // Called once per iteration. Returns false when all iterations are done.
+  bool next()
+  {
+    ++count_;
+    if (count_ == warmup_)
+    {
+      allocations_ = allocation_count.load(std::memory_order_relaxed);
+      bytes_ = allocation_bytes.load(std::memory_order_relaxed);
+      start_ = std::chrono::steady_clock::now();
+    }
+    else if (count_ == warmup_ + iterations)
+    {
+      std::chrono::steady_clock::duration elapsed =
+        std::chrono::steady_clock::now() - start_;
+      allocations_ = allocation_count.load(std::memory_order_relaxed)
+        - allocations_;
+      bytes_ = allocation_bytes.load(std::memory_order_relaxed) - bytes_;
+      ns_ = std::chrono::duration<double, std::nano>(elapsed).count();
+      return false;
+    }
+    return true;
+  }
+
+  // Write the results as a single comma-separated line.
+  void report() const
+  {
+    if (count_ != warmup_ + iterations)
+    {
+      std::printf("%s,%s,%lu,,,\n", name_, model_,
+          static_cast<unsigned long>(iterations));
+      return;
+    }
+
+    std::printf("%s,%s,%lu,%.3f,%.1f,%.1f\n", name_, model_,
+        static_cast<unsigned long>(iterations),
+        static_cast<double>(allocations_) / iterations,
+        static_cast<double>(bytes_) / iterations,
+        ns_ / iterations);
+    std::fflush(stdout);
+  }
+
+private:
+  const char* name_;
+  const char* model_;
+  std::size_t warmup_;
+  std::size_t count_;
+  std::size_t allocations_;
+  std::size_t bytes_;
+  std::chrono::steady_clock::time_point start_;
+  double ns_;
+};
+
+//------------------------------------------------------------------------------
+
+// Parse the command line and write the heading of the results. Returns false
+// if the arguments are invalid.
+inline bool start_benchmarks(int argc, char* argv[], const char* program)
+{
+  if (argc > 3)
+  {
+    std::fprintf(stderr, "Usage: %s [<iterations> [<filter>]]\n", program);
+    return false;
+  }
+
+  if (argc > 1)
+    iterations = std::strtoul(argv[1], 0, 0);
+  if (argc > 2)
+    filter = argv[2];
+
+  if (iterations == 0)
+  {
+    std::fprintf(stderr, "Iterations must be greater than zero\n");
+    return false;
+  }
+
+  std::printf("benchmark,model,iterations,"
+      "allocations_per_op,bytes_per_op,ns_per_op\n");
+  return true;
+}
+
+#endif // PERFORMANCE_BENCHMARK_HPP
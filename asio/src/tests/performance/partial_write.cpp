@@ -0,0 +1,148 @@
+//
+// partial_write.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route all of asio's memory through the global operator new, so that the
+// replacement in benchmark.hpp sees every allocation.
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
+#include <list>
+#include <vector>
+#include "benchmark.hpp"
+
+// Measures the cost of writing a long buffer sequence to a stream that
+// accepts only part of the data on each call, as a socket with a full send
+// buffer does. Each write_some call translates the buffers to their native
+// representation, as the reactor does before calling the operating system,
+// and then accepts at most 1KB. Writing the 64KB sequence therefore takes 64
+// partial writes.
+
+const std::size_t slice_size = 64;
+const std::size_t slice_count = 1024;
+const std::size_t accept_size = 1024;
+
+char slice_data[slice_size * slice_count];
+
+std::size_t volatile sink;
+
+class partial_stream
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+
+  explicit partial_stream(asio::io_context& ctx)
+    : ctx_(ctx)
+  {
+  }
+
+  executor_type get_executor()
+  {
+    return ctx_.get_executor();
+  }
+
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    asio::detail::buffer_sequence_adapter<
+      asio::const_buffer, ConstBufferSequence> bufs(buffers);
+    sink = bufs.count();
+    ec = asio::error_code();
+    return bufs.total_size() < accept_size ? bufs.total_size() : accept_size;
+  }
+
+  template <typename ConstBufferSequence, typename Handler>
+  void async_write_some(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    asio::error_code ec;
+    std::size_t n = write_some(buffers, ec);
+    asio::post(ctx_, asio::detail::bind_handler(
+          ASIO_MOVE_CAST(Handler)(handler), ec, n));
+  }
+
+private:
+  asio::io_context& ctx_;
+};
+
+template <typename Buffers>
+Buffers make_slices()
+{
+  Buffers buffers;
+  for (std::size_t i = 0; i < slice_count; ++i)
+    buffers.push_back(asio::buffer(slice_data + i * slice_size, slice_size));
+  return buffers;
+}
+
+template <typename Buffers>
+void run_write(const char* model, partial_stream& s)
+{
+  benchmark b("write", model);
+  if (b.enabled())
+  {
+    Buffers buffers = make_slices<Buffers>();
+    asio::error_code ec;
+    while (b.next())
+      asio::write(s, buffers, ec);
+    b.report();
+  }
+}
+
+template <typename Buffers>
+struct async_write_handler
+{
+  partial_stream* s;
+  const Buffers* buffers;
+  benchmark* b;
+
+  void operator()(const asio::error_code& ec, std::size_t)
+  {
+    if (!ec && b->next())
+      asio::async_write(*s, *buffers, *this);
+  }
+};
+
+template <typename Buffers>
+void run_async_write(const char* model,
+    asio::io_context& ctx, partial_stream& s)
+{
+  benchmark b("async_write", model);
+  if (b.enabled())
+  {
+    Buffers buffers = make_slices<Buffers>();
+    async_write_handler<Buffers> h = { &s, &buffers, &b };
+    asio::async_write(s, buffers, h);
+    ctx.run();
+    ctx.restart();
+    b.report();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (!start_benchmarks(argc, argv, "partial_write"))
+    return 1;
+
+  asio::io_context ctx;
+  partial_stream s(ctx);
+
+  typedef std::vector<asio::const_buffer> vector_type;
+  typedef std::list<asio::const_buffer> list_type;
+
+  run_write<vector_type>("vector_1k", s);
+  run_write<list_type>("list_1k", s);
+  run_async_write<vector_type>("vector_1k", ctx, s);
+  run_async_write<list_type>("list_1k", ctx, s);
+
+  return 0;
+}
@@ -0,0 +1,231 @@
+//
+// read_until.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route all of asio's memory through the global operator new, so that the
+// replacement in benchmark.hpp sees every allocation.
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+
+#include "asio/buffers_iterator.hpp"
+#include "asio/detail/buffer_search.hpp"
+#include "asio/read_until.hpp"
+#include "asio/streambuf.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+
+// Compares the delimiter search used by read_until, which scans each
+// contiguous buffer with memchr, against a byte-by-byte scan through
+// buffers_iterator. The search benchmarks look for a delimiter at the end of
+// 16KB of data, held either in one buffer or in a sequence of 1KB buffers.
+// The read_until benchmarks parse lines from a stream held in memory.
+
+const std::size_t data_size = 16384;
+const std::size_t segment_size = 1024;
+const std::size_t line_size = 100;
+
+std::size_t volatile sink;
+
+std::string make_data(const char* delim)
+{
+  std::string data(data_size, 'x');
+  for (std::size_t i = 0; i < data_size; i += 50)
+    data[i] = '\r';
+  data.replace(data_size - std::strlen(delim), std::strlen(delim), delim);
+  return data;
+}
+
+std::vector<asio::const_buffer> make_segments(const std::string& data)
+{
+  std::vector<asio::const_buffer> buffers;
+  for (std::size_t i = 0; i < data.size(); i += segment_size)
+    buffers.push_back(asio::buffer(&data[i], segment_size));
+  return buffers;
+}
+
+template <typename Buffers>
+std::size_t find_char_iterator(const Buffers& buffers)
+{
+  typedef asio::buffers_iterator<Buffers> iterator;
+  iterator begin = iterator::begin(buffers);
+  return std::find(begin, iterator::end(buffers), '\n') - begin;
+}
+
+template <typename Buffers>
+std::size_t find_char_memchr(const Buffers& buffers)
+{
+  return asio::detail::buffer_find(buffers, 0, '\n').first;
+}
+
+template <typename Buffers>
+std::size_t search_string_iterator(const Buffers& buffers)
+{
+  typedef asio::buffers_iterator<Buffers> iterator;
+  const char delim[] = "\r\n\r\n";
+  iterator begin = iterator::begin(buffers);
+  return asio::detail::partial_search(begin,
+      iterator::end(buffers), delim, delim + 4).first - begin;
+}
+
+template <typename Buffers>
+std::size_t search_string_memchr(const Buffers& buffers)
+{
+  return asio::detail::buffer_partial_search(
+      buffers, 0, "\r\n\r\n", 4).first;
+}
+
+template <typename Buffers>
+void run_search(const char* name, const char* model,
+    std::size_t (*search)(const Buffers&), const Buffers& buffers)
+{
+  benchmark b(name, model);
+  if (b.enabled())
+  {
+    while (b.next())
+      sink = search(buffers);
+    b.report();
+  }
+}
+
+class memory_stream
+{
+public:
+  explicit memory_stream(const std::string& data)
+    : data_(data),
+      position_(0)
+  {
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    if (position_ == data_.size())
+      position_ = 0;
+    std::size_t n = asio::buffer_copy(buffers, asio::buffer(data_) + position_);
+    position_ += n;
+    ec = asio::error_code();
+    return n;
+  }
+
+private:
+  std::string data_;
+  std::size_t position_;
+};
+
+std::string make_lines(const char* delim)
+{
+  std::string line(line_size - std::strlen(delim), 'x');
+  line += delim;
+  std::string data;
+  while (data.size() + line.size() <= data_size)
+    data += line;
+  return data;
+}
+
+void run_read_until_char(const char* model)
+{
+  benchmark b("read_until_char", model);
+  if (b.enabled())
+  {
+    memory_stream s(make_lines("\n"));
+    asio::streambuf sb;
+    std::string str;
+    bool streambuf = std::strcmp(model, "streambuf") == 0;
+    asio::error_code ec;
+    while (b.next())
+    {
+      if (streambuf)
+      {
+        std::size_t n = asio::read_until(s, sb, '\n', ec);
+        sb.consume(n);
+        sink = n;
+      }
+      else
+      {
+        std::size_t n = asio::read_until(s,
+            asio::dynamic_buffer(str), '\n', ec);
+        str.erase(0, n);
+        sink = n;
+      }
+    }
+    b.report();
+  }
+}
+
+void run_read_until_string(const char* model)
+{
+  benchmark b("read_until_string", model);
+  if (b.enabled())
+  {
+    memory_stream s(make_lines("\r\n"));
+    asio::streambuf sb;
+    std::string str;
+    bool streambuf = std::strcmp(model, "streambuf") == 0;
+    asio::error_code ec;
+    while (b.next())
+    {
+      if (streambuf)
+      {
+        std::size_t n = asio::read_until(s, sb, "\r\n", ec);
+        sb.consume(n);
+        sink = n;
+      }
+      else
+      {
+        std::size_t n = asio::read_until(s,
+            asio::dynamic_buffer(str), "\r\n", ec);
+        str.erase(0, n);
+        sink = n;
+      }
+    }
+    b.report();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (!start_benchmarks(argc, argv, "read_until"))
+    return 1;
+
+  std::string char_data = make_data("\n");
+  asio::const_buffer char_buffer = asio::buffer(char_data);
+  std::vector<asio::const_buffer> char_segments = make_segments(char_data);
+
+  run_search("find_char_iterator", "contiguous",
+      find_char_iterator, char_buffer);
+  run_search("find_char_memchr", "contiguous",
+      find_char_memchr, char_buffer);
+  run_search("find_char_iterator", "segmented",
+      find_char_iterator, char_segments);
+  run_search("find_char_memchr", "segmented",
+      find_char_memchr, char_segments);
+
+  std::string string_data = make_data("\r\n\r\n");
+  asio::const_buffer string_buffer = asio::buffer(string_data);
+  std::vector<asio::const_buffer> string_segments = make_segments(string_data);
+
+  run_search("search_string_iterator", "contiguous",
+      search_string_iterator, string_buffer);
+  run_search("search_string_memchr", "contiguous",
+      search_string_memchr, string_buffer);
+  run_search("search_string_iterator", "segmented",
+      search_string_iterator, string_segments);
+  run_search("search_string_memchr", "segmented",
+      search_string_memchr, string_segments);
+
+  run_read_until_char("string");
+  run_read_until_char("streambuf");
+  run_read_until_string("string");
+  run_read_until_string("streambuf");
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+//
+// scatter_gather.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route all of asio's memory through the global operator new, so that the
+// replacement in benchmark.hpp sees every allocation.
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+
+#include "asio/io_context.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+#include "asio/write.hpp"
+#include <fcntl.h>
+#include <list>
+#include <vector>
+#include "benchmark.hpp"
+
+// Measures the cost of writing long buffer sequences, such as a response built
+// from many slices, to a descriptor that accepts all data. The cost is
+// dominated by the number of system calls needed to write each sequence.
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+const std::size_t slice_size = 64;
+const std::size_t slice_count = 1000;
+
+char slice_data[slice_size * slice_count];
+
+template <typename Buffers>
+Buffers make_slices()
+{
+  Buffers buffers;
+  for (std::size_t i = 0; i < slice_count; ++i)
+    buffers.push_back(asio::buffer(slice_data + i * slice_size, slice_size));
+  return buffers;
+}
+
+template <typename Buffers>
+void run_write_some(const char* model, asio::posix::stream_descriptor& d)
+{
+  benchmark b("write_some", model);
+  if (b.enabled())
+  {
+    Buffers buffers = make_slices<Buffers>();
+    while (b.next())
+      d.write_some(buffers);
+    b.report();
+  }
+}
+
+template <typename Buffers>
+void run_write(const char* model, asio::posix::stream_descriptor& d)
+{
+  benchmark b("write", model);
+  if (b.enabled())
+  {
+    Buffers buffers = make_slices<Buffers>();
+    while (b.next())
+      asio::write(d, buffers);
+    b.report();
+  }
+}
+
+template <typename Buffers>
+struct async_write_handler
+{
+  asio::posix::stream_descriptor* d;
+  const Buffers* buffers;
+  benchmark* b;
+
+  void operator()(const asio::error_code& ec, std::size_t)
+  {
+    if (!ec && b->next())
+      asio::async_write(*d, *buffers, *this);
+  }
+};
+
+template <typename Buffers>
+void run_async_write(const char* model,
+    asio::io_context& ctx, asio::posix::stream_descriptor& d)
+{
+  benchmark b("async_write", model);
+  if (b.enabled())
+  {
+    Buffers buffers = make_slices<Buffers>();
+    async_write_handler<Buffers> h = { &d, &buffers, &b };
+    asio::async_write(d, buffers, h);
+    ctx.run();
+    ctx.restart();
+    b.report();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (!start_benchmarks(argc, argv, "scatter_gather"))
+    return 1;
+
+  asio::io_context ctx;
+  asio::posix::stream_descriptor d(ctx, ::open("/dev/null", O_WRONLY));
+
+  typedef std::vector<asio::const_buffer> vector_type;
+  typedef std::list<asio::const_buffer> list_type;
+
+  run_write_some<vector_type>("vector_1k", d);
+  run_write_some<list_type>("list_1k", d);
+  run_write<vector_type>("vector_1k", d);
+  run_write<list_type>("list_1k", d);
+  run_async_write<vector_type>("vector_1k", ctx, d);
+  run_async_write<list_type>("list_1k", ctx, d);
+
+  return 0;
+}
+
+#else // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+int main()
+{
+  return 0;
+}
+
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
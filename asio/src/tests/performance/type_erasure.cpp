@@ -0,0 +1,224 @@
+//
+// type_erasure.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route all of asio's memory through the global operator new, so that the
+// replacement in benchmark.hpp sees every allocation.
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+
+#include "asio/any_completion_handler.hpp"
+#include "asio/any_io_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+#include "benchmark.hpp"
+
+// Measures the cost of using executors and completion handlers through the
+// type-erased wrappers, compared with using them directly. The inline storage
+// of the wrappers is set with ASIO_ANY_EXECUTOR_INLINE_SIZE and
+// ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE.
+
+void* volatile sink;
+
+// Run a function inside io_context::run(), so that the recycling allocator
+// caches are available to it.
+template <typename Function>
+void run_in_context(Function f)
+{
+  asio::io_context ctx;
+  asio::post(ctx, f);
+  ctx.run();
+}
+
+//------------------------------------------------------------------------------
+
+// Post a chain of handlers, each of which holds a copy of the executor.
+
+template <typename Executor>
+struct post_handler
+{
+  Executor ex;
+  benchmark* b;
+
+  void operator()()
+  {
+    if (b->next())
+      asio::post(ex, *this);
+  }
+};
+
+template <typename Executor>
+void run_post(const char* model, asio::io_context& ctx, const Executor& ex)
+{
+  benchmark b("post", model);
+  if (b.enabled())
+  {
+    post_handler<Executor> h = { ex, &b };
+    asio::post(ex, h);
+    ctx.run();
+    ctx.restart();
+    b.report();
+  }
+}
+
+void run_post_benchmarks()
+{
+  asio::io_context ctx;
+
+  run_post("direct", ctx, ctx.get_executor());
+
+  run_post("any_io_executor", ctx,
+      asio::any_io_executor(ctx.get_executor()));
+
+  run_post("strand", ctx, asio::make_strand(ctx.get_executor()));
+
+  run_post("any_io_executor_strand", ctx,
+      asio::any_io_executor(asio::make_strand(ctx.get_executor())));
+
+  run_post("any_io_executor_any_strand", ctx,
+      asio::any_io_executor(
+        asio::strand<asio::any_io_executor>(
+          asio::any_io_executor(ctx.get_executor()))));
+}
+
+//------------------------------------------------------------------------------
+
+// Copy an executor into a type-erased wrapper.
+
+template <typename Executor>
+struct executor_copy_loop
+{
+  const char* model;
+  Executor ex;
+
+  void operator()()
+  {
+    benchmark b("executor_copy", model);
+    if (b.enabled())
+    {
+      while (b.next())
+      {
+        asio::any_io_executor copy(ex);
+        sink = &copy;
+      }
+      b.report();
+    }
+  }
+};
+
+template <typename Executor>
+void run_executor_copy(const char* model, const Executor& ex)
+{
+  executor_copy_loop<Executor> loop = { model, ex };
+  run_in_context(loop);
+}
+
+void run_executor_copy_benchmarks()
+{
+  asio::io_context ctx;
+
+  run_executor_copy("io_context", ctx.get_executor());
+
+  run_executor_copy("strand", asio::make_strand(ctx.get_executor()));
+
+  run_executor_copy("any_strand",
+      asio::strand<asio::any_io_executor>(
+        asio::any_io_executor(ctx.get_executor())));
+}
+
+//------------------------------------------------------------------------------
+
+// Wrap a completion handler in any_completion_handler and invoke it.
+
+template <std::size_t Size>
+struct handler
+{
+  int* result;
+  unsigned char data[Size];
+
+  void operator()(int value)
+  {
+    *result += value + data[0];
+  }
+};
+
+template <std::size_t Size>
+struct direct_handler_loop
+{
+  const char* model;
+
+  void operator()()
+  {
+    benchmark b("completion_handler", model);
+    if (b.enabled())
+    {
+      int result = 0;
+      handler<Size> h = { &result, { 0 } };
+      while (b.next())
+      {
+        handler<Size> copy(h);
+        sink = &copy;
+        copy(1);
+      }
+      b.report();
+    }
+  }
+};
+
+template <std::size_t Size>
+struct any_handler_loop
+{
+  const char* model;
+
+  void operator()()
+  {
+    benchmark b("completion_handler", model);
+    if (b.enabled())
+    {
+      int result = 0;
+      handler<Size> h = { &result, { 0 } };
+      while (b.next())
+      {
+        asio::any_completion_handler<void(int)> any_h(h);
+        sink = &any_h;
+        any_h(1);
+      }
+      b.report();
+    }
+  }
+};
+
+void run_completion_handler_benchmarks()
+{
+  direct_handler_loop<8> direct_small = { "direct_small" };
+  run_in_context(direct_small);
+
+  any_handler_loop<8> any_small = { "any_small" };
+  run_in_context(any_small);
+
+  direct_handler_loop<256> direct_large = { "direct_large" };
+  run_in_context(direct_large);
+
+  any_handler_loop<256> any_large = { "any_large" };
+  run_in_context(any_large);
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+  if (!start_benchmarks(argc, argv, "type_erasure"))
+    return 1;
+
+  run_post_benchmarks();
+  run_executor_copy_benchmarks();
+  run_completion_handler_benchmarks();
+
+  return 0;
+}
@@ -0,0 +1,214 @@
+//
+// write_queue.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route all of asio's memory through the global operator new, so that the
+// replacement in benchmark.hpp sees every allocation.
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
+#include "asio/write_queue.hpp"
+#include <cstdio>
+#include <deque>
+#include <string>
+#include "benchmark.hpp"
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+// Measures the cost of sending small messages over a connected pair of
+// sockets. A producer generates a burst of messages each time it runs, as an
+// application does when it handles an event. The per_message model writes
+// each message with its own async_write, as a hand-written outbound queue
+// typically does. The write_queue model pushes the messages onto a
+// write_queue, which combines the messages pending at each write into one.
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+const std::size_t message_size = 64;
+const std::size_t burst_size = 16;
+const std::size_t max_queued = 1024;
+
+// Reads and discards everything sent, until the expected number of bytes has
+// arrived.
+class reader
+{
+public:
+  explicit reader(socket_type& socket)
+    : socket_(socket),
+      bytes_read_(0),
+      bytes_expected_(0),
+      done_(false)
+  {
+  }
+
+  void start()
+  {
+    read_handler h = { this };
+    socket_.async_read_some(asio::buffer(data_), h);
+  }
+
+  void handle_read(const asio::error_code& ec, std::size_t n)
+  {
+    bytes_read_ += n;
+    if (!ec && !(done_ && bytes_read_ == bytes_expected_))
+      start();
+  }
+
+  void expect(std::size_t bytes)
+  {
+    bytes_expected_ = bytes;
+    done_ = true;
+    if (bytes_read_ == bytes_expected_)
+      socket_.cancel();
+  }
+
+private:
+  struct read_handler
+  {
+    reader* r;
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      r->handle_read(ec, n);
+    }
+  };
+
+  socket_type& socket_;
+  char data_[65536];
+  std::size_t bytes_read_;
+  std::size_t bytes_expected_;
+  bool done_;
+};
+
+// A typical hand-written queue, with one write in flight per message.
+class per_message_queue
+{
+public:
+  explicit per_message_queue(socket_type& socket)
+    : socket_(socket)
+  {
+  }
+
+  bool try_push(const asio::const_buffer& message)
+  {
+    if (queue_.size() >= max_queued)
+      return false;
+    queue_.push_back(std::string(
+          static_cast<const char*>(message.data()), message.size()));
+    if (queue_.size() == 1)
+      start_write();
+    return true;
+  }
+
+  void handle_write(const asio::error_code& ec)
+  {
+    queue_.pop_front();
+    if (!ec && !queue_.empty())
+      start_write();
+  }
+
+private:
+  struct write_handler
+  {
+    per_message_queue* q;
+
+    void operator()(const asio::error_code& ec, std::size_t)
+    {
+      q->handle_write(ec);
+    }
+  };
+
+  void start_write()
+  {
+    write_handler h = { this };
+    asio::async_write(socket_, asio::buffer(queue_.front()), h);
+  }
+
+  socket_type& socket_;
+  std::deque<std::string> queue_;
+};
+
+template <typename Queue>
+class producer
+{
+public:
+  producer(asio::io_context& ctx, Queue& queue, reader& r, benchmark& b)
+    : ctx_(ctx),
+      queue_(queue),
+      reader_(r),
+      benchmark_(b),
+      pushed_(0)
+  {
+    for (std::size_t i = 0; i < message_size; ++i)
+      message_[i] = static_cast<char>('a' + i % 26);
+  }
+
+  void operator()()
+  {
+    for (std::size_t i = 0; i < burst_size; ++i)
+    {
+      if (!queue_.try_push(asio::buffer(message_)))
+        break;
+      pushed_ += message_size;
+      if (!benchmark_.next())
+      {
+        reader_.expect(pushed_);
+        return;
+      }
+    }
+    asio::post(ctx_, *this);
+  }
+
+private:
+  asio::io_context& ctx_;
+  Queue& queue_;
+  reader& reader_;
+  benchmark& benchmark_;
+  char message_[message_size];
+  std::size_t pushed_;
+};
+
+template <typename Queue>
+void run(const char* model)
+{
+  benchmark b("send", model);
+  if (b.enabled())
+  {
+    asio::io_context ctx(1);
+    socket_type s1(ctx), s2(ctx);
+    asio::local::connect_pair(s1, s2);
+    reader r(s2);
+    Queue queue(s1);
+    r.start();
+    asio::post(ctx, producer<Queue>(ctx, queue, r, b));
+    ctx.run();
+    b.report();
+  }
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+int main(int argc, char* argv[])
+{
+  if (!start_benchmarks(argc, argv, "write_queue"))
+    return 1;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  run<per_message_queue>("per_message");
+  run<asio::write_queue<socket_type&> >("write_queue");
+#else // defined(ASIO_HAS_LOCAL_SOCKETS)
+  std::printf("Local sockets not available on this platform.\n");
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+  return 0;
+}
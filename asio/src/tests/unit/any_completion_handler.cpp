@@ -0,0 +1,248 @@
+//
+// any_completion_handler.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/any_completion_handler.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_STD_TUPLE) \
+  && defined(ASIO_HAS_MOVE) \
+  && defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+#include <cstring>
+#include <memory>
+
+static int live_handlers = 0;
+
+template <std::size_t Size>
+struct counted_handler
+{
+  explicit counted_handler(int* result)
+    : result_(result)
+  {
+    std::memset(data_, 0, sizeof(data_));
+    ++live_handlers;
+  }
+
+  counted_handler(const counted_handler& other)
+    : result_(other.result_)
+  {
+    std::memcpy(data_, other.data_, sizeof(data_));
+    ++live_handlers;
+  }
+
+  counted_handler(counted_handler&& other) noexcept
+    : result_(other.result_)
+  {
+    std::memcpy(data_, other.data_, sizeof(data_));
+    ++live_handlers;
+  }
+
+  ~counted_handler()
+  {
+    --live_handlers;
+  }
+
+  void operator()(int value)
+  {
+    *result_ = value;
+  }
+
+  int* result_;
+  unsigned char data_[Size];
+};
+
+typedef counted_handler<1> small_handler;
+typedef counted_handler<1024> large_handler;
+
+static int allocations = 0;
+
+template <typename T>
+struct counting_allocator
+{
+  typedef T value_type;
+
+  counting_allocator()
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --allocations;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  friend bool operator==(const counting_allocator&, const counting_allocator&)
+  {
+    return true;
+  }
+
+  friend bool operator!=(const counting_allocator&, const counting_allocator&)
+  {
+    return false;
+  }
+};
+
+struct allocating_handler : small_handler
+{
+  typedef counting_allocator<void> allocator_type;
+
+  explicit allocating_handler(int* result)
+    : small_handler(result)
+  {
+  }
+
+  allocator_type get_allocator() const
+  {
+    return allocator_type();
+  }
+};
+
+typedef asio::any_completion_handler<void(int)> handler_type;
+
+template <typename Handler>
+void any_completion_handler_call_test_impl()
+{
+  int result = 0;
+  {
+    handler_type h1((Handler(&result)));
+    ASIO_CHECK(!!h1);
+    ASIO_CHECK(live_handlers == 1);
+
+    handler_type h2(std::move(h1));
+    ASIO_CHECK(!h1);
+    ASIO_CHECK(!!h2);
+    ASIO_CHECK(live_handlers == 1);
+
+    handler_type h3;
+    h3 = std::move(h2);
+    ASIO_CHECK(!h2);
+    ASIO_CHECK(!!h3);
+    ASIO_CHECK(live_handlers == 1);
+
+    h3(42);
+    ASIO_CHECK(!h3);
+    ASIO_CHECK(result == 42);
+    ASIO_CHECK(live_handlers == 0);
+
+    handler_type h4((Handler(&result)));
+    ASIO_CHECK(live_handlers == 1);
+  }
+  ASIO_CHECK(live_handlers == 0);
+}
+
+void any_completion_handler_call_test()
+{
+  any_completion_handler_call_test_impl<small_handler>();
+  any_completion_handler_call_test_impl<large_handler>();
+  any_completion_handler_call_test_impl<allocating_handler>();
+  ASIO_CHECK(allocations == 0);
+}
+
+void any_completion_handler_swap_test()
+{
+  int result1 = 0, result2 = 0, result3 = 0;
+  {
+    handler_type h1((small_handler(&result1)));
+    handler_type h2((large_handler(&result2)));
+    handler_type h3((small_handler(&result3)));
+    ASIO_CHECK(live_handlers == 3);
+
+    h1.swap(h2);
+    h2.swap(h3);
+    h3.swap(h3);
+    ASIO_CHECK(live_handlers == 3);
+
+    h1(1);
+    h2(2);
+    h3(3);
+    ASIO_CHECK(result1 == 3);
+    ASIO_CHECK(result2 == 1);
+    ASIO_CHECK(result3 == 2);
+    ASIO_CHECK(live_handlers == 0);
+
+    handler_type h4((small_handler(&result1)));
+    handler_type h5;
+    h4.swap(h5);
+    ASIO_CHECK(!h4);
+    ASIO_CHECK(!!h5);
+    ASIO_CHECK(live_handlers == 1);
+  }
+  ASIO_CHECK(live_handlers == 0);
+}
+
+void any_completion_handler_allocator_test()
+{
+  int result = 0;
+
+  // Handlers with a custom allocator use it for their own storage.
+  handler_type h1((allocating_handler(&result)));
+  ASIO_CHECK(allocations == 1);
+
+  handler_type::allocator_type a1 = h1.get_allocator();
+  asio::any_completion_handler_allocator<int, void(int)> a2(a1);
+  int* p = a2.allocate(1);
+  ASIO_CHECK(allocations == 2);
+  a2.deallocate(p, 1);
+  ASIO_CHECK(allocations == 1);
+
+  h1(1);
+  ASIO_CHECK(allocations == 0);
+
+  // An allocator remains usable after the handler is moved.
+  handler_type h2((small_handler(&result)));
+  asio::any_completion_handler_allocator<int, void(int)> a3(
+      h2.get_allocator());
+  handler_type h3(std::move(h2));
+  p = a3.allocate(1);
+  a3.deallocate(p, 1);
+  h3(2);
+  ASIO_CHECK(result == 2);
+  ASIO_CHECK(live_handlers == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "any_completion_handler",
+  ASIO_TEST_CASE(any_completion_handler_call_test)
+  ASIO_TEST_CASE(any_completion_handler_swap_test)
+  ASIO_TEST_CASE(any_completion_handler_allocator_test)
+)
+
+#else // defined(ASIO_HAS_STD_TUPLE)
+      //   && defined(ASIO_HAS_MOVE)
+      //   && defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+ASIO_TEST_SUITE
+(
+  "any_completion_handler",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_STD_TUPLE)
+       //   && defined(ASIO_HAS_MOVE)
+       //   && defined(ASIO_HAS_VARIADIC_TEMPLATES)
@@ -0,0 +1,218 @@
+//
+// arena.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/arena.hpp"
+
+#include <cstring>
+#include <utility>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+#if defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+#else // defined(ASIO_HAS_BOOST_BIND)
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void handle_transfer(const asio::error_code& err,
+    std::size_t bytes_transferred, asio::error_code* out_err,
+    std::size_t* out_bytes_transferred)
+{
+  *out_err = err;
+  *out_bytes_transferred = bytes_transferred;
+}
+
+void arena_copy_test()
+{
+  asio::arena a1(1024);
+  asio::arena a2(a1);
+  asio::arena a3;
+  a3 = a1;
+
+  ASIO_CHECK(a1.capacity() == 0);
+  ASIO_CHECK(a2.capacity() == 0);
+  ASIO_CHECK(a3.capacity() == 0);
+}
+
+void arena_socket_test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(asio::ip::address_v4::loopback());
+
+  tcp::socket client_socket(ioc);
+  tcp::socket server_socket(ioc);
+  client_socket.connect(server_endpoint);
+  acceptor.accept(server_socket);
+
+  asio::arena a;
+  client_socket.set_arena(a);
+
+  const char write_data[] = "The arena provides memory for this write";
+  char read_data[sizeof(write_data)] = "";
+  asio::error_code write_err, read_err;
+  std::size_t write_length = 0, read_length = 0;
+
+  asio::async_write(client_socket, asio::buffer(write_data),
+      bindns::bind(handle_transfer, _1, _2, &write_err, &write_length));
+  asio::async_read(server_socket, asio::buffer(read_data),
+      bindns::bind(handle_transfer, _1, _2, &read_err, &read_length));
+
+  // Only the client socket's operations use the arena.
+  std::size_t capacity = a.capacity();
+  ASIO_CHECK(capacity > 0);
+
+  ioc.run();
+
+  ASIO_CHECK(!write_err);
+  ASIO_CHECK(write_length == sizeof(write_data));
+  ASIO_CHECK(!read_err);
+  ASIO_CHECK(read_length == sizeof(read_data));
+  ASIO_CHECK(std::memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+  // Memory freed by completed operations is reused.
+  ioc.restart();
+  asio::async_write(client_socket, asio::buffer(write_data),
+      bindns::bind(handle_transfer, _1, _2, &write_err, &write_length));
+  asio::async_read(server_socket, asio::buffer(read_data),
+      bindns::bind(handle_transfer, _1, _2, &read_err, &read_length));
+  ioc.run();
+
+  ASIO_CHECK(!write_err);
+  ASIO_CHECK(!read_err);
+  ASIO_CHECK(a.capacity() == capacity);
+}
+
+void arena_unlocked_test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc(ASIO_CONCURRENCY_HINT_UNSAFE);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(asio::ip::address_v4::loopback());
+
+  tcp::socket client_socket(ioc);
+  tcp::socket server_socket(ioc);
+  client_socket.connect(server_endpoint);
+  acceptor.accept(server_socket);
+
+  // Only this thread starts and completes operations, so the arena does not
+  // need a mutex.
+  asio::arena a(4096, ASIO_CONCURRENCY_HINT_UNSAFE);
+  client_socket.set_arena(a);
+  server_socket.set_arena(a);
+
+  const char write_data[] = "An unlocked arena provides memory for this write";
+  char read_data[sizeof(write_data)] = "";
+  asio::error_code write_err, read_err;
+  std::size_t write_length = 0, read_length = 0;
+
+  std::size_t capacity = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    ioc.restart();
+    asio::async_write(client_socket, asio::buffer(write_data),
+        bindns::bind(handle_transfer, _1, _2, &write_err, &write_length));
+    asio::async_read(server_socket, asio::buffer(read_data),
+        bindns::bind(handle_transfer, _1, _2, &read_err, &read_length));
+    if (i == 0)
+      capacity = a.capacity();
+    ioc.run();
+
+    ASIO_CHECK(!write_err);
+    ASIO_CHECK(!read_err);
+    ASIO_CHECK(read_length == sizeof(read_data));
+  }
+
+  ASIO_CHECK(capacity > 0);
+  ASIO_CHECK(a.capacity() == capacity);
+}
+
+void arena_outstanding_test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(asio::ip::address_v4::loopback());
+
+  tcp::socket server_socket(ioc);
+  asio::error_code read_err;
+  std::size_t read_length = 0;
+  char read_data[16];
+
+  {
+    tcp::socket client_socket(ioc);
+    client_socket.connect(server_endpoint);
+    acceptor.accept(server_socket);
+
+    asio::arena a;
+    server_socket.set_arena(a);
+  }
+
+  // The socket keeps the arena alive after the arena object is destroyed.
+  asio::async_read(server_socket, asio::buffer(read_data),
+      bindns::bind(handle_transfer, _1, _2, &read_err, &read_length));
+
+  // The operation keeps the arena alive after the socket is destroyed.
+#if defined(ASIO_HAS_MOVE)
+  {
+    tcp::socket moved_socket(std::move(server_socket));
+    moved_socket.close();
+  }
+#else // defined(ASIO_HAS_MOVE)
+  server_socket.close();
+#endif // defined(ASIO_HAS_MOVE)
+
+  ioc.run();
+
+  ASIO_CHECK(read_err == asio::error::operation_aborted
+      || read_err == asio::error::eof);
+}
+
+ASIO_TEST_SUITE
+(
+  "arena",
+  ASIO_TEST_CASE(arena_copy_test)
+  ASIO_TEST_CASE(arena_socket_test)
+  ASIO_TEST_CASE(arena_unlocked_test)
+  ASIO_TEST_CASE(arena_outstanding_test)
+)
@@ -0,0 +1,153 @@
+//
+// buffer_algorithms.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/buffer_algorithms.hpp"
+
+#include <string>
+#include <vector>
+#include "unit_test.hpp"
+
+static const char test_data[] = "GET / HTTP/1.1\r\nHost: a\r\n\r\nbody";
+static const std::size_t test_size = sizeof(test_data) - 1;
+
+// Split the test data into buffers of the given size, with an empty buffer
+// between each pair.
+static std::vector<asio::const_buffer> split(std::size_t n)
+{
+  std::vector<asio::const_buffer> buffers;
+  for (std::size_t i = 0; i < test_size; i += n)
+  {
+    buffers.push_back(asio::buffer(test_data + i,
+          i + n < test_size ? n : test_size - i));
+    buffers.push_back(asio::const_buffer());
+  }
+  return buffers;
+}
+
+struct is_colon
+{
+  bool operator()(char c) const
+  {
+    return c == ':';
+  }
+};
+
+struct byte_sum
+{
+  unsigned long operator()(unsigned long sum, const asio::const_buffer& b) const
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(b.data());
+    for (std::size_t i = 0; i < b.size(); ++i)
+      sum += p[i];
+    return sum;
+  }
+};
+
+void find_test()
+{
+  asio::const_buffer contiguous = asio::buffer(test_data, test_size);
+  for (std::size_t n = 1; n <= 8; ++n)
+  {
+    std::vector<asio::const_buffer> buffers = split(n);
+
+    ASIO_CHECK(asio::buffer_find(contiguous, '\r') == 14);
+    ASIO_CHECK(asio::buffer_find(buffers, '\r') == 14);
+    ASIO_CHECK(asio::buffer_find(buffers, '\r', 14) == 14);
+    ASIO_CHECK(asio::buffer_find(buffers, '\r', 15) == 23);
+    ASIO_CHECK(asio::buffer_find(buffers, 'y') == test_size - 1);
+    ASIO_CHECK(asio::buffer_find(buffers, 'z') == test_size);
+    ASIO_CHECK(asio::buffer_find(buffers, 'G', 1) == test_size);
+    ASIO_CHECK(asio::buffer_find(buffers, 'G', 1000) == test_size);
+
+    ASIO_CHECK(asio::buffer_find_if(buffers, is_colon()) == 20);
+    ASIO_CHECK(asio::buffer_find_if(buffers, is_colon(), 21) == test_size);
+  }
+
+  std::vector<asio::const_buffer> empty;
+  ASIO_CHECK(asio::buffer_find(empty, 'a') == 0);
+  ASIO_CHECK(asio::buffer_find_if(empty, is_colon()) == 0);
+}
+
+void search_test()
+{
+  asio::const_buffer contiguous = asio::buffer(test_data, test_size);
+  for (std::size_t n = 1; n <= 8; ++n)
+  {
+    std::vector<asio::const_buffer> buffers = split(n);
+
+    ASIO_CHECK(asio::buffer_search(contiguous,
+          asio::buffer("\r\n\r\n", 4)) == 23);
+    ASIO_CHECK(asio::buffer_search(buffers,
+          asio::buffer("\r\n\r\n", 4)) == 23);
+    ASIO_CHECK(asio::buffer_search(buffers,
+          asio::buffer("\r\n", 2), 15) == 23);
+    ASIO_CHECK(asio::buffer_search(buffers,
+          asio::buffer("HTTP", 4)) == 6);
+
+    // A match that runs off the end of the data is not a match.
+    ASIO_CHECK(asio::buffer_search(buffers,
+          asio::buffer("body\r\n", 6)) == test_size);
+    ASIO_CHECK(asio::buffer_search(buffers,
+          asio::buffer("xyz", 3)) == test_size);
+  }
+}
+
+void mismatch_test()
+{
+  std::string other(test_data, test_size);
+  other[20] = ';';
+
+  for (std::size_t n = 1; n <= 8; ++n)
+  {
+    std::vector<asio::const_buffer> buffers1 = split(n);
+    for (std::size_t m = 1; m <= 8; ++m)
+    {
+      std::vector<asio::const_buffer> buffers2 = split(m);
+      ASIO_CHECK(asio::buffer_mismatch(buffers1, buffers2) == test_size);
+      ASIO_CHECK(asio::buffer_equal(buffers1, buffers2));
+    }
+
+    ASIO_CHECK(asio::buffer_mismatch(buffers1, asio::buffer(other)) == 20);
+    ASIO_CHECK(!asio::buffer_equal(buffers1, asio::buffer(other)));
+
+    // A prefix matches up to its own length, but is not equal.
+    asio::const_buffer prefix = asio::buffer(test_data, 10);
+    ASIO_CHECK(asio::buffer_mismatch(buffers1, prefix) == 10);
+    ASIO_CHECK(asio::buffer_mismatch(prefix, buffers1) == 10);
+    ASIO_CHECK(!asio::buffer_equal(buffers1, prefix));
+  }
+}
+
+void accumulate_test()
+{
+  unsigned long expected = byte_sum()(0, asio::buffer(test_data, test_size));
+  for (std::size_t n = 1; n <= 8; ++n)
+  {
+    std::vector<asio::const_buffer> buffers = split(n);
+    ASIO_CHECK(asio::buffer_accumulate(buffers, 0ul, byte_sum()) == expected);
+    ASIO_CHECK(asio::buffer_accumulate(buffers, 1ul, byte_sum())
+        == expected + 1);
+  }
+}
+
+ASIO_TEST_SUITE
+(
+  "buffer_algorithms",
+  ASIO_TEST_CASE(find_test)
+  ASIO_TEST_CASE(search_test)
+  ASIO_TEST_CASE(mismatch_test)
+  ASIO_TEST_CASE(accumulate_test)
+)
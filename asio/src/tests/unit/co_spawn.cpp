@@ -21,6 +21,7 @@
 #if defined(ASIO_HAS_CO_AWAIT)
 
 #include "asio/any_completion_handler.hpp"
+#include "asio/detached.hpp"
 #include "asio/io_context.hpp"
 
 asio::awaitable<void> void_returning_coroutine()
@@ -67,10 +68,40 @@ void test_co_spawn_with_any_completion_handler()
   ASIO_CHECK(result == 42);
 }
 
+asio::awaitable<int> nested_coroutine(int depth)
+{
+  if (depth == 0)
+    co_return 0;
+  co_return 1 + co_await nested_coroutine(depth - 1);
+}
+
+asio::awaitable<void> nested_coroutine_loop(int* result)
+{
+  for (int i = 0; i < 100; ++i)
+    *result += co_await nested_coroutine(8);
+}
+
+void test_co_spawn_frame_recycling()
+{
+  asio::io_context ctx;
+  int result = 0;
+
+  asio::co_spawn(ctx, nested_coroutine_loop(&result), asio::detached);
+  ctx.run();
+
+  ASIO_CHECK(result == 800);
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  // The whole chain of frames is recycled on each iteration.
+  ASIO_CHECK(ctx.recycling_allocator_cache_hits() >= 800);
+  ASIO_CHECK(ctx.recycling_allocator_cache_misses() <= 20);
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+}
+
 ASIO_TEST_SUITE
 (
   "co_spawn",
   ASIO_TEST_CASE(test_co_spawn_with_any_completion_handler)
+  ASIO_TEST_CASE(test_co_spawn_frame_recycling)
 )
 
 #else // defined(ASIO_HAS_CO_AWAIT)
@@ -296,6 +296,85 @@ private:
 
 asio::io_context::id test_service::id;
 
+void io_context_recycling_test()
+{
+  io_context ioc;
+  int count = 10;
+
+  // Each handler's memory is recycled for the handler that it posts.
+  asio::post(ioc, bindns::bind(decrement_to_zero, &ioc, &count));
+  ioc.run();
+
+  ASIO_CHECK(count == 0);
+#if !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  ASIO_CHECK(ioc.recycling_allocator_cache_hits() >= 9);
+  ASIO_CHECK(ioc.recycling_allocator_cache_misses() <= 1);
+#endif // !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+
+  // A depth of zero disables the caches.
+  io_context::count_type hits = ioc.recycling_allocator_cache_hits();
+  ioc.set_recycling_allocator_cache_depth(0);
+  ioc.restart();
+  count = 10;
+  asio::post(ioc, bindns::bind(decrement_to_zero, &ioc, &count));
+  ioc.run();
+
+  ASIO_CHECK(count == 0);
+  ASIO_CHECK(ioc.recycling_allocator_cache_hits() == hits);
+}
+
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
+void post_back(io_context* ioc, io_context* other, int* count, int rounds);
+
+void post_batch(io_context* ioc, io_context* other, int* count, int rounds)
+{
+  if (rounds == 0)
+  {
+    ioc->stop();
+    return;
+  }
+
+  // Memory for these handlers is allocated by this thread, and freed by the
+  // other io_context's thread when the handlers have run.
+  for (int i = 0; i < 8; ++i)
+    asio::post(*other, bindns::bind(increment, count));
+
+  // Start the next round once the other thread has run the batch.
+  asio::post(*other, bindns::bind(post_back, ioc, other, count, rounds - 1));
+}
+
+void post_back(io_context* ioc, io_context* other, int* count, int rounds)
+{
+  asio::post(*ioc, bindns::bind(post_batch, ioc, other, count, rounds));
+}
+
+void io_context_remote_recycling_test()
+{
+  io_context ioc1;
+  io_context ioc2;
+  asio::executor_work_guard<io_context::executor_type> work1
+    = asio::make_work_guard(ioc1);
+  asio::executor_work_guard<io_context::executor_type> work2
+    = asio::make_work_guard(ioc2);
+  int count = 0;
+
+  thread thread2(bindns::bind(io_context_run, &ioc2));
+  asio::post(ioc1, bindns::bind(post_batch, &ioc1, &ioc2, &count, 10));
+  ioc1.run();
+
+  work2.reset();
+  thread2.join();
+
+  // The memory freed by ioc2's thread is returned to ioc1's thread, so only
+  // the first rounds need to allocate new memory.
+  ASIO_CHECK(count == 80);
+  ASIO_CHECK(ioc1.recycling_allocator_cache_hits() >= 64);
+  ASIO_CHECK(ioc1.recycling_allocator_cache_misses() <= 26);
+}
+
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+
 void io_context_service_test()
 {
   asio::io_context ioc1;
@@ -570,6 +649,10 @@ ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
+  ASIO_TEST_CASE(io_context_recycling_test)
+#if defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
+  ASIO_TEST_CASE(io_context_remote_recycling_test)
+#endif // defined(ASIO_HAS_RECYCLING_REMOTE_FREE)
   ASIO_TEST_CASE(io_context_service_test)
   ASIO_TEST_CASE(io_context_executor_query_test)
   ASIO_TEST_CASE(io_context_executor_execute_test)
@@ -0,0 +1,157 @@
+//
+// io_context_strand_dynamic.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Give each strand its own implementation, and keep few unused ones.
+#define ASIO_ENABLE_DYNAMIC_STRAND_IMPLEMENTATIONS 1
+#define ASIO_STRAND_IMPLEMENTATIONS 4
+
+// Test that header file is self-contained.
+#include "asio/io_context_strand.hpp"
+
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+using namespace asio;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+typedef asio::detail::strand_service strand_service;
+typedef strand_service::strand_impl strand_impl;
+
+void increment_with_lock(io_context::strand* s, int* count)
+{
+  ASIO_CHECK(s->running_in_this_thread());
+  ++(*count);
+}
+
+void io_context_run(io_context* ioc)
+{
+  ioc->run();
+}
+
+void strand_dynamic_test()
+{
+  io_context ioc;
+  io_context::strand s1(ioc);
+  io_context::strand s2(ioc);
+  int count1 = 0;
+  int count2 = 0;
+
+  // Each strand has its own implementation, shared by its copies.
+  io_context::strand s3(s1);
+  ASIO_CHECK(s1 == s3);
+  ASIO_CHECK(s1 != s2);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    post(s1, bindns::bind(increment_with_lock, &s1, &count1));
+    post(s2, bindns::bind(increment_with_lock, &s2, &count2));
+  }
+
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  thread1.join();
+  thread2.join();
+
+  // The counts are not atomic, so any concurrent handlers would lose updates.
+  ASIO_CHECK(count1 == 1000);
+  ASIO_CHECK(count2 == 1000);
+}
+
+void strand_reuse_test()
+{
+  io_context ioc;
+  strand_service& service = use_service<strand_service>(ioc);
+
+  // Released implementations are kept for reuse by new strands, up to a
+  // limit of ASIO_STRAND_IMPLEMENTATIONS.
+  std::vector<strand_impl*> released;
+  {
+    strand_service::implementation_type impls[6];
+    for (int i = 0; i < 6; ++i)
+    {
+      service.construct(impls[i]);
+      released.push_back(impls[i]);
+    }
+
+    for (int i = 0; i < 6; ++i)
+      impls[i] = strand_service::implementation_type();
+  }
+
+  // The most recently kept implementation is reused first. The last two
+  // released did not fit and were deleted.
+  strand_service::implementation_type reused[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    service.construct(reused[i]);
+    ASIO_CHECK(reused[i] == released[3 - i]);
+  }
+
+  // An implementation is not released while a copy refers to it.
+  strand_service::implementation_type copy(reused[0]);
+  reused[0] = strand_service::implementation_type();
+  strand_service::implementation_type fresh;
+  service.construct(fresh);
+  ASIO_CHECK(fresh != copy);
+  ASIO_CHECK(fresh != reused[1]);
+}
+
+void destroy_strands(std::vector<io_context::strand>* strands)
+{
+  strands->clear();
+}
+
+void strand_outlives_io_context_test()
+{
+  std::vector<io_context::strand> strands;
+  std::vector<io_context::strand> other_strands;
+
+  io_context* ioc = new io_context;
+  for (int i = 0; i < 100; ++i)
+  {
+    strands.push_back(io_context::strand(*ioc));
+    other_strands.push_back(io_context::strand(*ioc));
+  }
+
+  // Release some strands while the io_context is being destroyed.
+  thread thread1(bindns::bind(destroy_strands, &other_strands));
+  delete ioc;
+  thread1.join();
+
+  // Strands released after the io_context has been destroyed delete their
+  // implementations.
+  strands.clear();
+}
+
+ASIO_TEST_SUITE
+(
+  "strand_dynamic",
+  ASIO_TEST_CASE(strand_dynamic_test)
+  ASIO_TEST_CASE(strand_reuse_test)
+  ASIO_TEST_CASE(strand_outlives_io_context_test)
+)
@@ -19,7 +19,9 @@
 // Test that header file is self-contained.
 #include "asio/ip/tcp.hpp"
 
+#include <cstdio>
 #include <cstring>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
 #include "asio/write.hpp"
@@ -43,6 +45,19 @@
 
 //------------------------------------------------------------------------------
 
+// Completion handler used by the runtime tests to check that a read or write
+// transferred the expected number of bytes.
+
+void handle_transfer(const asio::error_code& err,
+    std::size_t bytes_transferred, std::size_t expected_bytes, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes);
+}
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_compile test
 // ~~~~~~~~~~~~~~~~~~~
 // The following test checks that all nested classes, enums and constants in
@@ -71,6 +86,28 @@ void test()
     (void)static_cast<bool>(!no_delay1);
     (void)static_cast<bool>(no_delay1.value());
 
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+    // fast_open class.
+
+    ip::tcp::fast_open fast_open1(16);
+    sock.set_option(fast_open1);
+    ip::tcp::fast_open fast_open2;
+    sock.get_option(fast_open2);
+    fast_open1 = 16;
+    (void)static_cast<int>(fast_open1.value());
+
+    // fast_open_connect class.
+
+    ip::tcp::fast_open_connect fast_open_connect1(true);
+    sock.set_option(fast_open_connect1);
+    ip::tcp::fast_open_connect fast_open_connect2;
+    sock.get_option(fast_open_connect2);
+    fast_open_connect1 = true;
+    (void)static_cast<bool>(fast_open_connect1);
+    (void)static_cast<bool>(!fast_open_connect1);
+    (void)static_cast<bool>(fast_open_connect1.value());
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
 #if defined(ASIO_HAS_STD_HASH)
     ip::tcp::endpoint ep;
     (void)static_cast<std::size_t>(std::hash<ip::tcp::endpoint>()(ep));
@@ -129,6 +166,32 @@ void test()
   ASIO_CHECK(!no_delay4.value());
   ASIO_CHECK(!static_cast<bool>(no_delay4));
   ASIO_CHECK(!no_delay4);
+
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+  // fast_open class.
+
+  ip::tcp::fast_open fast_open1(16);
+  ASIO_CHECK(fast_open1.value() == 16);
+  sock.set_option(fast_open1, ec);
+  ASIO_CHECK(!ec);
+
+  ip::tcp::fast_open fast_open2;
+  sock.get_option(fast_open2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(fast_open2.value() == 16);
+
+  // fast_open_connect class.
+
+  ip::tcp::fast_open_connect fast_open_connect1(true);
+  ASIO_CHECK(fast_open_connect1.value());
+  sock.set_option(fast_open_connect1, ec);
+  ASIO_CHECK(!ec);
+
+  ip::tcp::fast_open_connect fast_open_connect2;
+  sock.get_option(fast_open_connect2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(fast_open_connect2.value());
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
 }
 
 } // namespace ip_tcp_runtime
@@ -658,6 +721,41 @@ void test()
   ASIO_CHECK(write_completed);
   ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Zero-copy write of a buffer large enough to use MSG_ZEROCOPY.
+
+  asio::error_code zero_copy_ec;
+  server_side_socket.set_option(
+      socket_base::zero_copy(true), zero_copy_ec);
+  if (!zero_copy_ec)
+  {
+    std::vector<char> zero_copy_data(256 * 1024);
+    for (size_t i = 0; i < zero_copy_data.size(); ++i)
+      zero_copy_data[i] = static_cast<char>(i % 251);
+    std::vector<char> zero_copy_read_buffer(zero_copy_data.size());
+
+    bool zero_copy_read_completed = false;
+    asio::async_read(client_side_socket,
+        asio::buffer(zero_copy_read_buffer),
+        bindns::bind(handle_transfer, _1, _2,
+          zero_copy_data.size(), &zero_copy_read_completed));
+
+    bool zero_copy_write_completed = false;
+    asio::async_write(server_side_socket,
+        asio::buffer(zero_copy_data),
+        bindns::bind(handle_transfer, _1, _2,
+          zero_copy_data.size(), &zero_copy_write_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(zero_copy_read_completed);
+    ASIO_CHECK(zero_copy_write_completed);
+    ASIO_CHECK(zero_copy_read_buffer == zero_copy_data);
+
+    server_side_socket.set_option(socket_base::zero_copy(false));
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
@@ -745,6 +843,16 @@ struct move_accept_ioc_handler
 private:
   move_accept_ioc_handler(const move_accept_handler&) {}
 };
+
+struct move_accept_batch_handler
+{
+  move_accept_batch_handler() {}
+  void operator()(const asio::error_code&,
+      std::vector<asio::ip::tcp::socket>) {}
+  move_accept_batch_handler(move_accept_batch_handler&&) {}
+private:
+  move_accept_batch_handler(const move_accept_batch_handler&) {}
+};
 #endif // defined(ASIO_HAS_MOVE)
 
 void test()
@@ -935,6 +1043,9 @@ void test()
     acceptor1.async_accept(ioc, peer_endpoint, move_accept_handler());
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_handler());
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_ioc_handler());
+    acceptor1.async_accept_batch(16, move_accept_batch_handler());
+    int i6 = acceptor1.async_accept_batch(16, lazy);
+    (void)i6;
 #endif // defined(ASIO_HAS_MOVE)
   }
   catch (std::exception&)
@@ -963,6 +1074,39 @@ void handle_connect(const asio::error_code& err)
   ASIO_CHECK(!err);
 }
 
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+// Determine whether the net.ipv4.tcp_fastopen sysctl enables both the client
+// and the server sides of TCP Fast Open.
+bool fast_open_enabled()
+{
+  int value = 0;
+  if (std::FILE* f = std::fopen("/proc/sys/net/ipv4/tcp_fastopen", "r"))
+  {
+    if (std::fscanf(f, "%d", &value) != 1)
+      value = 0;
+    std::fclose(f);
+  }
+  return (value & 0x3) == 0x3;
+}
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
+#if defined(ASIO_HAS_MOVE)
+struct accept_batch_handler
+{
+  asio::error_code* ec;
+  std::vector<asio::ip::tcp::socket>* peers;
+  bool* called;
+
+  void operator()(const asio::error_code& e,
+      std::vector<asio::ip::tcp::socket> s)
+  {
+    *ec = e;
+    *peers = std::move(s);
+    *called = true;
+  }
+};
+#endif // defined(ASIO_HAS_MOVE)
+
 void test()
 {
   using namespace asio;
@@ -1019,6 +1163,170 @@ void test()
   server_side_remote_endpoint = server_side_socket.remote_endpoint();
   ASIO_CHECK(server_side_remote_endpoint.port()
       == client_endpoint.port());
+
+#if defined(ASIO_HAS_MOVE)
+  // Batch accept. The waiting connections are delivered together, up to the
+  // requested maximum.
+
+  client_side_socket.close();
+  server_side_socket.close();
+
+  std::vector<ip::tcp::socket> clients;
+  for (int i = 0; i < 5; ++i)
+  {
+    clients.push_back(ip::tcp::socket(ioc));
+    clients.back().connect(server_endpoint);
+  }
+
+  asio::error_code batch_ec;
+  std::vector<ip::tcp::socket> peers;
+  bool batch_completed = false;
+  accept_batch_handler batch_handler = { &batch_ec, &peers, &batch_completed };
+  acceptor.async_accept_batch(3, batch_handler);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(batch_completed);
+  ASIO_CHECK(!batch_ec);
+  ASIO_CHECK(peers.size() == 3);
+
+  std::vector<ip::tcp::socket> all_peers;
+  for (std::size_t i = 0; i < peers.size(); ++i)
+    all_peers.push_back(std::move(peers[i]));
+
+  batch_completed = false;
+  acceptor.async_accept_batch(16, batch_handler);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(batch_completed);
+  ASIO_CHECK(!batch_ec);
+  ASIO_CHECK(peers.size() == 2);
+
+  for (std::size_t i = 0; i < peers.size(); ++i)
+    all_peers.push_back(std::move(peers[i]));
+
+  // Each client is connected to one of the accepted sockets.
+  for (std::size_t i = 0; i < clients.size(); ++i)
+  {
+    ASIO_CHECK(all_peers[i].is_open());
+    ASIO_CHECK(all_peers[i].remote_endpoint()
+        == clients[i].local_endpoint());
+#if defined(ASIO_HAS_ACCEPT4) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    ASIO_CHECK(all_peers[i].native_non_blocking());
+#endif // defined(ASIO_HAS_ACCEPT4) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+    static const char data[] = "data";
+    char read_buffer[sizeof(data)];
+    bool write_completed = false;
+    bool read_completed = false;
+    asio::async_write(all_peers[i], asio::buffer(data),
+        std::bind(handle_transfer, std::placeholders::_1,
+          std::placeholders::_2, sizeof(data), &write_completed));
+    asio::async_read(clients[i], asio::buffer(read_buffer),
+        std::bind(handle_transfer, std::placeholders::_1,
+          std::placeholders::_2, sizeof(data), &read_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(write_completed);
+    ASIO_CHECK(read_completed);
+  }
+
+  // A batch of zero connections completes immediately.
+  batch_completed = false;
+  acceptor.async_accept_batch(0, batch_handler);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(batch_completed);
+  ASIO_CHECK(!batch_ec);
+  ASIO_CHECK(peers.empty());
+
+  // A cancelled batch accept delivers no sockets.
+  batch_completed = false;
+  acceptor.async_accept_batch(16, batch_handler);
+
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(!batch_completed);
+  acceptor.cancel();
+  ioc.run();
+  ASIO_CHECK(batch_completed);
+  ASIO_CHECK(batch_ec == asio::error::operation_aborted);
+  ASIO_CHECK(peers.empty());
+#endif // defined(ASIO_HAS_MOVE)
+
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+  // TCP Fast Open. The first connection obtains a cookie. Later connections
+  // complete the connect immediately, and send the data with the SYN if the
+  // server side is enabled in the net.ipv4.tcp_fastopen sysctl.
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  ip::tcp::acceptor fast_open_acceptor(ioc);
+  fast_open_acceptor.open(ip::tcp::v4());
+  fast_open_acceptor.set_option(ip::tcp::fast_open(5));
+  fast_open_acceptor.bind(ip::tcp::endpoint(ip::tcp::v4(), 0));
+  fast_open_acceptor.listen();
+  server_endpoint = fast_open_acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  static const char request[] = "request";
+  for (int i = 0; i < 3; ++i)
+  {
+    client_side_socket.close();
+    server_side_socket.close();
+
+    client_side_socket.open(ip::tcp::v4());
+    client_side_socket.set_option(ip::tcp::fast_open_connect(true));
+    client_side_socket.async_connect(server_endpoint, &handle_connect);
+
+    ioc.restart();
+    ioc.run();
+
+    fast_open_acceptor.async_accept(server_side_socket, &handle_accept);
+
+    bool write_completed = false;
+    asio::async_write(client_side_socket, asio::buffer(request),
+        bindns::bind(handle_transfer, _1, _2,
+          sizeof(request), &write_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(write_completed);
+
+    char read_buffer[sizeof(request)];
+    bool read_completed = false;
+    asio::async_read(server_side_socket, asio::buffer(read_buffer),
+        bindns::bind(handle_transfer, _1, _2,
+          sizeof(request), &read_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(read_completed);
+    ASIO_CHECK(std::memcmp(read_buffer, request, sizeof(request)) == 0);
+
+#if defined(TCPI_OPT_SYN_DATA)
+    // Once the client has a cookie, the server acknowledges the data that was
+    // sent with the SYN.
+    if (i > 0 && fast_open_enabled())
+    {
+      tcp_info info = tcp_info();
+      socklen_t info_len = sizeof(info);
+      ASIO_CHECK(::getsockopt(client_side_socket.native_handle(),
+            IPPROTO_TCP, TCP_INFO, &info, &info_len) == 0);
+      ASIO_CHECK((info.tcpi_options & TCPI_OPT_SYN_DATA) != 0);
+    }
+#endif // defined(TCPI_OPT_SYN_DATA)
+  }
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
 }
 
 } // namespace ip_tcp_acceptor_runtime
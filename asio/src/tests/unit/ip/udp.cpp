@@ -32,6 +32,18 @@
 
 //------------------------------------------------------------------------------
 
+// Completion handler used by the runtime tests to record the number of slots
+// or bytes transferred by a successful operation.
+
+void handle_count(std::size_t* count_out,
+    const asio::error_code& err, std::size_t count)
+{
+  ASIO_CHECK(!err);
+  *count_out = count;
+}
+
+//------------------------------------------------------------------------------
+
 // ip_udp_socket_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -440,6 +452,59 @@ void test()
     int i29 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i29;
+
+    ip::udp::socket::send_slot send_slots[2] = {
+      ip::udp::socket::send_slot(buffer(const_char_buffer), endpoint),
+      ip::udp::socket::send_slot(buffer(const_char_buffer), endpoint) };
+    ip::udp::socket::receive_slot receive_slots[2] = {
+      ip::udp::socket::receive_slot(buffer(mutable_char_buffer)),
+      ip::udp::socket::receive_slot(buffer(mutable_char_buffer)) };
+
+    socket1.async_send_batch(send_slots, 2, send_handler());
+    socket1.async_send_batch(send_slots, 2, in_flags, send_handler());
+    int i30 = socket1.async_send_batch(send_slots, 2, lazy);
+    (void)i30;
+    int i31 = socket1.async_send_batch(send_slots, 2, in_flags, lazy);
+    (void)i31;
+
+    socket1.async_receive_batch(receive_slots, 2, receive_handler());
+    socket1.async_receive_batch(receive_slots, 2, in_flags,
+        receive_handler());
+    int i32 = socket1.async_receive_batch(receive_slots, 2, lazy);
+    (void)i32;
+    int i33 = socket1.async_receive_batch(receive_slots, 2, in_flags, lazy);
+    (void)i33;
+
+    size_t segment_size = 0;
+    socket1.receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size);
+    socket1.receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags);
+    socket1.receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, ec);
+
+    socket1.async_receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, receive_handler());
+    socket1.async_receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, receive_handler());
+    int i34 = socket1.async_receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, lazy);
+    (void)i34;
+    int i35 = socket1.async_receive_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, lazy);
+    (void)i35;
+
+#if defined(ASIO_HAS_UDP_GSO)
+    ip::udp::segment_size segment_size_option(1200);
+    socket1.set_option(segment_size_option);
+    socket1.get_option(segment_size_option, ec);
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+#if defined(ASIO_HAS_UDP_GRO)
+    ip::udp::generic_receive_offload generic_receive_offload_option(true);
+    socket1.set_option(generic_receive_offload_option);
+    socket1.get_option(generic_receive_offload_option, ec);
+#endif // defined(ASIO_HAS_UDP_GRO)
   }
   catch (std::exception&)
   {
@@ -517,6 +582,177 @@ void test()
   ASIO_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
 }
 
+void test_batch()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+  ip::udp::endpoint target_endpoint = s1.local_endpoint();
+  target_endpoint.address(ip::address_v4::loopback());
+
+  ip::udp::socket s2(ioc);
+  s2.open(ip::udp::v4());
+  s2.bind(ip::udp::endpoint(ip::udp::v4(), 0));
+
+  const size_t batch_size = 8;
+  char send_msgs[batch_size][16];
+  char recv_msgs[batch_size][32];
+  ip::udp::socket::send_slot send_slots[batch_size];
+  ip::udp::socket::receive_slot recv_slots[batch_size];
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    memset(send_msgs[i], static_cast<char>('a' + i), sizeof(send_msgs[i]));
+    memset(recv_msgs[i], 0, sizeof(recv_msgs[i]));
+    send_slots[i] = ip::udp::socket::send_slot(
+        buffer(send_msgs[i], i + 1), target_endpoint);
+    recv_slots[i].buffer(buffer(recv_msgs[i]));
+  }
+
+  // Send the batch, continuing after any partial send.
+  size_t sent = 0;
+  while (sent < batch_size)
+  {
+    size_t n = 0;
+    s2.async_send_batch(send_slots + sent, batch_size - sent,
+        bindns::bind(handle_count, &n, _1, _2));
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(n > 0);
+    if (n == 0)
+      break;
+    sent += n;
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+    ASIO_CHECK(send_slots[i].size() == i + 1);
+
+  // Receive the datagrams, which may arrive over more than one operation.
+  size_t received = 0;
+  while (received < batch_size)
+  {
+    size_t n = 0;
+    s1.async_receive_batch(recv_slots + received, batch_size - received,
+        bindns::bind(handle_count, &n, _1, _2));
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(n > 0);
+    if (n == 0)
+      break;
+    received += n;
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    ASIO_CHECK(recv_slots[i].size() == i + 1);
+    ASIO_CHECK(memcmp(recv_msgs[i], send_msgs[i], i + 1) == 0);
+    ASIO_CHECK(recv_slots[i].endpoint().port() == s2.local_endpoint().port());
+  }
+
+  // An empty batch completes immediately.
+  size_t n = 1;
+  s1.async_receive_batch(recv_slots, 0,
+      bindns::bind(handle_count, &n, _1, _2));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(n == 0);
+}
+
+void test_coalesced()
+{
+#if !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+  ip::udp::endpoint target_endpoint = s1.local_endpoint();
+  target_endpoint.address(ip::address_v4::loopback());
+
+  ip::udp::socket s2(ioc);
+  s2.open(ip::udp::v4());
+  s2.bind(ip::udp::endpoint(ip::udp::v4(), 0));
+
+  const size_t segment = 100;
+  const size_t segments = 4;
+  char send_msg[segment * segments];
+  char recv_msg[segment * segments];
+  for (size_t i = 0; i < sizeof(send_msg); ++i)
+    send_msg[i] = static_cast<char>('a' + i % 26);
+  memset(recv_msg, 0, sizeof(recv_msg));
+
+  // Use segmentation offload where the platform supports it. Otherwise, send
+  // the segments as separate datagrams.
+  bool offload = false;
+#if defined(ASIO_HAS_UDP_GSO) && defined(ASIO_HAS_UDP_GRO)
+  asio::error_code ec;
+  s1.set_option(ip::udp::generic_receive_offload(true), ec);
+  if (!ec)
+    s2.set_option(ip::udp::segment_size(static_cast<int>(segment)), ec);
+  offload = !ec;
+#endif // defined(ASIO_HAS_UDP_GSO) && defined(ASIO_HAS_UDP_GRO)
+
+  if (offload)
+    s2.send_to(buffer(send_msg), target_endpoint);
+  else
+    for (size_t i = 0; i < segments; ++i)
+      s2.send_to(buffer(send_msg + i * segment, segment), target_endpoint);
+
+  // Receive the segments, which may or may not have been coalesced.
+  ip::udp::endpoint sender_endpoint;
+  size_t received = 0;
+  while (received < sizeof(recv_msg))
+  {
+    size_t segment_size = 0;
+    size_t n = 0;
+    s1.async_receive_coalesced(
+        buffer(recv_msg + received, sizeof(recv_msg) - received),
+        sender_endpoint, segment_size,
+        bindns::bind(handle_count, &n, _1, _2));
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(n > 0);
+    if (n == 0)
+      break;
+    ASIO_CHECK(segment_size == segment);
+    ASIO_CHECK(n % segment == 0);
+    received += n;
+  }
+
+  ASIO_CHECK(memcmp(recv_msg, send_msg, sizeof(send_msg)) == 0);
+  ASIO_CHECK(sender_endpoint.port() == s2.local_endpoint().port());
+
+  // A datagram shorter than the segment size is not segmented.
+  s2.send_to(buffer(send_msg, 10), target_endpoint);
+  size_t segment_size = 0;
+  size_t n = s1.receive_coalesced(buffer(recv_msg),
+      sender_endpoint, segment_size);
+  ASIO_CHECK(n == 10);
+  ASIO_CHECK(segment_size == 10);
+#endif // !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+}
+
 } // namespace ip_udp_socket_runtime
 
 //------------------------------------------------------------------------------
@@ -669,5 +905,7 @@ ASIO_TEST_SUITE
   "ip/udp",
   ASIO_COMPILE_TEST_CASE(ip_udp_socket_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_batch)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_coalesced)
   ASIO_COMPILE_TEST_CASE(ip_udp_resolver_compile::test)
 )
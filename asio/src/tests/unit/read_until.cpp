@@ -20,6 +20,7 @@
 #include "archetypes/async_result.hpp"
 #include "asio/io_context.hpp"
 #include "asio/post.hpp"
+#include "asio/segmented_buffer.hpp"
 #include "asio/streambuf.hpp"
 #include "unit_test.hpp"
 
@@ -485,6 +486,74 @@ namespace asio {
   };
 } // namespace asio
 
+void test_segmented_buffer_read_until_char()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::error_code ec;
+
+  // Small blocks split the data into many buffers, and short reads leave the
+  // delimiter at varying offsets within them.
+  for (std::size_t i = 1; i <= 8; ++i)
+  {
+    asio::segmented_buffer b((std::numeric_limits<std::size_t>::max)(), 3);
+    s.reset(read_data, sizeof(read_data));
+    s.next_read_length(i);
+    std::size_t length = asio::read_until(s,
+        asio::dynamic_buffer(b), 'Z', ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(length == 26);
+  }
+
+  asio::segmented_buffer b(25, 3);
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(7);
+  std::size_t length = asio::read_until(s, asio::dynamic_buffer(b), 'Z', ec);
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(length == 0);
+}
+
+void test_segmented_buffer_read_until_string()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::error_code ec;
+
+  // The delimiter spans several buffers, and short reads end the data part
+  // way through a match.
+  for (std::size_t i = 1; i <= 8; ++i)
+  {
+    asio::segmented_buffer b((std::numeric_limits<std::size_t>::max)(), 3);
+    s.reset(read_data, sizeof(read_data));
+    s.next_read_length(i);
+    std::size_t length = asio::read_until(s,
+        asio::dynamic_buffer(b), "XYZabc", ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(length == 29);
+  }
+
+  // A partial match followed by a mismatch must not hide a later match.
+  static const char overlap_data[] = "abababcab";
+  for (std::size_t i = 1; i <= 8; ++i)
+  {
+    asio::segmented_buffer b((std::numeric_limits<std::size_t>::max)(), 2);
+    s.reset(overlap_data, sizeof(overlap_data));
+    s.next_read_length(i);
+    std::size_t length = asio::read_until(s,
+        asio::dynamic_buffer(b), "ababc", ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(length == 7);
+  }
+
+  asio::segmented_buffer b(25, 3);
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(7);
+  std::size_t length = asio::read_until(s,
+      asio::dynamic_buffer(b), "XYZ", ec);
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(length == 0);
+}
+
 void test_dynamic_string_read_until_match_condition()
 {
   asio::io_context ioc;
@@ -1317,6 +1386,55 @@ void test_streambuf_async_read_until_string()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+void test_segmented_buffer_async_read_until()
+{
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::error_code ec;
+  std::size_t length;
+  bool called;
+
+  for (std::size_t i = 1; i <= 8; ++i)
+  {
+    asio::segmented_buffer b((std::numeric_limits<std::size_t>::max)(), 3);
+    s.reset(read_data, sizeof(read_data));
+    s.next_read_length(i);
+    ec = asio::error_code();
+    length = 0;
+    called = false;
+    asio::async_read_until(s, asio::dynamic_buffer(b), "XYZabc",
+        bindns::bind(async_read_handler, _1, &ec,
+          _2, &length, &called));
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(length == 29);
+
+    s.reset(read_data, sizeof(read_data));
+    s.next_read_length(i);
+    ec = asio::error_code();
+    length = 0;
+    called = false;
+    asio::async_read_until(s, asio::dynamic_buffer(b), 'Z',
+        bindns::bind(async_read_handler, _1, &ec,
+          _2, &length, &called));
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(length == 26);
+  }
+}
+
 void test_dynamic_string_async_read_until_match_condition()
 {
 #if defined(ASIO_HAS_BOOST_BIND)
@@ -1647,12 +1765,15 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_streambuf_read_until_char)
   ASIO_TEST_CASE(test_dynamic_string_read_until_string)
   ASIO_TEST_CASE(test_streambuf_read_until_string)
+  ASIO_TEST_CASE(test_segmented_buffer_read_until_char)
+  ASIO_TEST_CASE(test_segmented_buffer_read_until_string)
   ASIO_TEST_CASE(test_dynamic_string_read_until_match_condition)
   ASIO_TEST_CASE(test_streambuf_read_until_match_condition)
   ASIO_TEST_CASE(test_dynamic_string_async_read_until_char)
   ASIO_TEST_CASE(test_streambuf_async_read_until_char)
   ASIO_TEST_CASE(test_dynamic_string_async_read_until_string)
   ASIO_TEST_CASE(test_streambuf_async_read_until_string)
+  ASIO_TEST_CASE(test_segmented_buffer_async_read_until)
   ASIO_TEST_CASE(test_dynamic_string_async_read_until_match_condition)
   ASIO_TEST_CASE(test_streambuf_async_read_until_match_condition)
 )
@@ -0,0 +1,228 @@
+//
+// ring_buffer.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ring_buffer.hpp"
+
+#include <cstring>
+#include <string>
+#include "asio/error.hpp"
+#include "asio/read_until.hpp"
+#include "asio/system_error.hpp"
+#include "unit_test.hpp"
+
+class test_stream
+{
+public:
+  explicit test_stream(const std::string& data)
+    : data_(data),
+      position_(0)
+  {
+  }
+
+  template <typename Mutable_Buffers>
+  size_t read_some(const Mutable_Buffers& buffers,
+      asio::error_code& ec)
+  {
+    // Deliver the data a few bytes at a time, to exercise partial reads.
+    size_t n = asio::buffer_copy(buffers,
+        asio::buffer(data_) + position_, 7);
+    position_ += n;
+    ec = n == 0 ? asio::error::eof : asio::error_code();
+    return n;
+  }
+
+private:
+  std::string data_;
+  size_t position_;
+};
+
+// Write a string at the end of a ring buffer.
+static void append(asio::ring_buffer& b, const std::string& s)
+{
+  std::size_t pos = b.size();
+  b.grow(s.size());
+  asio::buffer_copy(b.data(pos, s.size()), asio::buffer(s));
+}
+
+// Read a string from the beginning of a ring buffer.
+static std::string front(const asio::ring_buffer& b, std::size_t n)
+{
+  std::string s(n, '\0');
+  s.resize(asio::buffer_copy(asio::buffer(&s[0], n), b.data(0, n)));
+  return s;
+}
+
+void ring_buffer_wrap_test()
+{
+  asio::ring_buffer b;
+  ASIO_CHECK(b.size() == 0);
+  ASIO_CHECK(b.capacity() == 0);
+  ASIO_CHECK(b.mapping() == asio::ring_buffer::single_mapped);
+
+  b.reserve(10);
+  std::size_t capacity = b.capacity();
+  ASIO_CHECK(capacity >= 10);
+
+  // Fill most of the buffer and consume from the front, so that the next
+  // append wraps around the end of the memory.
+  append(b, std::string(capacity - 4, 'a'));
+  b.consume(capacity - 8);
+  ASIO_CHECK(b.size() == 4);
+
+  append(b, "0123456789");
+  ASIO_CHECK(b.size() == 14);
+  ASIO_CHECK(b.capacity() == capacity);
+  ASIO_CHECK(front(b, 14) == "aaaa0123456789");
+
+  asio::ring_buffer::const_buffers_type bufs =
+    static_cast<const asio::ring_buffer&>(b).data(0, 14);
+  ASIO_CHECK(bufs[0].size() == 8);
+  ASIO_CHECK(bufs[1].size() == 6);
+  ASIO_CHECK(asio::buffer_size(bufs) == 14);
+
+  // Data is clamped to the size of the buffer.
+  ASIO_CHECK(asio::buffer_size(b.data(10, 100)) == 4);
+  ASIO_CHECK(asio::buffer_size(b.data(100, 100)) == 0);
+
+  // Growing beyond the capacity preserves wrapped data.
+  append(b, std::string(capacity, 'b'));
+  ASIO_CHECK(b.capacity() > capacity);
+  ASIO_CHECK(front(b, 14) == "aaaa0123456789");
+  ASIO_CHECK(b.data(0, b.size())[1].size() == 0);
+
+  b.shrink(capacity);
+  ASIO_CHECK(b.size() == 14);
+  b.consume(4);
+  ASIO_CHECK(front(b, 10) == "0123456789");
+  b.consume(100);
+  ASIO_CHECK(b.size() == 0);
+}
+
+void ring_buffer_max_size_test()
+{
+  asio::ring_buffer b(16);
+  b.grow(16);
+  ASIO_CHECK(b.size() == 16);
+
+  bool threw = false;
+  try
+  {
+    b.grow(1);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+  ASIO_CHECK(b.size() == 16);
+
+  asio::dynamic_ring_buffer db = asio::dynamic_buffer(b, 8);
+  ASIO_CHECK(db.max_size() == 8);
+  ASIO_CHECK(db.size() == 8);
+  ASIO_CHECK(asio::buffer_size(db.data(4, 100)) == 4);
+}
+
+void ring_buffer_dynamic_buffer_test()
+{
+  asio::ring_buffer b;
+
+  // Each message is consumed before the next is read, so that later messages
+  // wrap around the end of the ring buffer's memory rather than causing it to
+  // grow.
+  std::string data;
+  for (int i = 0; i < 100; ++i)
+    data += "message " + std::string(i % 10, '.') + "\n";
+  test_stream s(data);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    std::size_t n = asio::read_until(s, asio::dynamic_buffer(b), '\n');
+    ASIO_CHECK(front(b, n) == "message " + std::string(i % 10, '.') + "\n");
+    b.consume(n);
+  }
+
+  ASIO_CHECK(b.size() == 0);
+  ASIO_CHECK(b.capacity() <= 1024);
+}
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+void ring_buffer_dynamic_buffer_v1_test()
+{
+  asio::ring_buffer b;
+  asio::dynamic_ring_buffer db(b);
+
+  std::string s("0123456789");
+  std::size_t n = asio::buffer_copy(db.prepare(20), asio::buffer(s));
+  db.commit(n);
+  ASIO_CHECK(db.size() == 10);
+  ASIO_CHECK(b.size() == 10);
+  ASIO_CHECK(asio::buffer_size(db.data()) == 10);
+
+  db.consume(4);
+  ASIO_CHECK(db.size() == 6);
+  ASIO_CHECK(front(b, 6) == "456789");
+
+  db.prepare(5);
+  db.commit(100);
+  ASIO_CHECK(db.size() == 11);
+  ASIO_CHECK(b.size() == 11);
+}
+
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+void ring_buffer_double_mapped_test()
+{
+  try
+  {
+    asio::ring_buffer b((std::numeric_limits<std::size_t>::max)(),
+        asio::ring_buffer::double_mapped);
+    ASIO_CHECK(b.mapping() == asio::ring_buffer::double_mapped);
+    std::size_t capacity = b.capacity();
+    ASIO_CHECK(capacity > 0);
+
+    append(b, std::string(capacity - 4, 'a'));
+    b.consume(capacity - 8);
+    append(b, "0123456789");
+
+    // Wrapped data is represented as a single contiguous buffer.
+    asio::ring_buffer::mutable_buffers_type bufs = b.data(0, b.size());
+    ASIO_CHECK(bufs[0].size() == 14);
+    ASIO_CHECK(bufs[1].size() == 0);
+    ASIO_CHECK(std::memcmp(bufs[0].data(), "aaaa0123456789", 14) == 0);
+
+    // Growing beyond the capacity preserves wrapped data.
+    append(b, std::string(capacity, 'b'));
+    ASIO_CHECK(b.capacity() > capacity);
+    ASIO_CHECK(front(b, 14) == "aaaa0123456789");
+  }
+  catch (asio::system_error& e)
+  {
+    ASIO_CHECK(e.code() == asio::error::operation_not_supported);
+  }
+}
+
+ASIO_TEST_SUITE
+(
+  "ring_buffer",
+  ASIO_TEST_CASE(ring_buffer_wrap_test)
+  ASIO_TEST_CASE(ring_buffer_max_size_test)
+  ASIO_TEST_CASE(ring_buffer_dynamic_buffer_test)
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  ASIO_TEST_CASE(ring_buffer_dynamic_buffer_v1_test)
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  ASIO_TEST_CASE(ring_buffer_double_mapped_test)
+)
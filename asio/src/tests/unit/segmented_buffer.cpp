@@ -0,0 +1,256 @@
+//
+// segmented_buffer.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/segmented_buffer.hpp"
+
+#include <string>
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/error.hpp"
+#include "asio/read.hpp"
+#include "asio/read_until.hpp"
+#include "unit_test.hpp"
+
+class test_stream
+{
+public:
+  explicit test_stream(const std::string& data)
+    : data_(data),
+      position_(0)
+  {
+  }
+
+  template <typename Mutable_Buffers>
+  size_t read_some(const Mutable_Buffers& buffers,
+      asio::error_code& ec)
+  {
+    size_t n = asio::buffer_copy(buffers,
+        asio::buffer(data_) + position_, 1000);
+    position_ += n;
+    ec = n == 0 ? asio::error::eof : asio::error_code();
+    return n;
+  }
+
+private:
+  std::string data_;
+  size_t position_;
+};
+
+// Write a string at the end of a segmented buffer.
+static void append(asio::segmented_buffer& b, const std::string& s)
+{
+  std::size_t pos = b.size();
+  b.grow(s.size());
+  asio::buffer_copy(b.data(pos, s.size()), asio::buffer(s));
+}
+
+// Read a string from a segmented buffer.
+static std::string range(const asio::segmented_buffer& b,
+    std::size_t pos, std::size_t n)
+{
+  std::string s(n, '\0');
+  s.resize(asio::buffer_copy(asio::buffer(&s[0], n), b.data(pos, n)));
+  return s;
+}
+
+template <typename Buffers>
+static std::size_t buffer_count(const Buffers& buffers)
+{
+  std::size_t count = 0;
+  typename Buffers::const_iterator iter = buffers.begin();
+  for (; iter != buffers.end(); ++iter)
+    ++count;
+  return count;
+}
+
+void segmented_buffer_blocks_test()
+{
+  asio::segmented_buffer b((std::numeric_limits<std::size_t>::max)(), 8);
+  ASIO_CHECK(b.size() == 0);
+  ASIO_CHECK(b.capacity() == 0);
+  ASIO_CHECK(b.block_size() == 8);
+  ASIO_CHECK(buffer_count(b.data(0, 0)) == 0);
+
+  append(b, "0123456789abcdefghij");
+  ASIO_CHECK(b.size() == 20);
+  ASIO_CHECK(b.capacity() == 24);
+  ASIO_CHECK(range(b, 0, 20) == "0123456789abcdefghij");
+
+  // One buffer per block touched by the range.
+  asio::segmented_buffer::const_buffers_type bufs =
+    static_cast<const asio::segmented_buffer&>(b).data(0, 20);
+  ASIO_CHECK(buffer_count(bufs) == 3);
+  ASIO_CHECK(asio::buffer_size(bufs) == 20);
+  ASIO_CHECK(buffer_count(b.data(6, 4)) == 2);
+  ASIO_CHECK(range(b, 6, 4) == "6789");
+  ASIO_CHECK(buffer_count(b.data(8, 8)) == 1);
+
+  // The iterators are bidirectional.
+  asio::segmented_buffer::const_buffers_type::const_iterator iter = bufs.end();
+  --iter;
+  ASIO_CHECK((*iter).size() == 4);
+  --iter;
+  --iter;
+  ASIO_CHECK(iter == bufs.begin());
+  ASIO_CHECK((*iter).size() == 8);
+
+  // Data is clamped to the size of the buffer.
+  ASIO_CHECK(asio::buffer_size(b.data(15, 100)) == 5);
+  ASIO_CHECK(asio::buffer_size(b.data(100, 100)) == 0);
+
+  // Consuming releases whole blocks without moving the remaining bytes.
+  const void* p = (*b.data(10, 1).begin()).data();
+  b.consume(10);
+  ASIO_CHECK(b.size() == 10);
+  ASIO_CHECK(b.capacity() == 14);
+  ASIO_CHECK((*b.data(0, 1).begin()).data() == p);
+  ASIO_CHECK(range(b, 0, 10) == "abcdefghij");
+
+  b.shrink(4);
+  ASIO_CHECK(range(b, 0, 10) == "abcdef");
+  b.consume(100);
+  ASIO_CHECK(b.size() == 0);
+}
+
+void segmented_buffer_max_size_test()
+{
+  asio::segmented_buffer b(16, 8);
+  b.grow(16);
+  ASIO_CHECK(b.size() == 16);
+
+  bool threw = false;
+  try
+  {
+    b.grow(1);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+  ASIO_CHECK(b.size() == 16);
+
+  asio::dynamic_segmented_buffer db = asio::dynamic_buffer(b, 8);
+  ASIO_CHECK(db.max_size() == 8);
+  ASIO_CHECK(db.size() == 8);
+  ASIO_CHECK(asio::buffer_size(db.data(4, 100)) == 4);
+}
+
+void segmented_buffer_pool_test()
+{
+  asio::segmented_buffer_pool pool(8, 3);
+  ASIO_CHECK(pool.block_size() == 8);
+  ASIO_CHECK(pool.unused_blocks() == 0);
+
+  {
+    asio::segmented_buffer b1(pool);
+    ASIO_CHECK(b1.block_size() == 8);
+    append(b1, "0123456789abcdefghij");
+    ASIO_CHECK(b1.capacity() == 24);
+
+    // Consumed blocks are returned to the pool.
+    b1.consume(16);
+    ASIO_CHECK(range(b1, 0, 4) == "ghij");
+    ASIO_CHECK(pool.unused_blocks() == 2);
+
+    // Another buffer reuses the blocks released by the first.
+    asio::segmented_buffer b2(pool, 100);
+    append(b2, "0123456789");
+    ASIO_CHECK(pool.unused_blocks() == 0);
+    ASIO_CHECK(range(b2, 0, 10) == "0123456789");
+  }
+
+  // The pool keeps at most its maximum number of unused blocks.
+  ASIO_CHECK(pool.unused_blocks() == 3);
+
+  asio::segmented_buffer b3(pool);
+  append(b3, std::string(40, 'x'));
+  ASIO_CHECK(pool.unused_blocks() == 0);
+  b3.consume(40);
+  ASIO_CHECK(pool.unused_blocks() == 3);
+}
+
+void segmented_buffer_dynamic_buffer_test()
+{
+  std::string data;
+  for (int i = 0; i < 1000; ++i)
+    data += "line " + std::string(i % 100, '.') + "\n";
+
+  // A large read fills a chain of blocks, and its buffers are passed to the
+  // operating system as a single scatter-gather sequence.
+  asio::segmented_buffer b1;
+  test_stream s1(data);
+  std::size_t n = asio::read(s1, asio::dynamic_buffer(b1),
+      asio::transfer_exactly(data.size()));
+  ASIO_CHECK(n == data.size());
+  ASIO_CHECK(range(b1, 0, n) == data);
+
+  asio::segmented_buffer::mutable_buffers_type bufs = b1.data(0, n);
+  asio::detail::buffer_sequence_adapter<asio::mutable_buffer,
+    asio::segmented_buffer::mutable_buffers_type> adapter(bufs);
+  ASIO_CHECK(adapter.count() == (std::min<std::size_t>)(
+        (n + b1.block_size() - 1) / b1.block_size(),
+        asio::detail::buffer_sequence_adapter_base::max_buffers));
+
+  // Reading and consuming one line at a time keeps the chain short.
+  asio::segmented_buffer b2((std::numeric_limits<std::size_t>::max)(), 64);
+  test_stream s2(data);
+  for (int i = 0; i < 1000; ++i)
+  {
+    n = asio::read_until(s2, asio::dynamic_buffer(b2), '\n');
+    ASIO_CHECK(range(b2, 0, n) == "line " + std::string(i % 100, '.') + "\n");
+    b2.consume(n);
+    ASIO_CHECK(b2.capacity() <= 2048);
+  }
+}
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+void segmented_buffer_dynamic_buffer_v1_test()
+{
+  asio::segmented_buffer b((std::numeric_limits<std::size_t>::max)(), 8);
+  asio::dynamic_segmented_buffer db(b);
+
+  std::string s("0123456789");
+  std::size_t n = asio::buffer_copy(db.prepare(20), asio::buffer(s));
+  db.commit(n);
+  ASIO_CHECK(db.size() == 10);
+  ASIO_CHECK(b.size() == 10);
+  ASIO_CHECK(asio::buffer_size(db.data()) == 10);
+  ASIO_CHECK(buffer_count(db.data()) == 2);
+
+  db.consume(4);
+  ASIO_CHECK(db.size() == 6);
+  ASIO_CHECK(range(b, 0, 6) == "456789");
+
+  db.prepare(5);
+  db.commit(100);
+  ASIO_CHECK(db.size() == 11);
+  ASIO_CHECK(b.size() == 11);
+}
+
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+ASIO_TEST_SUITE
+(
+  "segmented_buffer",
+  ASIO_TEST_CASE(segmented_buffer_blocks_test)
+  ASIO_TEST_CASE(segmented_buffer_max_size_test)
+  ASIO_TEST_CASE(segmented_buffer_pool_test)
+  ASIO_TEST_CASE(segmented_buffer_dynamic_buffer_test)
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  ASIO_TEST_CASE(segmented_buffer_dynamic_buffer_v1_test)
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+)
@@ -0,0 +1,386 @@
+//
+// sendfile.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/sendfile.hpp"
+
+#include "archetypes/async_result.hpp"
+#include "asio/io_context.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SENDFILE)
+# include <cstdio>
+# include <cstring>
+# include <vector>
+# include <unistd.h>
+# include "asio/local/connect_pair.hpp"
+# include "asio/local/stream_protocol.hpp"
+# include "asio/posix/stream_descriptor.hpp"
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_FILE)
+# include "asio/random_access_file.hpp"
+# include "asio/stream_file.hpp"
+#endif // defined(ASIO_HAS_FILE)
+
+//------------------------------------------------------------------------------
+
+// sendfile_compile test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all async_sendfile overloads compile and
+// link correctly. Runtime failures are ignored.
+
+namespace sendfile_compile {
+
+#if defined(ASIO_HAS_SENDFILE)
+
+void sendfile_handler(const asio::error_code&, std::size_t)
+{
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+void test()
+{
+#if defined(ASIO_HAS_SENDFILE)
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+
+    local::stream_protocol::socket socket1(ioc);
+    posix::stream_descriptor descriptor1(ioc);
+
+    async_sendfile(socket1, descriptor1, 1024, &sendfile_handler);
+    int i1 = async_sendfile(socket1, descriptor1, 1024, lazy);
+    (void)i1;
+
+#if defined(ASIO_HAS_FILE)
+    random_access_file file1(ioc);
+    stream_file file2(ioc);
+
+    async_sendfile(socket1, file1, 0, 1024, &sendfile_handler);
+    int i2 = async_sendfile(socket1, file1, 0, 1024, lazy);
+    (void)i2;
+
+    async_sendfile(socket1, file2, 1024, &sendfile_handler);
+    int i3 = async_sendfile(socket1, file2, 1024, lazy);
+    (void)i3;
+#endif // defined(ASIO_HAS_FILE)
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_SENDFILE)
+}
+
+} // namespace sendfile_compile
+
+//------------------------------------------------------------------------------
+
+// sendfile_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following tests check the runtime operation of async_sendfile.
+
+namespace sendfile_runtime {
+
+#if defined(ASIO_HAS_SENDFILE)
+
+using asio::local::stream_protocol;
+
+const std::size_t data_size = 1024 * 1024;
+
+std::vector<char> make_data()
+{
+  std::vector<char> data(data_size);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+struct transfer_handler
+{
+  asio::error_code* ec;
+  std::size_t* n;
+
+  void operator()(const asio::error_code& e, std::size_t bytes)
+  {
+    *ec = e;
+    *n = bytes;
+  }
+};
+
+struct send_handler
+{
+  asio::error_code* ec;
+  std::size_t* n;
+  stream_protocol::socket* socket;
+
+  void operator()(const asio::error_code& e, std::size_t bytes)
+  {
+    *ec = e;
+    *n = bytes;
+    asio::error_code ignored_ec;
+    socket->shutdown(asio::socket_base::shutdown_send, ignored_ec);
+  }
+};
+
+// Sends length bytes from the source to a socket, while reading the same
+// number of bytes from the other end of the socket.
+template <typename Source>
+void transfer(asio::io_context& ioc, Source& source, std::size_t length,
+    std::vector<char>& received, asio::error_code& send_ec,
+    std::size_t& send_n)
+{
+  stream_protocol::socket socket1(ioc);
+  stream_protocol::socket socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  received.assign(length, 0);
+  asio::error_code read_ec;
+  std::size_t read_n = 0;
+  transfer_handler read_handler = { &read_ec, &read_n };
+  asio::async_read(socket2, asio::buffer(received), read_handler);
+
+  send_handler handler = { &send_ec, &send_n, &socket1 };
+  asio::async_sendfile(socket1, source, length, handler);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(socket1.native_non_blocking());
+  if (!send_ec)
+  {
+    ASIO_CHECK(!read_ec);
+    ASIO_CHECK(read_n == length);
+  }
+}
+
+// Opens a temporary file containing the data.
+int open_data_file(const std::vector<char>& data)
+{
+  char path[] = "/tmp/asio_sendfile_XXXXXX";
+  int fd = ::mkstemp(path);
+  ::unlink(path);
+  std::size_t written = 0;
+  while (fd != -1 && written < data.size())
+  {
+    ssize_t n = ::write(fd, &data[written], data.size() - written);
+    if (n <= 0)
+      break;
+    written += n;
+  }
+  if (fd != -1)
+    ::lseek(fd, 0, SEEK_SET);
+  return fd;
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+void test_regular_file()
+{
+#if defined(ASIO_HAS_SENDFILE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  int fd = open_data_file(data);
+  ASIO_CHECK(fd != -1);
+  asio::posix::stream_descriptor descriptor(ioc, fd);
+
+  // A regular file is sent using sendfile(), from the file's position.
+  ::lseek(fd, 1000, SEEK_SET);
+  std::vector<char> received;
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer(ioc, descriptor, data_size - 2000, received, ec, n);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == data_size - 2000);
+  ASIO_CHECK(std::memcmp(&received[0], &data[1000], n) == 0);
+  ASIO_CHECK(::lseek(fd, 0, SEEK_CUR) == off_t(data_size - 1000));
+
+  // Asking for more data than remains in the file fails with eof.
+  transfer(ioc, descriptor, 2000, received, ec, n);
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(n == 1000);
+#endif // defined(ASIO_HAS_SENDFILE)
+}
+
+void test_pipe()
+{
+#if defined(ASIO_HAS_SENDFILE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+  asio::posix::stream_descriptor read_end(ioc, fds[0]);
+  asio::posix::stream_descriptor write_end(ioc, fds[1]);
+
+  // A pipe is sent using splice(), while its data is still being written.
+  asio::error_code write_ec;
+  std::size_t write_n = 0;
+  transfer_handler write_handler = { &write_ec, &write_n };
+  asio::async_write(write_end, asio::buffer(data), write_handler);
+
+  std::vector<char> received;
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer(ioc, read_end, data_size, received, ec, n);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_n == data_size);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == data_size);
+  ASIO_CHECK(received == data);
+
+  // Closing the write end ends the data.
+  write_end.close();
+  transfer(ioc, read_end, 1, received, ec, n);
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(n == 0);
+#endif // defined(ASIO_HAS_SENDFILE)
+}
+
+void test_copy()
+{
+#if defined(ASIO_HAS_SENDFILE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  // A socket supports neither sendfile() nor splice(), so its data is copied.
+  stream_protocol::socket source1(ioc);
+  stream_protocol::socket source2(ioc);
+  asio::local::connect_pair(source1, source2);
+  asio::posix::stream_descriptor descriptor(ioc, source2.release());
+
+  asio::error_code write_ec;
+  std::size_t write_n = 0;
+  transfer_handler write_handler = { &write_ec, &write_n };
+  asio::async_write(source1, asio::buffer(data), write_handler);
+
+  std::vector<char> received;
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer(ioc, descriptor, data_size, received, ec, n);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_n == data_size);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == data_size);
+  ASIO_CHECK(received == data);
+#endif // defined(ASIO_HAS_SENDFILE)
+}
+
+void test_random_access_file()
+{
+#if defined(ASIO_HAS_SENDFILE) && defined(ASIO_HAS_FILE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  int fd = open_data_file(data);
+  ASIO_CHECK(fd != -1);
+  asio::random_access_file file(ioc, fd);
+
+  stream_protocol::socket socket1(ioc);
+  stream_protocol::socket socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  std::vector<char> received(1000);
+  asio::error_code read_ec;
+  std::size_t read_n = 0;
+  transfer_handler read_handler = { &read_ec, &read_n };
+  asio::async_read(socket2, asio::buffer(received), read_handler);
+
+  // The offset is used instead of the file's position.
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer_handler send_handler = { &ec, &n };
+  asio::async_sendfile(socket1, file, 5000, 1000, send_handler);
+
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 1000);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(std::memcmp(&received[0], &data[5000], 1000) == 0);
+  ASIO_CHECK(::lseek(fd, 0, SEEK_CUR) == 0);
+#endif // defined(ASIO_HAS_SENDFILE) && defined(ASIO_HAS_FILE)
+}
+
+void test_immediate_completion()
+{
+#if defined(ASIO_HAS_SENDFILE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  int fd = open_data_file(data);
+  ASIO_CHECK(fd != -1);
+  asio::posix::stream_descriptor descriptor(ioc, fd);
+
+  stream_protocol::socket socket1(ioc);
+  stream_protocol::socket socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  // An empty send completes without any system call.
+  asio::error_code ec = asio::error::would_block;
+  std::size_t n = 1;
+  transfer_handler handler = { &ec, &n };
+  asio::async_sendfile(socket1, descriptor, 0, handler);
+  ASIO_CHECK(ec == asio::error::would_block);
+
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 0);
+
+  // The first sendfile() sends all of the data.
+  ec = asio::error::would_block;
+  asio::async_sendfile(socket1, descriptor, 1000, handler);
+  ASIO_CHECK(ec == asio::error::would_block);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 1000);
+  ASIO_CHECK(socket1.native_non_blocking());
+
+  // The first sendfile() fails.
+  descriptor.close();
+  ec = asio::error::would_block;
+  asio::async_sendfile(socket1, descriptor, 1000, handler);
+  ASIO_CHECK(ec == asio::error::would_block);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+  ASIO_CHECK(n == 0);
+  ASIO_CHECK(socket1.native_non_blocking());
+#endif // defined(ASIO_HAS_SENDFILE)
+}
+
+} // namespace sendfile_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "sendfile",
+  ASIO_COMPILE_TEST_CASE(sendfile_compile::test)
+  ASIO_TEST_CASE(sendfile_runtime::test_regular_file)
+  ASIO_TEST_CASE(sendfile_runtime::test_pipe)
+  ASIO_TEST_CASE(sendfile_runtime::test_copy)
+  ASIO_TEST_CASE(sendfile_runtime::test_random_access_file)
+  ASIO_TEST_CASE(sendfile_runtime::test_immediate_completion)
+)
@@ -177,6 +177,19 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // zero_copy class.
+
+    socket_base::zero_copy zero_copy1(true);
+    sock.set_option(zero_copy1);
+    socket_base::zero_copy zero_copy2;
+    sock.get_option(zero_copy2);
+    zero_copy1 = true;
+    (void)static_cast<bool>(zero_copy1);
+    (void)static_cast<bool>(!zero_copy1);
+    (void)static_cast<bool>(zero_copy1.value());
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;
@@ -0,0 +1,404 @@
+//
+// splice.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/splice.hpp"
+
+#include "archetypes/async_result.hpp"
+#include "asio/io_context.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+# include <algorithm>
+# include <vector>
+# include <unistd.h>
+# include "asio/detail/splice_pipe_pool.hpp"
+# include "asio/ip/tcp.hpp"
+# include "asio/local/connect_pair.hpp"
+# include "asio/local/stream_protocol.hpp"
+# include "asio/posix/stream_descriptor.hpp"
+#endif // defined(ASIO_HAS_SPLICE)
+
+//------------------------------------------------------------------------------
+
+// splice_compile test
+// ~~~~~~~~~~~~~~~~~~~
+// The following test checks that async_splice compiles and links correctly
+// for each supported combination of streams. Runtime failures are ignored.
+
+namespace splice_compile {
+
+#if defined(ASIO_HAS_SPLICE)
+
+void splice_handler(const asio::error_code&, std::size_t)
+{
+}
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+void test()
+{
+#if defined(ASIO_HAS_SPLICE)
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+
+    ip::tcp::socket socket1(ioc);
+    local::stream_protocol::socket socket2(ioc);
+    posix::stream_descriptor descriptor1(ioc);
+
+    async_splice(socket1, socket2, 1024, &splice_handler);
+    async_splice(socket1, descriptor1, 1024, &splice_handler);
+    async_splice(descriptor1, socket1, 1024, &splice_handler);
+    async_splice(descriptor1, descriptor1, 1024, &splice_handler);
+    int i = async_splice(socket2, socket1, 1024, lazy);
+    (void)i;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+} // namespace splice_compile
+
+//------------------------------------------------------------------------------
+
+// splice_runtime test
+// ~~~~~~~~~~~~~~~~~~~
+// The following tests check the runtime operation of async_splice.
+
+namespace splice_runtime {
+
+#if defined(ASIO_HAS_SPLICE)
+
+using asio::local::stream_protocol;
+
+const std::size_t data_size = 1024 * 1024;
+
+std::vector<char> make_data()
+{
+  std::vector<char> data(data_size);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+struct transfer_handler
+{
+  asio::error_code* ec;
+  std::size_t* n;
+
+  void operator()(const asio::error_code& e, std::size_t bytes)
+  {
+    *ec = e;
+    *n = bytes;
+  }
+};
+
+// Writes the data to the input, splices from the source to the destination,
+// and reads the result from the output. All three operations run at once.
+template <typename Input, typename Source,
+    typename Destination, typename Output>
+void transfer(asio::io_context& ioc, Input& input, Source& source,
+    Destination& destination, Output& output,
+    const std::vector<char>& data, std::size_t max_bytes,
+    std::vector<char>& received, asio::error_code& ec, std::size_t& n)
+{
+  asio::error_code write_ec;
+  std::size_t write_n = 0;
+  transfer_handler write_handler = { &write_ec, &write_n };
+  asio::async_write(input, asio::buffer(data), write_handler);
+
+  transfer_handler splice_handler = { &ec, &n };
+  asio::async_splice(source, destination, max_bytes, splice_handler);
+
+  received.assign(max_bytes, 0);
+  asio::error_code read_ec;
+  std::size_t read_n = 0;
+  transfer_handler read_handler = { &read_ec, &read_n };
+  asio::async_read(output, asio::buffer(received), read_handler);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_n == data.size());
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_n == max_bytes);
+  ASIO_CHECK(source.native_non_blocking());
+  ASIO_CHECK(destination.native_non_blocking());
+}
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+void test_socket_to_socket()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  stream_protocol::socket input(ioc), source(ioc);
+  asio::local::connect_pair(input, source);
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  std::vector<char> received;
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer(ioc, input, source, destination, output,
+      data, data_size, received, ec, n);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == data_size);
+  ASIO_CHECK(received == data);
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+void test_pipes()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  int fds1[2];
+  ASIO_CHECK(::pipe(fds1) == 0);
+  asio::posix::stream_descriptor input(ioc, fds1[1]);
+  asio::posix::stream_descriptor source(ioc, fds1[0]);
+
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  // From a pipe to a socket.
+  std::vector<char> received;
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer(ioc, input, source, destination, output,
+      data, data_size, received, ec, n);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == data_size);
+  ASIO_CHECK(received == data);
+
+  int fds2[2];
+  ASIO_CHECK(::pipe(fds2) == 0);
+  asio::posix::stream_descriptor pipe_destination(ioc, fds2[1]);
+  asio::posix::stream_descriptor pipe_output(ioc, fds2[0]);
+
+  // From a socket to a pipe.
+  transfer(ioc, output, destination, pipe_destination, pipe_output,
+      data, data_size, received, ec, n);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == data_size);
+  ASIO_CHECK(received == data);
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+void test_max_bytes()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+  std::vector<char> data = make_data();
+
+  stream_protocol::socket input(ioc), source(ioc);
+  asio::local::connect_pair(input, source);
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  data.resize(4000);
+
+  // Only the requested number of bytes is moved.
+  std::vector<char> received;
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer(ioc, input, source, destination, output,
+      data, 1000, received, ec, n);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 1000);
+  ASIO_CHECK(std::equal(received.begin(), received.end(), data.begin()));
+
+  // The rest of the data is still available from the source.
+  std::vector<char> rest(data.size() - 1000);
+  asio::read(source, asio::buffer(rest));
+  ASIO_CHECK(std::equal(rest.begin(), rest.end(), data.begin() + 1000));
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+void test_eof()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+
+  stream_protocol::socket input(ioc), source(ioc);
+  asio::local::connect_pair(input, source);
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  asio::write(input, asio::buffer("abc", 3));
+  input.shutdown(asio::socket_base::shutdown_send);
+
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer_handler splice_handler = { &ec, &n };
+  asio::async_splice(source, destination, 1000, splice_handler);
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(n == 3);
+
+  char received[3] = { 0, 0, 0 };
+  asio::read(output, asio::buffer(received));
+  ASIO_CHECK(received[0] == 'a' && received[1] == 'b' && received[2] == 'c');
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+void test_cancel()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+
+  stream_protocol::socket input(ioc), source(ioc);
+  asio::local::connect_pair(input, source);
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  asio::error_code ec;
+  std::size_t n = 0;
+  transfer_handler splice_handler = { &ec, &n };
+  asio::async_splice(source, destination, 1000, splice_handler);
+
+  ioc.poll();
+  ASIO_CHECK(!ioc.stopped());
+  source.cancel();
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(n == 0);
+  ASIO_CHECK(source.native_non_blocking());
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+void test_immediate_completion()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+
+  stream_protocol::socket input(ioc), source(ioc);
+  asio::local::connect_pair(input, source);
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  asio::write(input, asio::buffer("abc", 3));
+
+  // The data is already available, so the first splice() calls move it all.
+  asio::error_code ec = asio::error::would_block;
+  std::size_t n = 0;
+  transfer_handler splice_handler = { &ec, &n };
+  asio::async_splice(source, destination, 3, splice_handler);
+  ASIO_CHECK(ec == asio::error::would_block);
+
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 3);
+  ASIO_CHECK(source.native_non_blocking());
+  ASIO_CHECK(destination.native_non_blocking());
+
+  // The operation fails before it can start.
+  asio::posix::stream_descriptor closed(ioc);
+  ec = asio::error::would_block;
+  asio::async_splice(closed, destination, 3, splice_handler);
+  ASIO_CHECK(ec == asio::error::would_block);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+  ASIO_CHECK(n == 0);
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+void test_pipe_reuse()
+{
+#if defined(ASIO_HAS_SPLICE)
+  asio::io_context ioc;
+  asio::detail::splice_pipe_pool& pool =
+    asio::use_service<asio::detail::splice_pipe_pool>(ioc);
+
+  stream_protocol::socket input(ioc), source(ioc);
+  asio::local::connect_pair(input, source);
+  stream_protocol::socket destination(ioc), output(ioc);
+  asio::local::connect_pair(destination, output);
+
+  // Each completed operation returns its pipe, which the next one reuses.
+  for (int i = 0; i < 3; ++i)
+  {
+    asio::write(input, asio::buffer("abc", 3));
+
+    asio::error_code ec;
+    std::size_t n = 0;
+    transfer_handler splice_handler = { &ec, &n };
+    asio::async_splice(source, destination, 3, splice_handler);
+    ASIO_CHECK(pool.unused_pipes() == 0);
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 3);
+    ASIO_CHECK(pool.unused_pipes() == 1);
+
+    char received[3];
+    asio::read(output, asio::buffer(received));
+  }
+
+  // Fill the destination so that the data is left in the pipe.
+  std::vector<char> data(4096);
+  asio::error_code ec;
+  destination.non_blocking(true);
+  while (!ec)
+    destination.write_some(asio::buffer(data), ec);
+  destination.non_blocking(false);
+  asio::write(input, asio::buffer("abc", 3));
+
+  // A pipe that still holds data when the operation fails is not reused.
+  std::size_t n = 0;
+  transfer_handler splice_handler = { &ec, &n };
+  asio::async_splice(source, destination, 3, splice_handler);
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(!ioc.stopped());
+  destination.cancel();
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(n == 0);
+  ASIO_CHECK(pool.unused_pipes() == 0);
+#endif // defined(ASIO_HAS_SPLICE)
+}
+
+} // namespace splice_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "splice",
+  ASIO_COMPILE_TEST_CASE(splice_compile::test)
+  ASIO_TEST_CASE(splice_runtime::test_socket_to_socket)
+  ASIO_TEST_CASE(splice_runtime::test_pipes)
+  ASIO_TEST_CASE(splice_runtime::test_max_bytes)
+  ASIO_TEST_CASE(splice_runtime::test_eof)
+  ASIO_TEST_CASE(splice_runtime::test_cancel)
+  ASIO_TEST_CASE(splice_runtime::test_immediate_completion)
+  ASIO_TEST_CASE(splice_runtime::test_pipe_reuse)
+)
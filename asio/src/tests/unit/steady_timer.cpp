@@ -23,8 +23,149 @@
 
 #include "unit_test.hpp"
 
+#if defined(ASIO_HAS_STD_CHRONO)
+
+#include "asio/io_context.hpp"
+#include "asio/system_timer.hpp"
+
+struct wait_result
+{
+  wait_result() : called(false) {}
+
+  bool called;
+  asio::error_code ec;
+};
+
+struct record_wait
+{
+  explicit record_wait(wait_result* r) : result(r) {}
+
+  void operator()(const asio::error_code& e)
+  {
+    result->called = true;
+    result->ec = e;
+  }
+
+  wait_result* result;
+};
+
+// Run one handler, waiting for no longer than a time that is well short of
+// the expiry of the timers that are expected to remain outstanding.
+void run_briefly(asio::io_context& ioc)
+{
+  ioc.restart();
+  ioc.run_one_for(asio::chrono::seconds(2));
+}
+
+template <typename Timer>
+void timer_head_change_test()
+{
+  using asio::chrono::milliseconds;
+  using asio::chrono::seconds;
+
+  asio::io_context ioc;
+  wait_result far_result, near_result, head_result;
+
+  Timer far_timer(ioc, seconds(60));
+  far_timer.async_wait(record_wait(&far_result));
+
+  // Let the earliest deadline be calculated from the far timer alone.
+  ioc.poll();
+
+  // A new earliest timer must be noticed.
+  Timer near_timer(ioc, milliseconds(50));
+  near_timer.async_wait(record_wait(&near_result));
+  run_briefly(ioc);
+  ASIO_CHECK(near_result.called);
+  ASIO_CHECK(!near_result.ec);
+  ASIO_CHECK(!far_result.called);
+
+  // Cancelling the earliest timer must not delay the remaining timers.
+  Timer head_timer(ioc, seconds(30));
+  head_timer.async_wait(record_wait(&head_result));
+  ioc.restart();
+  ioc.poll();
+  head_timer.cancel();
+  ioc.poll();
+  ASIO_CHECK(head_result.called);
+  ASIO_CHECK(head_result.ec == asio::error::operation_aborted);
+
+  // Moving a timer to the front of the queue must be noticed.
+  far_timer.expires_after(milliseconds(50));
+  ioc.poll();
+  ASIO_CHECK(far_result.called);
+  ASIO_CHECK(far_result.ec == asio::error::operation_aborted);
+
+  far_result = wait_result();
+  far_timer.async_wait(record_wait(&far_result));
+  run_briefly(ioc);
+  ASIO_CHECK(far_result.called);
+  ASIO_CHECK(!far_result.ec);
+}
+
+void steady_timer_head_change_test()
+{
+  timer_head_change_test<asio::steady_timer>();
+}
+
+void system_timer_head_change_test()
+{
+  timer_head_change_test<asio::system_timer>();
+}
+
+void mixed_clock_head_change_test()
+{
+  using asio::chrono::milliseconds;
+  using asio::chrono::seconds;
+
+  asio::io_context ioc;
+  wait_result steady_far, system_far, steady_near, system_near;
+
+  asio::steady_timer t1(ioc, seconds(60));
+  t1.async_wait(record_wait(&steady_far));
+  asio::system_timer t2(ioc, seconds(60));
+  t2.async_wait(record_wait(&system_far));
+  ioc.poll();
+
+  // The earliest deadline across queues must follow a change in any queue.
+  asio::system_timer t3(ioc, milliseconds(50));
+  t3.async_wait(record_wait(&system_near));
+  run_briefly(ioc);
+  ASIO_CHECK(system_near.called);
+  ASIO_CHECK(!steady_far.called);
+
+  asio::steady_timer t4(ioc, milliseconds(50));
+  t4.async_wait(record_wait(&steady_near));
+  run_briefly(ioc);
+  ASIO_CHECK(steady_near.called);
+  ASIO_CHECK(!system_far.called);
+
+  // Cancelling all timers in one queue leaves the other queue's deadline.
+  t1.cancel();
+  t2.expires_after(milliseconds(50));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(steady_far.called);
+  ASIO_CHECK(steady_far.ec == asio::error::operation_aborted);
+
+  system_far = wait_result();
+  t2.async_wait(record_wait(&system_far));
+  run_briefly(ioc);
+  ASIO_CHECK(system_far.called);
+  ASIO_CHECK(!system_far.ec);
+}
+
+ASIO_TEST_SUITE
+(
+  "steady_timer",
+  ASIO_TEST_CASE(steady_timer_head_change_test)
+  ASIO_TEST_CASE(system_timer_head_change_test)
+  ASIO_TEST_CASE(mixed_clock_head_change_test)
+)
+#else // defined(ASIO_HAS_STD_CHRONO)
 ASIO_TEST_SUITE
 (
   "steady_timer",
   ASIO_TEST_CASE(null_test)
 )
+#endif // defined(ASIO_HAS_STD_CHRONO)
@@ -17,6 +17,7 @@
 #include "asio/strand.hpp"
 
 #include <sstream>
+#include <string>
 #include "asio/executor.hpp"
 #include "asio/io_context.hpp"
 #include "asio/dispatch.hpp"
@@ -458,6 +459,98 @@ void strand_execute_test()
   ASIO_CHECK(count == 1);
 }
 
+void record(std::string* order, char c)
+{
+  *order += c;
+}
+
+#if defined(ASIO_HAS_CHRONO)
+void record_slowly(std::string* order, char c)
+{
+  asio::chrono::steady_clock::time_point end =
+    asio::chrono::steady_clock::now() + asio::chrono::microseconds(200);
+  while (asio::chrono::steady_clock::now() < end)
+    ;
+  *order += c;
+}
+#endif // defined(ASIO_HAS_CHRONO)
+
+// Find the longest run of handlers from the same strand.
+std::size_t longest_run(const std::string& order)
+{
+  std::size_t longest = 0;
+  for (std::size_t i = 0, run = 0; i < order.size(); ++i)
+  {
+    run = (i > 0 && order[i] == order[i - 1]) ? run + 1 : 1;
+    if (run > longest)
+      longest = run;
+  }
+  return longest;
+}
+
+void strand_budget_test()
+{
+  io_context ioc;
+  strand<io_context::executor_type> s1 = make_strand(ioc);
+  strand<io_context::executor_type> s2 = make_strand(ioc);
+  std::string order;
+
+  // Without a budget, a strand runs all of its waiting handlers in one go.
+  for (int i = 0; i < 8; ++i)
+    post(s1, bindns::bind(record, &order, 'a'));
+  for (int i = 0; i < 8; ++i)
+    post(s2, bindns::bind(record, &order, 'b'));
+  ioc.run();
+  ASIO_CHECK(order.size() == 16);
+  ASIO_CHECK(longest_run(order) == 7);
+
+  // With a handler budget, the strands take turns on the io_context.
+  s1.set_budget(2);
+  s2.set_budget(2);
+  order.clear();
+  ioc.restart();
+  for (int i = 0; i < 8; ++i)
+    post(s1, bindns::bind(record, &order, 'a'));
+  for (int i = 0; i < 8; ++i)
+    post(s2, bindns::bind(record, &order, 'b'));
+  ioc.run();
+  ASIO_CHECK(order.size() == 16);
+  ASIO_CHECK(longest_run(order) == 2);
+  ASIO_CHECK(order.find('b') < 2);
+
+  // Copies of a strand share its budget, and the order of each strand's
+  // handlers is preserved.
+  strand<io_context::executor_type> s3(s1);
+  s3.set_budget(3);
+  order.clear();
+  ioc.restart();
+  for (int i = 0; i < 9; ++i)
+    post(s1, bindns::bind(record, &order, static_cast<char>('0' + i)));
+  for (int i = 0; i < 9; ++i)
+    post(s2, bindns::bind(record, &order, 'b'));
+  ioc.run();
+  std::string s1_order;
+  for (std::size_t i = 0; i < order.size(); ++i)
+    if (order[i] != 'b')
+      s1_order += order[i];
+  ASIO_CHECK(s1_order == "012345678");
+  ASIO_CHECK(order.substr(0, 5) == "0b123");
+
+#if defined(ASIO_HAS_CHRONO)
+  // With a time budget shorter than each handler, every handler gets a turn.
+  s1.set_budget(0, 50);
+  s2.set_budget(0, 50);
+  order.clear();
+  ioc.restart();
+  for (int i = 0; i < 4; ++i)
+    post(s1, bindns::bind(record_slowly, &order, 'a'));
+  for (int i = 0; i < 4; ++i)
+    post(s2, bindns::bind(record_slowly, &order, 'b'));
+  ioc.run();
+  ASIO_CHECK(order == "abababab");
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
 ASIO_TEST_SUITE
 (
   "strand",
@@ -465,4 +558,5 @@ ASIO_TEST_SUITE
   ASIO_COMPILE_TEST_CASE(strand_conversion_test)
   ASIO_TEST_CASE(strand_query_test)
   ASIO_TEST_CASE(strand_execute_test)
+  ASIO_TEST_CASE(strand_budget_test)
 )
@@ -29,6 +29,7 @@
 #include "asio/cancellation_signal.hpp"
 #include "asio/executor_work_guard.hpp"
 #include "asio/io_context.hpp"
+#include "asio/steady_timer.hpp"
 #include "asio/thread.hpp"
 
 #if defined(ASIO_HAS_BOOST_BIND)
@@ -468,6 +469,63 @@ void system_timer_move_test()
 #endif // defined(ASIO_HAS_MOVE)
 }
 
+// A clock that can be adjusted, as the system clock may be.
+struct adjustable_clock
+{
+  typedef asio::chrono::system_clock::duration duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef asio::chrono::time_point<adjustable_clock> time_point;
+
+  static const bool is_steady = false;
+
+  static time_point now()
+  {
+    return time_point(asio::chrono::system_clock::now().time_since_epoch()
+        + offset());
+  }
+
+  static duration& offset()
+  {
+    static duration d;
+    return d;
+  }
+};
+
+void set_true(bool* b)
+{
+  *b = true;
+}
+
+void system_timer_clock_adjustment_test()
+{
+  typedef asio::basic_waitable_timer<adjustable_clock> adjustable_timer;
+
+  asio::io_context ioc;
+  bool adjusted_called = false;
+  bool steady_called = false;
+
+  adjustable_timer t1(ioc, asio::chrono::seconds(60));
+  t1.async_wait(bindns::bind(set_true, &adjusted_called));
+
+  // Let the io_context calculate the time until the timer expires.
+  ioc.poll();
+  ASIO_CHECK(!adjusted_called);
+
+  // Move the clock past the expiry time. The timer must be found to have
+  // expired as soon as the io_context wakes for any reason.
+  adjustable_clock::offset() += asio::chrono::seconds(120);
+
+  asio::steady_timer t2(ioc, asio::chrono::milliseconds(50));
+  t2.async_wait(bindns::bind(set_true, &steady_called));
+
+  ioc.run_for(asio::chrono::seconds(2));
+  ASIO_CHECK(steady_called);
+  ASIO_CHECK(adjusted_called);
+
+  adjustable_clock::offset() = adjustable_clock::duration();
+}
+
 void system_timer_op_cancel_test()
 {
   asio::cancellation_signal cancel_signal;
@@ -515,6 +573,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(system_timer_thread_test)
   ASIO_TEST_CASE(system_timer_move_test)
   ASIO_TEST_CASE(system_timer_op_cancel_test)
+  ASIO_TEST_CASE(system_timer_clock_adjustment_test)
 )
 #else // defined(ASIO_HAS_STD_CHRONO)
 ASIO_TEST_SUITE
@@ -0,0 +1,128 @@
+//
+// tsc_timer.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/tsc_timer.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_STD_CHRONO)
+
+#include "asio/io_context.hpp"
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void tsc_clock_calibration_test()
+{
+#if defined(ASIO_HAS_TSC_CLOCK)
+  using asio::chrono::milliseconds;
+  using asio::chrono::steady_clock;
+
+  // The calibration interval starts during static initialisation, so the
+  // first use of the clock must not wait once the interval has elapsed.
+  steady_clock::time_point start =
+    asio::detail::tsc_clock::start_sample().time;
+  while (steady_clock::now() - start < milliseconds(20))
+    ;
+
+  steady_clock::time_point before = steady_clock::now();
+  asio::tsc_clock::now();
+  steady_clock::time_point after = steady_clock::now();
+  ASIO_CHECK(after - before < milliseconds(5));
+#endif // defined(ASIO_HAS_TSC_CLOCK)
+}
+
+void tsc_clock_test()
+{
+  using asio::chrono::milliseconds;
+  using asio::chrono::steady_clock;
+
+  asio::tsc_clock::is_invariant();
+
+  asio::tsc_clock::time_point t1 = asio::tsc_clock::now();
+  asio::tsc_clock::time_point t2 = asio::tsc_clock::now();
+  ASIO_CHECK(t1 <= t2);
+
+  // The clock must advance at the same rate as steady_clock.
+  steady_clock::time_point s1 = steady_clock::now();
+  t1 = asio::tsc_clock::now();
+  steady_clock::time_point s2 = s1;
+  while (s2 - s1 < milliseconds(50))
+    s2 = steady_clock::now();
+  t2 = asio::tsc_clock::now();
+
+  asio::tsc_clock::duration elapsed = t2 - t1;
+  ASIO_CHECK(elapsed >= milliseconds(45));
+  ASIO_CHECK(elapsed <= milliseconds(500));
+}
+
+void tsc_timer_test()
+{
+  using asio::chrono::milliseconds;
+
+  asio::io_context ioc;
+  int count = 0;
+
+  asio::tsc_timer::time_point start = asio::tsc_timer::clock_type::now();
+
+  asio::tsc_timer t1(ioc, milliseconds(100));
+  t1.wait();
+
+  // The timer must block until after its expiry time.
+  asio::tsc_timer::time_point end = asio::tsc_timer::clock_type::now();
+  ASIO_CHECK(start + milliseconds(100) <= end);
+
+  start = asio::tsc_timer::clock_type::now();
+
+  asio::tsc_timer t2(ioc, milliseconds(100));
+  t2.async_wait(
+      [&count](const asio::error_code&)
+      {
+        increment(&count);
+      });
+
+  // No completions can be delivered until run() is called.
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all operations have finished.
+  ASIO_CHECK(count == 1);
+  end = asio::tsc_timer::clock_type::now();
+  ASIO_CHECK(start + milliseconds(100) <= end);
+}
+
+ASIO_TEST_SUITE
+(
+  "tsc_timer",
+  ASIO_TEST_CASE(tsc_clock_calibration_test)
+  ASIO_TEST_CASE(tsc_clock_test)
+  ASIO_TEST_CASE(tsc_timer_test)
+)
+#else // defined(ASIO_HAS_STD_CHRONO)
+ASIO_TEST_SUITE
+(
+  "tsc_timer",
+  ASIO_TEST_CASE(null_test)
+)
+#endif // defined(ASIO_HAS_STD_CHRONO)
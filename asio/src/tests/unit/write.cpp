@@ -17,6 +17,8 @@
 #include "asio/write.hpp"
 
 #include <cstring>
+#include <list>
+#include <string>
 #include <vector>
 #include "archetypes/async_result.hpp"
 #include "asio/io_context.hpp"
@@ -231,6 +233,118 @@ void test_2_arg_vector_buffers_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_2_arg_long_vector_buffers_write()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  std::vector<asio::const_buffer> buffers;
+  for (int i = 0; i < 100; ++i)
+    buffers.push_back(asio::buffer(write_data, 40) + (i % 10));
+
+  s.reset();
+  size_t bytes_transferred = asio::write(s, buffers);
+  ASIO_CHECK(bytes_transferred == 3550);
+  ASIO_CHECK(s.check_buffers(buffers, 3550));
+
+  s.reset();
+  s.next_write_length(1);
+  bytes_transferred = asio::write(s, buffers);
+  ASIO_CHECK(bytes_transferred == 3550);
+  ASIO_CHECK(s.check_buffers(buffers, 3550));
+
+  s.reset();
+  s.next_write_length(100);
+  bytes_transferred = asio::write(s, buffers);
+  ASIO_CHECK(bytes_transferred == 3550);
+  ASIO_CHECK(s.check_buffers(buffers, 3550));
+}
+
+template <typename Buffers>
+void check_very_long_buffers_write(const Buffers& buffers, size_t length)
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  // Partial writes of more than half of the prepared buffers move the
+  // remaining buffers to the start of the block before it is topped up.
+  static const size_t write_lengths[] = { 1, 7, 777, 1500, 3000, 8192 };
+  for (size_t i = 0; i < sizeof(write_lengths) / sizeof(size_t); ++i)
+  {
+    s.reset();
+    s.next_write_length(write_lengths[i]);
+    size_t bytes_transferred = asio::write(s, buffers);
+    ASIO_CHECK(bytes_transferred == length);
+    ASIO_CHECK(s.check_buffers(buffers, length));
+  }
+}
+
+void test_2_arg_very_long_buffers_write()
+{
+  // More buffers than may be passed to a single write_some.
+  std::vector<asio::const_buffer> vector_buffers;
+  std::list<asio::const_buffer> list_buffers;
+  size_t length = 0;
+  for (int i = 0; i < 2500; ++i)
+  {
+    asio::const_buffer b = asio::buffer(write_data + (i % 10), i % 3 + 1);
+    vector_buffers.push_back(b);
+    list_buffers.push_back(b);
+    length += b.size();
+  }
+
+  check_very_long_buffers_write(vector_buffers, length);
+  check_very_long_buffers_write(list_buffers, length);
+}
+
+template <typename Buffers>
+void check_consume_beyond_window(const Buffers& buffers)
+{
+  typedef asio::detail::consuming_buffers<asio::const_buffer,
+    Buffers, typename Buffers::const_iterator> consuming_buffers_type;
+  typedef typename consuming_buffers_type::prepared_buffers_type
+    prepared_buffers_type;
+
+  std::string expected;
+  typename Buffers::const_iterator iter = buffers.begin();
+  for (; iter != buffers.end(); ++iter)
+    expected.append(static_cast<const char*>(iter->data()), iter->size());
+
+  // Consume more than was prepared, sometimes ending part way through a
+  // buffer, and check that the next sequence starts at the consumed position.
+  consuming_buffers_type cb(buffers);
+  size_t position = 0;
+  for (size_t n = 1; !cb.empty(); n = n * 3 + 1)
+  {
+    prepared_buffers_type prepared = cb.prepare(n * 2);
+    std::string actual(prepared.total_size(), '\0');
+    asio::buffer_copy(asio::buffer(&actual[0], actual.size()), prepared);
+    ASIO_CHECK(actual == expected.substr(position, actual.size()));
+
+    size_t consumed = n * 5 < expected.size() - position
+      ? n * 5 : expected.size() - position;
+    cb.consume(consumed);
+    position += consumed;
+    ASIO_CHECK(cb.total_consumed() == position);
+  }
+
+  ASIO_CHECK(position == expected.size());
+}
+
+void test_consume_beyond_window()
+{
+  std::vector<asio::const_buffer> vector_buffers;
+  std::list<asio::const_buffer> list_buffers;
+  for (int i = 0; i < 2500; ++i)
+  {
+    asio::const_buffer b = asio::buffer(write_data + (i % 10), i % 3 + 1);
+    vector_buffers.push_back(b);
+    list_buffers.push_back(b);
+  }
+
+  check_consume_beyond_window(vector_buffers);
+  check_consume_beyond_window(list_buffers);
+}
+
 void test_2_arg_dynamic_string_write()
 {
   asio::io_context ioc;
@@ -2454,6 +2568,55 @@ void test_3_arg_vector_buffers_async_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_3_arg_long_list_buffers_async_write()
+{
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  std::list<asio::const_buffer> buffers;
+  for (int i = 0; i < 100; ++i)
+    buffers.push_back(asio::buffer(write_data, 40) + (i % 10));
+
+  s.reset();
+  bool called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 3550, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 3550));
+
+  s.reset();
+  s.next_write_length(1);
+  called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 3550, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 3550));
+
+  s.reset();
+  s.next_write_length(100);
+  called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 3550, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 3550));
+}
+
 void test_3_arg_dynamic_string_async_write()
 {
 #if defined(ASIO_HAS_BOOST_BIND)
@@ -4873,6 +5036,9 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_2_arg_const_buffer_write)
   ASIO_TEST_CASE(test_2_arg_mutable_buffer_write)
   ASIO_TEST_CASE(test_2_arg_vector_buffers_write)
+  ASIO_TEST_CASE(test_2_arg_long_vector_buffers_write)
+  ASIO_TEST_CASE(test_2_arg_very_long_buffers_write)
+  ASIO_TEST_CASE(test_consume_beyond_window)
   ASIO_TEST_CASE(test_2_arg_dynamic_string_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_zero_buffers_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_const_buffer_write)
@@ -4892,6 +5058,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_3_arg_boost_array_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_std_array_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_vector_buffers_async_write)
+  ASIO_TEST_CASE(test_3_arg_long_list_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_dynamic_string_async_write)
   ASIO_TEST_CASE(test_3_arg_streambuf_async_write)
   ASIO_TEST_CASE(test_4_arg_const_buffer_async_write)
@@ -0,0 +1,426 @@
+//
+// write_queue.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/write_queue.hpp"
+
+#include <cstring>
+#include <string>
+#include "archetypes/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "asio/thread.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// write_queue_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// write_queue compile and link correctly. Runtime failures are ignored.
+
+namespace write_queue_compile {
+
+void push_handler(const asio::error_code&)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    archetypes::lazy_handler lazy;
+
+    ip::tcp::socket socket1(ioc);
+    write_queue<ip::tcp::socket&> queue1(socket1);
+    write_queue<ip::tcp::socket> queue2(ioc, 4096, 16);
+
+    ip::tcp::socket& next_layer = queue1.next_layer();
+    (void)next_layer;
+
+    ip::tcp::socket::executor_type ex = queue2.get_executor();
+    (void)ex;
+
+    std::size_t n = queue1.queued_bytes();
+    n = queue1.queued_messages();
+    (void)n;
+
+    bool b = queue1.try_push(buffer(mutable_char_buffer));
+    b = queue1.try_push(buffer(const_char_buffer));
+    (void)b;
+
+    queue1.async_push(buffer(mutable_char_buffer), &push_handler);
+    queue1.async_push(buffer(const_char_buffer), &push_handler);
+    int i = queue1.async_push(buffer(const_char_buffer), lazy);
+    (void)i;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace write_queue_compile
+
+//------------------------------------------------------------------------------
+
+// write_queue_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the write_queue class
+// against a stream that records the data written to it.
+
+namespace write_queue_runtime {
+
+class test_stream
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+
+  explicit test_stream(asio::io_context& ioc)
+    : ioc_(ioc),
+      write_some_calls_(0),
+      max_write_length_(1000000),
+      fail_(false)
+  {
+  }
+
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return ioc_.get_executor();
+  }
+
+  template <typename ConstBufferSequence, typename Handler>
+  void async_write_some(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(Handler) handler)
+  {
+    ++write_some_calls_;
+    asio::error_code ec;
+    std::size_t n = 0;
+    if (fail_)
+      ec = asio::error::connection_reset;
+    else
+    {
+      n = asio::buffer_size(buffers);
+      if (n > max_write_length_)
+        n = max_write_length_;
+      std::size_t offset = data_.size();
+      data_.resize(offset + n);
+      asio::buffer_copy(asio::buffer(&data_[0] + offset, n), buffers);
+    }
+    asio::post(ioc_, asio::detail::bind_handler(
+          ASIO_MOVE_CAST(Handler)(handler), ec, n));
+  }
+
+  asio::io_context& ioc_;
+  std::string data_;
+  std::size_t write_some_calls_;
+  std::size_t max_write_length_;
+  bool fail_;
+};
+
+typedef asio::write_queue<test_stream> queue_type;
+
+struct push_handler
+{
+  int* count;
+  asio::error_code* ec;
+
+  void operator()(const asio::error_code& e)
+  {
+    ++*count;
+    *ec = e;
+  }
+};
+
+void test_coalescing()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc);
+
+  std::string expected;
+  for (int i = 0; i < 100; ++i)
+  {
+    std::string message(10 + i % 7, static_cast<char>('a' + i % 26));
+    ASIO_CHECK(queue.try_push(asio::buffer(message)));
+    expected += message;
+  }
+
+  ASIO_CHECK(queue.queued_messages() == 100);
+  ASIO_CHECK(queue.queued_bytes() == expected.size());
+
+  ioc.run();
+
+  // All messages pushed before the queue was serviced go in one write.
+  ASIO_CHECK(queue.next_layer().data_ == expected);
+  ASIO_CHECK(queue.next_layer().write_some_calls_ == 1);
+  ASIO_CHECK(queue.queued_messages() == 0);
+  ASIO_CHECK(queue.queued_bytes() == 0);
+}
+
+void test_partial_writes()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc);
+  queue.next_layer().max_write_length_ = 7;
+
+  std::string expected;
+  for (int i = 0; i < 50; ++i)
+  {
+    std::string message(1 + i % 13, static_cast<char>('A' + i % 26));
+    ASIO_CHECK(queue.try_push(asio::buffer(message)));
+    expected += message;
+
+    // Interleave running the queue with pushing, so that messages are added
+    // while a write is in progress.
+    ioc.poll_one();
+  }
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(queue.next_layer().data_ == expected);
+  ASIO_CHECK(queue.queued_bytes() == 0);
+}
+
+struct written_handler
+{
+  queue_type* queue;
+  std::string* written;
+
+  void operator()(const asio::error_code&)
+  {
+    *written = queue->next_layer().data_;
+  }
+};
+
+void test_async_push_without_copy()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc);
+
+  std::string written1, written2;
+  written_handler h1 = { &queue, &written1 };
+  written_handler h2 = { &queue, &written2 };
+
+  // The messages are not copied, so changes made before they are written are
+  // seen by the stream.
+  char message1[] = "abc";
+  std::string message2 = "defgh";
+  queue.async_push(asio::buffer(message1, 3), h1);
+  queue.async_push(asio::buffer(message2), h2);
+  message1[0] = 'A';
+
+  ioc.run();
+
+  // Both messages are written by one gather write, and each push completes
+  // once its message has been written.
+  ASIO_CHECK(queue.next_layer().data_ == "Abcdefgh");
+  ASIO_CHECK(queue.next_layer().write_some_calls_ == 1);
+  ASIO_CHECK(written1 == "Abcdefgh");
+  ASIO_CHECK(written2 == "Abcdefgh");
+}
+
+void test_backpressure()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc, 64, 4);
+
+  int count = 0;
+  asio::error_code ec = asio::error::would_block;
+  push_handler h = { &count, &ec };
+
+  queue.async_push(asio::buffer("abc", 3), h);
+  queue.async_push(asio::buffer("def", 3), h);
+  queue.async_push(asio::buffer("ghi", 3), h);
+  ASIO_CHECK(queue.try_push(asio::buffer("jkl", 3)));
+
+  // The queue now holds its maximum number of messages. A message pushed
+  // asynchronously is held back until there is room for it.
+  ASIO_CHECK(!queue.try_push(asio::buffer("mno", 3)));
+  queue.async_push(asio::buffer("pqr", 3), h);
+  ASIO_CHECK(queue.queued_messages() == 4);
+  ASIO_CHECK(queue.queued_bytes() == 12);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 4);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(queue.next_layer().data_ == "abcdefghijklpqr");
+
+  // A message larger than the byte limit is accepted, but the push does not
+  // complete until it has been written.
+  count = 0;
+  std::string large(100, 'x');
+  queue.async_push(asio::buffer(large), h);
+  ASIO_CHECK(queue.queued_bytes() == 100);
+  ASIO_CHECK(!queue.try_push(asio::buffer("y", 1)));
+
+  ioc.restart();
+  ioc.run_one();
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(queue.queued_bytes() == 0);
+}
+
+void test_unlimited()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc, 0, 0);
+
+  // A limit of 0 means that the queue is never full.
+  std::string expected;
+  for (int i = 0; i < 100; ++i)
+  {
+    std::string message(1000, static_cast<char>('a' + i % 26));
+    ASIO_CHECK(queue.try_push(asio::buffer(message)));
+    expected += message;
+  }
+
+  ASIO_CHECK(queue.queued_messages() == 100);
+  ASIO_CHECK(queue.queued_bytes() == 100000);
+
+  ioc.run();
+
+  ASIO_CHECK(queue.next_layer().data_ == expected);
+  ASIO_CHECK(queue.queued_bytes() == 0);
+}
+
+void test_write_error()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc, 64, 2);
+  queue.next_layer().fail_ = true;
+
+  int count = 0;
+  asio::error_code ec;
+  push_handler h = { &count, &ec };
+
+  ASIO_CHECK(queue.try_push(asio::buffer("abc", 3)));
+  queue.async_push(asio::buffer("def", 3), h);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ec == asio::error::connection_reset);
+  ASIO_CHECK(queue.queued_bytes() == 0);
+
+  // Once a write has failed, all further pushes fail.
+  ASIO_CHECK(!queue.try_push(asio::buffer("ghi", 3)));
+
+  count = 0;
+  ec = asio::error_code();
+  queue.async_push(asio::buffer("jkl", 3), h);
+  ASIO_CHECK(count == 0);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ec == asio::error::connection_reset);
+  ASIO_CHECK(queue.next_layer().write_some_calls_ == 1);
+}
+
+struct runner
+{
+  asio::io_context* ioc;
+
+  void operator()()
+  {
+    ioc->run();
+  }
+};
+
+struct producer
+{
+  queue_type* queue;
+  char id;
+
+  void operator()()
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      char message[2] = { id, static_cast<char>('0' + i % 10) };
+      while (!queue->try_push(asio::buffer(message)))
+      {
+      }
+    }
+  }
+};
+
+void test_multiple_threads()
+{
+  asio::io_context ioc;
+  queue_type queue(ioc, 256, 64);
+
+  asio::executor_work_guard<asio::io_context::executor_type>
+    work = asio::make_work_guard(ioc);
+  runner r = { &ioc };
+  asio::thread io_thread(r);
+
+  producer p1 = { &queue, 'a' };
+  producer p2 = { &queue, 'b' };
+  producer p3 = { &queue, 'c' };
+  asio::thread t1(p1);
+  asio::thread t2(p2);
+  asio::thread t3(p3);
+  t1.join();
+  t2.join();
+  t3.join();
+
+  // The io_context runs until the last write has completed.
+  work.reset();
+  io_thread.join();
+
+  // Each producer's messages are written whole and in order.
+  const std::string& data = queue.next_layer().data_;
+  ASIO_CHECK(data.size() == 6000);
+  int next[3] = { 0, 0, 0 };
+  bool in_order = true;
+  for (std::size_t i = 0; i + 1 < data.size(); i += 2)
+  {
+    int& n = next[data[i] - 'a'];
+    in_order = in_order && data[i + 1] == '0' + n % 10;
+    ++n;
+  }
+  ASIO_CHECK(in_order);
+  ASIO_CHECK(next[0] == 1000 && next[1] == 1000 && next[2] == 1000);
+}
+
+} // namespace write_queue_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "write_queue",
+  ASIO_COMPILE_TEST_CASE(write_queue_compile::test)
+  ASIO_TEST_CASE(write_queue_runtime::test_coalescing)
+  ASIO_TEST_CASE(write_queue_runtime::test_partial_writes)
+  ASIO_TEST_CASE(write_queue_runtime::test_async_push_without_copy)
+  ASIO_TEST_CASE(write_queue_runtime::test_backpressure)
+  ASIO_TEST_CASE(write_queue_runtime::test_unlimited)
+  ASIO_TEST_CASE(write_queue_runtime::test_write_error)
+  ASIO_TEST_CASE(write_queue_runtime::test_multiple_threads)
+)